@@ -41,9 +41,9 @@ void StateTest::OnCreate()
 	int h = sizeof(Renderable);
 
 	m_entity_admin->Reserve(m_entities.capacity(), ObjectType{});
-	for (int i = 0; i < m_entities.capacity(); ++i)
+	for (const EntityID entity_id : m_entity_admin->Duplicate(e1, m_entities.capacity()))
 	{
-		Entity& added = m_entities.emplace_back(e1.Duplicate());
+		Entity& added = m_entities.emplace_back(*m_entity_admin, entity_id);
 
 		//added.AddComponent<Velocity>();
 		//added.SetComponent<Velocity>(
@@ -0,0 +1,62 @@
+#include "Test.hpp"
+#include "PhysicsScene.h"
+
+#include <cmath>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+using namespace vlx;
+
+namespace
+{
+	constexpr int BODY_COUNTS[] = { 1000, 10000, 100000 };
+
+	void BenchmarkBackend(BroadSystem::Backend backend, const char* name, int body_count)
+	{
+		constexpr float AREA_PER_BODY = 640.0f; // keeps the density the same for every count, the largest count fills the bounds of the quadtree
+
+		const int step_count	= std::max(10, 100000 / body_count);
+		const float extent		= 0.5f * std::sqrt(AREA_PER_BODY * body_count);
+
+		test::PhysicsScene scene;
+		scene.GetPhysics().SetGravity({});
+		scene.GetPhysics().SetBroadPhase(backend);
+
+		std::mt19937 rng(42);
+		std::uniform_real_distribution<float> position(-extent, extent);
+		std::uniform_real_distribution<float> velocity(-30.0f, 30.0f);
+		std::uniform_real_distribution<float> radius(1.0f, 6.0f);
+
+		for (int i = 0; i < body_count; ++i)
+		{
+			const EntityID entity_id = scene.AddCircle({ position(rng), position(rng) }, radius(rng));
+			scene.GetEntityAdmin().GetComponent<PhysicsBody>(entity_id).SetVelocity({ velocity(rng), velocity(rng) });
+		}
+
+		scene.Step(); // the first step inserts every body
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (int step = 0; step < step_count; ++step)
+			scene.Step();
+
+		const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+		std::printf("  %-14s %8.3f ms per step, %zu pairs\n", name, elapsed.count() / step_count, 
+			scene.GetPhysics().GetBroadSystem().GetCollisions().size());
+	}
+}
+
+VELOX_BENCHMARK(BroadPhaseBackends)
+{
+	for (const int body_count : BODY_COUNTS)
+	{
+		std::printf(" %d bodies\n", body_count);
+
+		BenchmarkBackend(BroadSystem::Backend::QuadTree,		"QuadTree",			body_count);
+		BenchmarkBackend(BroadSystem::Backend::AABBTree,		"AABBTree",			body_count);
+		BenchmarkBackend(BroadSystem::Backend::SweepAndPrune,	"SweepAndPrune",	body_count);
+		BenchmarkBackend(BroadSystem::Backend::Grid,			"Grid",				body_count);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include "Test.hpp"
+#include "PhysicsScene.h"
+
+#include <set>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <utility>
+
+using namespace vlx;
+
+namespace
+{
+	using Backend = BroadSystem::Backend;
+	using PairSet = std::set<std::pair<EntityID, EntityID>>;
+
+	constexpr Backend BACKENDS[] = { Backend::QuadTree, Backend::AABBTree, Backend::SweepAndPrune, Backend::Grid };
+
+	void AddCircles(test::PhysicsScene& scene, int count, uint32 seed)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+		std::uniform_real_distribution<float> radius(2.0f, 20.0f);
+
+		for (int i = 0; i < count; ++i) // every fifth body is static so that pairs between inactive bodies are skipped as well
+			scene.AddCircle({ position(rng), position(rng) }, radius(rng), (i % 5 == 0) ? BodyType::Static : BodyType::Dynamic);
+	}
+
+	PairSet GetPairs(const BroadSystem& broad)
+	{
+		PairSet pairs;
+		for (const auto& [i, j] : broad.GetCollisions())
+			pairs.emplace(std::minmax(broad.GetBody(i).entity_id, broad.GetBody(j).entity_id));
+
+		return pairs;
+	}
+
+	PairSet GetExpectedPairs(test::PhysicsScene& scene) // every overlapping pair where at least one body is active
+	{
+		EntityAdmin& entity_admin = scene.GetEntityAdmin();
+
+		PairSet pairs;
+		for (const Entity& lhs : scene.GetEntities())
+		{
+			for (const Entity& rhs : scene.GetEntities())
+			{
+				if (lhs.GetID() >= rhs.GetID())
+					continue;
+
+				const PhysicsBody& lhs_body = entity_admin.GetComponent<PhysicsBody>(lhs);
+				const PhysicsBody& rhs_body = entity_admin.GetComponent<PhysicsBody>(rhs);
+
+				if (!lhs_body.IsAwake() && !rhs_body.IsAwake())
+					continue;
+
+				const RectFloat& lhs_aabb = entity_admin.GetComponent<ColliderAABB>(lhs).GetAABB();
+				const RectFloat& rhs_aabb = entity_admin.GetComponent<ColliderAABB>(rhs).GetAABB();
+
+				if (lhs_aabb.Overlaps(rhs_aabb))
+					pairs.emplace(lhs.GetID(), rhs.GetID());
+			}
+		}
+
+		return pairs;
+	}
+}
+
+VELOX_TEST(BroadPhaseBackendsFindSamePairs)
+{
+	PairSet expected;
+
+	for (const Backend backend : BACKENDS)
+	{
+		test::PhysicsScene scene;
+		scene.GetPhysics().SetGravity({});
+		scene.GetPhysics().SetBroadPhase(backend);
+
+		AddCircles(scene, 500, 42);
+		scene.Step();
+
+		const PairSet pairs = GetPairs(scene.GetPhysics().GetBroadSystem());
+
+		if (backend == Backend::QuadTree)
+			expected = pairs;
+
+		VELOX_CHECK(!pairs.empty());
+		VELOX_CHECK(pairs == expected);
+	}
+}
+
+VELOX_TEST(BroadPhaseMatchesBruteForce)
+{
+	test::PhysicsScene scene;
+	scene.GetPhysics().SetGravity({});
+
+	AddCircles(scene, 300, 7);
+
+	for (int step = 0; step < 12; ++step) // switch between the backends while the bodies are pushed apart
+	{
+		scene.GetPhysics().SetBroadPhase(BACKENDS[step % std::size(BACKENDS)]);
+
+		if (step == 6) // pairs of removed bodies have to disappear from every backend
+		{
+			for (int i = 0; i < 50; ++i)
+				scene.Remove(scene.GetEntities()[i * 3].GetID());
+		}
+
+		scene.Step();
+
+		VELOX_CHECK(GetPairs(scene.GetPhysics().GetBroadSystem()) == GetExpectedPairs(scene));
+	}
+}
+
+VELOX_TEST(BroadPhaseBackendsFindSameQueries)
+{
+	std::vector<std::vector<EntityID>> expected_overlaps;
+	std::vector<EntityID> expected_hits;
+
+	for (const Backend backend : BACKENDS)
+	{
+		test::PhysicsScene scene;
+		scene.GetPhysics().SetGravity({});
+		scene.GetPhysics().SetBroadPhase(backend);
+
+		AddCircles(scene, 300, 11);
+		scene.AddBox({ 0.0f, 450.0f }, { 900.0f, 20.0f }, BodyType::Static); // wide bodies widen every search along x
+		scene.Step();
+
+		AddCircles(scene, 20, 13); // added and removed since the last step
+		scene.Remove(scene.GetEntities()[5].GetID());
+
+		std::vector<std::vector<EntityID>> overlaps;
+		std::vector<EntityID> hits;
+
+		std::mt19937 rng(3);
+		std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+
+		for (int i = 0; i < 50; ++i)
+		{
+			const Vector2f center(position(rng), position(rng));
+
+			std::vector<EntityID> overlap = scene.GetPhysics().Overlap(center, 40.0f);
+			std::ranges::sort(overlap);
+
+			overlaps.push_back(std::move(overlap));
+
+			const auto hit = scene.GetPhysics().RayCast(Ray{ center, Vector2f(position(rng), position(rng)) - center });
+			hits.push_back(hit.has_value() ? hit->entity : NULL_ENTITY);
+		}
+
+		if (backend == Backend::QuadTree)
+		{
+			expected_overlaps	= overlaps;
+			expected_hits		= hits;
+		}
+
+		VELOX_CHECK(overlaps == expected_overlaps);
+		VELOX_CHECK(hits == expected_hits);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#include "Test.hpp"
+
+#include <vector>
+
+#include <Velox/ECS.hpp>
+#include <Velox/ECS/CommandBuffer.h>
+
+using namespace vlx;
+
+namespace
+{
+	struct Health
+	{
+		int value {100};
+	};
+
+	struct Armor
+	{
+		int value {10};
+	};
+}
+
+VELOX_TEST(CommandBufferKeepsOrderOfEntity)
+{
+	EntityAdmin entity_admin;
+	entity_admin.RegisterComponents<Health, Armor>();
+
+	CommandBuffer commands(entity_admin.GetThreadPool().GetThreadCount());
+
+	Entity removed_then_added(entity_admin);
+	removed_then_added.AddComponent<Health>();
+
+	Entity missing_then_added(entity_admin); // removing does nothing, the add afterwards has to stay
+	missing_then_added.AddComponent<Armor>();
+
+	Entity added_then_removed(entity_admin);
+
+	commands.RemoveComponent<Health>(removed_then_added.GetID());
+	commands.AddComponent<Health>(removed_then_added.GetID());
+
+	commands.RemoveComponent<Health>(missing_then_added.GetID());
+	commands.AddComponent<Health>(missing_then_added.GetID());
+
+	commands.AddComponent<Health>(added_then_removed.GetID());
+	commands.AddComponent<Armor>(added_then_removed.GetID());
+	commands.RemoveComponent<Health>(added_then_removed.GetID());
+
+	commands.Execute(entity_admin);
+
+	VELOX_CHECK(commands.IsEmpty());
+	VELOX_CHECK(entity_admin.HasComponent<Health>(removed_then_added.GetID()));
+	VELOX_CHECK(entity_admin.HasComponent<Health>(missing_then_added.GetID()));
+	VELOX_CHECK(!entity_admin.HasComponent<Health>(added_then_removed.GetID()));
+	VELOX_CHECK(entity_admin.HasComponent<Armor>(added_then_removed.GetID()));
+}
+
+VELOX_TEST(CommandBufferPlaysBackCommandsRecordedByListeners)
+{
+	EntityAdmin entity_admin;
+	entity_admin.RegisterComponents<Health, Armor>();
+
+	CommandBuffer commands(entity_admin.GetThreadPool().GetThreadCount());
+
+	const EventID on_add = entity_admin.RegisterOnAddListener<Health>(
+		[&commands](EntityID entity_id, Health&)
+		{
+			commands.AddComponent<Armor>(entity_id); // recorded while the buffer is being played back
+		});
+
+	std::vector<Entity> entities;
+	for (int i = 0; i < 8; ++i)
+		commands.AddComponent<Health>(entities.emplace_back(entity_admin).GetID());
+
+	commands.Execute(entity_admin);
+
+	VELOX_CHECK(commands.IsEmpty());
+
+	for (const Entity& entity : entities)
+	{
+		VELOX_CHECK(entity_admin.HasComponent<Health>(entity.GetID()));
+		VELOX_CHECK(entity_admin.HasComponent<Armor>(entity.GetID()));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "Test.hpp"
+#include "PhysicsScene.h"
+
+#include <random>
+
+using namespace vlx;
+
+namespace
+{
+	///	Drops circles onto a static floor, removes some of them along the way and adds new ones, the same for every
+	/// run given the same seed.
+	///
+	class Scenario
+	{
+	public:
+		explicit Scenario(uint32 seed, float offset = 0.0f) : m_rng(seed)
+		{
+			m_scene.GetPhysics().SetDeterministic(true);
+
+			for (int i = 0; i < 20; ++i)
+				m_scene.AddCircle({ i * 40.0f, 400.0f }, 20.0f, BodyType::Static);
+
+			AddCircles(100, offset);
+		}
+
+		void Step(int step)
+		{
+			if (step == 40)
+			{
+				for (int i = 0; i < 10; ++i)
+					m_scene.Remove(m_scene.GetEntities()[20 + i * 4].GetID());
+			}
+
+			if (step == 80)
+				AddCircles(30);
+
+			m_scene.Step();
+		}
+
+		NODISC uint64 GetHash() { return m_scene.GetPhysics().GetStateHash(); }
+
+	private:
+		void AddCircles(int count, float offset = 0.0f)
+		{
+			std::uniform_real_distribution<float> x(0.0f, 760.0f);
+			std::uniform_real_distribution<float> y(-200.0f, 300.0f);
+			std::uniform_real_distribution<float> radius(4.0f, 12.0f);
+
+			for (int i = 0; i < count; ++i)
+				m_scene.AddCircle({ x(m_rng) + ((i == 0) ? offset : 0.0f), y(m_rng) }, radius(m_rng));
+		}
+
+	private:
+		test::PhysicsScene	m_scene;
+		std::mt19937		m_rng;
+	};
+}
+
+VELOX_TEST(DeterministicRunsHashEqual)
+{
+	Scenario first(1234);
+	Scenario second(1234);
+
+	bool equal = true;
+	for (int step = 0; step < 120; ++step)
+	{
+		first.Step(step);
+		second.Step(step);
+
+		equal = equal && (first.GetHash() == second.GetHash());
+	}
+
+	VELOX_CHECK(first.GetHash() != 0);
+	VELOX_CHECK(equal);
+}
+
+VELOX_TEST(DeterministicHashDetectsDivergence)
+{
+	Scenario first(1234);
+	Scenario second(1234, 0.001f); // a single body placed slightly off
+
+	bool equal = true;
+	for (int step = 0; step < 120; ++step)
+	{
+		first.Step(step);
+		second.Step(step);
+
+		equal = equal && (first.GetHash() == second.GetHash());
+	}
+
+	VELOX_CHECK(!equal);
+}
\ No newline at end of file
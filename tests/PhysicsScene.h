@@ -0,0 +1,110 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include <Velox/ECS.hpp>
+#include <Velox/Physics.hpp>
+#include <Velox/Graphics/Components/Transform.h>
+#include <Velox/Graphics/Systems/LocalTransformSystem.h>
+#include <Velox/World/ObjectTypes.h>
+#include <Velox/System/Time.h>
+
+namespace vlx::test
+{
+	///	Entity admin with only the physics systems, stepped at the fixed time step without any window.
+	///
+	class PhysicsScene
+	{
+	public:
+		PhysicsScene()
+		{
+			m_entity_admin.RegisterComponents(PhysicsType{});
+			m_entity_admin.RegisterComponents<Transform, TransformMatrix, Circle, Box, Point, Polygon, 
+				ColliderEnter, ColliderExit, ColliderOverlap>();
+
+			m_local		= std::make_unique<LocalTransformSystem>(m_entity_admin, LYR_LOCAL_TRANSFORM);
+			m_dirty		= std::make_unique<PhysicsDirtySystem>(m_entity_admin, LYR_DIRTY_PHYSICS);
+			m_physics	= std::make_unique<PhysicsSystem>(m_entity_admin, LYR_PHYSICS, m_time);
+		}
+
+	public:
+		EntityID AddCircle(const Vector2f& position, float radius, BodyType type = BodyType::Dynamic)
+		{
+			Entity& entity = m_entities.emplace_back(m_entity_admin);
+
+			entity.AddComponents(PhysicsType{});
+			entity.AddComponent<Transform>(position);
+			entity.AddComponent<Circle>(radius);
+
+			PhysicsBody& body = entity.GetComponent<PhysicsBody>();
+			body.SetType(type);
+
+			if (type == BodyType::Dynamic)
+			{
+				body.SetMass(radius * radius * 0.01f);
+				body.SetInertia(radius * radius * radius * 0.01f);
+			}
+
+			return entity;
+		}
+
+		EntityID AddBox(const Vector2f& position, const Vector2f& size, BodyType type = BodyType::Dynamic)
+		{
+			Entity& entity = m_entities.emplace_back(m_entity_admin);
+
+			entity.AddComponents(PhysicsType{});
+			entity.AddComponent<Transform>(position);
+			entity.AddComponent<TransformMatrix>();
+			entity.AddComponent<Box>(size);
+
+			PhysicsBody& body = entity.GetComponent<PhysicsBody>();
+			body.SetType(type);
+
+			if (type == BodyType::Dynamic)
+			{
+				const float mass = size.x * size.y * 0.01f;
+
+				body.SetMass(mass);
+				body.SetInertia(mass * (size.x * size.x + size.y * size.y) / 12.0f);
+			}
+
+			return entity;
+		}
+
+		void Remove(EntityID entity_id)
+		{
+			const auto it = std::ranges::find_if(m_entities, [entity_id](const Entity& entity) { return entity.GetID() == entity_id; });
+
+			if (it == m_entities.end())
+				return;
+
+			it->Destroy(); // move assigning over an entity does not remove it, so destroy it before erasing
+			m_entities.erase(it);
+		}
+
+		void Step()
+		{
+			m_local->Update(); // matrices of moved boxes
+			m_dirty->FixedUpdate(); // bounds of moved colliders
+			m_physics->FixedUpdate();
+		}
+
+	public:
+		EntityAdmin& GetEntityAdmin() noexcept	{ return m_entity_admin; }
+		PhysicsSystem& GetPhysics() noexcept	{ return *m_physics; }
+
+		std::vector<Entity>& GetEntities() noexcept { return m_entities; }
+
+	private:
+		EntityAdmin								m_entity_admin;
+		Time									m_time;
+
+		std::unique_ptr<LocalTransformSystem>	m_local;		// constructed after the components are registered
+		std::unique_ptr<PhysicsDirtySystem>		m_dirty;
+		std::unique_ptr<PhysicsSystem>			m_physics;
+
+		std::vector<Entity>						m_entities;
+	};
+}
\ No newline at end of file
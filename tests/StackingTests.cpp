@@ -0,0 +1,50 @@
+#include "Test.hpp"
+#include "PhysicsScene.h"
+
+#include <cmath>
+
+using namespace vlx;
+
+namespace
+{
+	constexpr int	STACK_HEIGHT	= 10;
+	constexpr float	BOX_SIZE		= 30.0f;
+	constexpr float	FLOOR_TOP		= 400.0f;
+
+	///	Stacks boxes on a static floor and lets them rest for ten seconds with the default solver settings. The top 
+	/// box should remain where it was placed, give or take what the stack settles and sways.
+	///
+	void CheckStack(PhysicsSystem::SolverType solver_type)
+	{
+		test::PhysicsScene scene;
+		scene.GetPhysics().SetSolverType(solver_type);
+
+		scene.AddBox({ 0.0f, FLOOR_TOP + 10.0f }, { 600.0f, 20.0f }, BodyType::Static);
+
+		EntityID top = NULL_ENTITY;
+		for (int i = 0; i < STACK_HEIGHT; ++i)
+			top = scene.AddBox({ 0.0f, FLOOR_TOP - BOX_SIZE * (i + 0.5f) }, { BOX_SIZE, BOX_SIZE });
+
+		for (int step = 0; step < 600; ++step)
+			scene.Step();
+
+		const Transform& transform = scene.GetEntityAdmin().GetComponent<Transform>(top);
+
+		const Vector2f expected(0.0f, FLOOR_TOP - BOX_SIZE * (STACK_HEIGHT - 0.5f));
+		const Vector2f offset = transform.GetPosition() - expected;
+
+		VELOX_CHECK(std::abs(offset.x) < BOX_SIZE * 0.25f);
+		VELOX_CHECK(std::abs(offset.y) < 2.0f);
+		VELOX_CHECK(std::abs(std::sin(transform.GetRotation().asRadians())) < 0.05f);
+	}
+}
+
+VELOX_TEST(StackRemainsStandingSequentialImpulse)
+{
+	CheckStack(PhysicsSystem::SolverType::SequentialImpulse);
+}
+
+VELOX_TEST(StackRemainsStandingSoftStep)
+{
+	CheckStack(PhysicsSystem::SolverType::SoftStep);
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <cstdio>
+
+///	Minimal test registry, tests register themselves at static initialization and are run by main. Checks report 
+/// the failing expression and let the test continue, so that one run shows every failure.
+///
+namespace vlx::test
+{
+	using TestFunc = void(*)();
+
+	struct TestCase
+	{
+		const char*	name	{nullptr};
+		TestFunc	func	{nullptr};
+	};
+
+	inline std::vector<TestCase>& GetTests()
+	{
+		static std::vector<TestCase> tests;
+		return tests;
+	}
+
+	inline std::vector<TestCase>& GetBenchmarks()
+	{
+		static std::vector<TestCase> benchmarks;
+		return benchmarks;
+	}
+
+	inline int& GetFailures()
+	{
+		static int failures = 0;
+		return failures;
+	}
+
+	inline void Fail(const char* file, int line, const char* expr)
+	{
+		std::printf("  %s(%d): check failed: %s\n", file, line, expr);
+		++GetFailures();
+	}
+
+	struct Registrar
+	{
+		Registrar(std::vector<TestCase>& list, const char* name, TestFunc func)
+		{
+			list.emplace_back(name, func);
+		}
+	};
+}
+
+#define VELOX_TEST(name)																	\
+	static void name();																		\
+	static const ::vlx::test::Registrar name##_registrar(::vlx::test::GetTests(), #name, &name);	\
+	static void name()
+
+#define VELOX_BENCHMARK(name)																\
+	static void name();																		\
+	static const ::vlx::test::Registrar name##_registrar(::vlx::test::GetBenchmarks(), #name, &name);	\
+	static void name()
+
+#define VELOX_CHECK(expr) ((expr) ? (void)0 : ::vlx::test::Fail(__FILE__, __LINE__, #expr))
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "Test.hpp"
+
+#include <string_view>
+#include <cstdlib>
+
+using namespace vlx;
+
+int main(int argc, char** argv)
+{
+	const bool benchmark = (argc > 1 && std::string_view(argv[1]) == "--bench"); // benchmarks are slow and only printed
+
+	const auto& cases = benchmark ? test::GetBenchmarks() : test::GetTests();
+
+	int failed = 0;
+	for (const test::TestCase& test_case : cases)
+	{
+		std::printf("%s\n", test_case.name);
+
+		const int failures = test::GetFailures();
+		test_case.func();
+
+		if (test::GetFailures() != failures)
+			++failed;
+	}
+
+	std::printf("%d of %d %s failed\n", failed, static_cast<int>(cases.size()), benchmark ? "benchmarks" : "tests");
+
+	return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
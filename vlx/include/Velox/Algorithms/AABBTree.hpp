@@ -0,0 +1,809 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <concepts>
+#include <cfloat>
+
+#include <Velox/System/Rectangle.hpp>
+#include <Velox/System/Vector2.hpp>
+
+#include <Velox/Structures/SmallVector.hpp>
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+namespace vlx
+{
+	///	Dynamic bounding volume tree where every leaf holds an item and its (usually enlarged) rectangle, and every
+	/// branch holds the union of its two children. Unlike the quadtree, the tree has no bounds and adapts to wherever
+	/// the items are located.
+	///
+	/// Leaves are inserted next to the sibling that increases the total perimeter the least, and the tree is kept
+	/// balanced through rotations, so insertion, erasure and moves are O(log n). Proxies returned from insertion
+	/// remain valid until they are erased.
+	///
+	/// Based upon the dynamic tree in Box2D: https://github.com/erincatto/box2d
+	///
+	template<std::equality_comparable T = int>
+	class AABBTree
+	{
+	public:
+		using ElementType	= T;
+		using ValueType		= std::remove_const_t<T>;
+		using SizeType		= int;
+
+		static constexpr SizeType NULL_NODE		= -1;
+		static constexpr SizeType STACK_SIZE	= 64; // nodes kept on the stack while traversing before spilling to the heap
+
+	private:
+		struct Node
+		{
+			RectFloat	rect;					// rectangle encompassing the item or the children
+			ValueType	item		{};
+			SizeType	parent		{NULL_NODE};	// points to the next free node when freed
+			SizeType	left		{NULL_NODE};	// null for leaves
+			SizeType	right		{NULL_NODE};
+			SizeType	height		{0};			// zero for leaves, -1 when freed
+		};
+
+	public:
+		AABBTree() = default;
+
+	public:
+		/// Inserts an item into the tree.
+		///
+		/// \param Rect: Rectangle encompassing the item, usually enlarged to reduce the number of moves.
+		/// \param Item: Item to insert.
+		///
+		/// \returns Proxy to the item, can be used to directly access it when, e.g., erasing it from the tree.
+		///
+		auto Insert(const RectFloat& rect, const T& item) -> SizeType;
+
+		/// Emplace constructs an item into the tree.
+		///
+		/// \param Rect: Rectangle encompassing the item, usually enlarged to reduce the number of moves.
+		/// \param Args: Constructor arguments for the item.
+		///
+		/// \returns Proxy to the item, can be used to directly access it when, e.g., erasing it from the tree.
+		///
+		template<typename... Args> requires std::constructible_from<T, Args...>
+		auto Emplace(const RectFloat& rect, Args&&... args) -> SizeType;
+
+		/// Attempts to erase an item from the tree.
+		///
+		/// \param Proxy: Proxy to the item to erase.
+		///
+		/// \returns True if successfully removed the item, otherwise false.
+		///
+		bool Erase(SizeType proxy);
+
+		/// Moves the item if its new rectangle is no longer contained by the one stored in the tree.
+		///
+		/// \param Proxy: Proxy to the item to move.
+		/// \param Rect: Current rectangle encompassing the item.
+		/// \param FatRect: Enlarged rectangle stored in the tree if the item has to be reinserted.
+		///
+		/// \returns True if the item was reinserted, otherwise false.
+		///
+		bool Move(SizeType proxy, const RectFloat& rect, const RectFloat& fat_rect);
+
+		/// Updates the given item with new data.
+		///
+		/// \param Proxy: Proxy to the item.
+		/// \param Args: Data to update the current item.
+		///
+		/// \returns True if successfully updated the item, otherwise false.
+		///
+		template<typename... Args> requires std::constructible_from<T, Args...>
+		bool Update(SizeType proxy, Args&&... args);
+
+		/// Retrieves an item.
+		///
+		/// \param Proxy: Proxy to the item.
+		///
+		NODISC auto Get(SizeType proxy) -> ValueType&;
+
+		/// Retrieves an item.
+		///
+		/// \param Proxy: Proxy to the item.
+		///
+		NODISC auto Get(SizeType proxy) const -> const ValueType&;
+
+		/// Retrieves the rectangle stored in the tree for the item.
+		///
+		/// \param Proxy: Proxy to the item.
+		///
+		NODISC auto GetRect(SizeType proxy) const -> const RectFloat&;
+
+		/// \returns Number of items in the tree.
+		///
+		NODISC auto GetSize() const noexcept -> SizeType;
+
+		/// \returns Height of the tree, zero if it only has a single item.
+		///
+		NODISC auto GetHeight() const noexcept -> SizeType;
+
+		/// Calls the function for every item overlapping the rectangle, without allocating any memory.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		/// \param Func: Function called as func(proxy, item) for every overlapping item.
+		///
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void Visit(const RectFloat& rect, Func&& func) const;
+
+		/// Calls the function for every item overlapping the point, without allocating any memory.
+		///
+		/// \param Point: Point to search for overlapping items.
+		/// \param Func: Function called as func(proxy, item) for every overlapping item.
+		///
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void Visit(const Vector2f& point, Func&& func) const;
+
+		/// Calls the function for every item whose rectangle is crossed by the segment from origin to origin + 
+		/// direction. The function returns how far along the segment to keep searching, which lets the search skip 
+		/// everything behind the closest hit found so far.
+		///
+		/// \param Origin: Start of the segment.
+		/// \param Direction: Direction and length of the segment.
+		/// \param Func: Function called as func(proxy, item) for every crossed item, returns the fraction of the 
+		/// segment to continue searching within, zero to stop.
+		///
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void RayCast(const Vector2f& origin, const Vector2f& direction, Func&& func) const;
+
+		/// Queries the tree for items.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		///
+		/// \returns Proxies to the items overlapping the rectangle.
+		///
+		NODISC auto Query(const RectFloat& rect) const -> std::vector<SizeType>;
+
+		/// Queries the tree for items.
+		///
+		/// \param Point: Point to search for overlapping items.
+		///
+		/// \returns Proxies to the items overlapping the point.
+		///
+		NODISC auto Query(const Vector2f& point) const -> std::vector<SizeType>;
+
+		/// Queries the tree for items, while also omitting items that do not fulfill the user-provided function.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		/// \param Func: Function called with the item, returns true if it should be included.
+		///
+		/// \returns Proxies to the items overlapping the rectangle.
+		///
+		template<typename Func> requires std::predicate<Func, const ValueType&>
+		NODISC auto Query(const RectFloat& rect, Func&& func) const -> std::vector<SizeType>;
+
+		/// Queries the tree for items, while also omitting items that do not fulfill the user-provided function.
+		///
+		/// \param Point: Point to search for overlapping items.
+		/// \param Func: Function called with the item, returns true if it should be included.
+		///
+		/// \returns Proxies to the items overlapping the point.
+		///
+		template<typename Func> requires std::predicate<Func, const ValueType&>
+		NODISC auto Query(const Vector2f& point, Func&& func) const -> std::vector<SizeType>;
+
+		/// Queries the tree for items and writes them to the output, e.g., a back inserter to a reused vector.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		/// \param Out: Output iterator that the proxies are written to.
+		///
+		/// \returns Output iterator one past the last written proxy.
+		///
+		template<std::output_iterator<SizeType> OutIt>
+		auto Query(const RectFloat& rect, OutIt out) const -> OutIt;
+
+		/// Queries the tree for items and writes them to the output, e.g., a back inserter to a reused vector.
+		///
+		/// \param Point: Point to search for overlapping items.
+		/// \param Out: Output iterator that the proxies are written to.
+		///
+		/// \returns Output iterator one past the last written proxy.
+		///
+		template<std::output_iterator<SizeType> OutIt>
+		auto Query(const Vector2f& point, OutIt out) const -> OutIt;
+
+		/// Clears the tree.
+		///
+		void Clear();
+
+	private:
+		auto AllocateNode() -> SizeType;
+		void FreeNode(SizeType node);
+
+		void InsertLeaf(SizeType leaf);
+		void RemoveLeaf(SizeType leaf);
+
+		void Refit(SizeType index);
+		auto Balance(SizeType index) -> SizeType;
+
+		NODISC bool IsValid(SizeType proxy) const;
+
+		static bool IsLeaf(const Node& node);
+		static float Perimeter(const RectFloat& rect);
+
+	private:
+		std::vector<Node>	m_nodes;
+		SizeType			m_root	{NULL_NODE};
+		SizeType			m_free	{NULL_NODE};	// first node in the free list
+		SizeType			m_size	{0};			// number of leaves
+	};
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::Insert(const RectFloat& rect, const T& item) -> SizeType
+	{
+		return Emplace(rect, item);
+	}
+
+	template<std::equality_comparable T>
+	template<typename... Args> requires std::constructible_from<T, Args...>
+	inline auto AABBTree<T>::Emplace(const RectFloat& rect, Args&&... args) -> SizeType
+	{
+		const SizeType proxy = AllocateNode();
+
+		Node& node = m_nodes[proxy];
+		node.rect	= rect;
+		node.item	= T(std::forward<Args>(args)...);
+		node.height = 0;
+
+		InsertLeaf(proxy);
+		++m_size;
+
+		return proxy;
+	}
+
+	template<std::equality_comparable T>
+	inline bool AABBTree<T>::Erase(SizeType proxy)
+	{
+		if (!IsValid(proxy))
+			return false;
+
+		RemoveLeaf(proxy);
+		FreeNode(proxy);
+
+		--m_size;
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	inline bool AABBTree<T>::Move(SizeType proxy, const RectFloat& rect, const RectFloat& fat_rect)
+	{
+		assert(IsValid(proxy));
+
+		if (m_nodes[proxy].rect.Contains(rect)) // still inside its enlarged rectangle, nothing to do
+			return false;
+
+		RemoveLeaf(proxy);
+		m_nodes[proxy].rect = fat_rect;
+		InsertLeaf(proxy);
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	template<typename... Args> requires std::constructible_from<T, Args...>
+	inline bool AABBTree<T>::Update(SizeType proxy, Args&&... args)
+	{
+		if (!IsValid(proxy))
+			return false;
+
+		m_nodes[proxy].item = T(std::forward<Args>(args)...);
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::Get(SizeType proxy) -> ValueType&
+	{
+		assert(IsValid(proxy));
+		return m_nodes[proxy].item;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::Get(SizeType proxy) const -> const ValueType&
+	{
+		assert(IsValid(proxy));
+		return m_nodes[proxy].item;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::GetRect(SizeType proxy) const -> const RectFloat&
+	{
+		assert(IsValid(proxy));
+		return m_nodes[proxy].rect;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::GetSize() const noexcept -> SizeType
+	{
+		return m_size;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::GetHeight() const noexcept -> SizeType
+	{
+		return (m_root != NULL_NODE) ? m_nodes[m_root].height : 0;
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename AABBTree<T>::SizeType, const typename AABBTree<T>::ValueType&>
+	inline void AABBTree<T>::Visit(const RectFloat& rect, Func&& func) const
+	{
+		if (m_root == NULL_NODE)
+			return;
+
+		SmallVector<SizeType, STACK_SIZE> to_process;
+		to_process.emplace_back(m_root);
+
+		while (!to_process.empty())
+		{
+			const SizeType index = to_process.back();
+			const Node& node = m_nodes[index];
+
+			to_process.pop_back();
+
+			if (!rect.Overlaps(node.rect))
+				continue;
+
+			if (IsLeaf(node))
+			{
+				func(index, node.item);
+			}
+			else // it's a branch
+			{
+				to_process.emplace_back(node.left);
+				to_process.emplace_back(node.right);
+			}
+		}
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename AABBTree<T>::SizeType, const typename AABBTree<T>::ValueType&>
+	inline void AABBTree<T>::Visit(const Vector2f& point, Func&& func) const
+	{
+		Visit(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename AABBTree<T>::SizeType, const typename AABBTree<T>::ValueType&>
+	inline void AABBTree<T>::RayCast(const Vector2f& origin, const Vector2f& direction, Func&& func) const
+	{
+		if (m_root == NULL_NODE)
+			return;
+
+		const auto Crosses = [&origin, &direction](const RectFloat& rect, float max_fraction) // slab test
+		{
+			float t_min = 0.0f;
+			float t_max = max_fraction;
+
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				const float o		= (axis == 0) ? origin.x : origin.y;
+				const float d		= (axis == 0) ? direction.x : direction.y;
+				const float lower	= (axis == 0) ? rect.left : rect.top;
+				const float upper	= (axis == 0) ? rect.Right() : rect.Bottom();
+
+				if (std::abs(d) < FLT_EPSILON)
+				{
+					if (o < lower || o > upper)
+						return false;
+
+					continue;
+				}
+
+				const float inv_d = 1.0f / d;
+
+				float t1 = (lower - o) * inv_d;
+				float t2 = (upper - o) * inv_d;
+
+				if (t1 > t2)
+					std::swap(t1, t2);
+
+				t_min = std::max(t_min, t1);
+				t_max = std::min(t_max, t2);
+
+				if (t_min > t_max)
+					return false;
+			}
+
+			return true;
+		};
+
+		float max_fraction = 1.0f;
+
+		SmallVector<SizeType, STACK_SIZE> to_process;
+		to_process.emplace_back(m_root);
+
+		while (!to_process.empty())
+		{
+			const SizeType index = to_process.back();
+			const Node& node = m_nodes[index];
+
+			to_process.pop_back();
+
+			if (!Crosses(node.rect, max_fraction))
+				continue;
+
+			if (IsLeaf(node))
+			{
+				max_fraction = std::min(max_fraction, static_cast<float>(func(index, node.item)));
+
+				if (max_fraction <= 0.0f)
+					return;
+			}
+			else // closer child is processed first, so that hits found early cut off more of the ray
+			{
+				const auto Along = [&origin, &direction](const RectFloat& rect)
+				{
+					return Vector2f::Direction(origin, rect.Center()).Dot(direction);
+				};
+
+				const bool left_first = Along(m_nodes[node.left].rect) <= Along(m_nodes[node.right].rect);
+
+				to_process.emplace_back(left_first ? node.right : node.left);
+				to_process.emplace_back(left_first ? node.left : node.right);
+			}
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::Query(const RectFloat& rect) const -> std::vector<SizeType>
+	{
+		std::vector<SizeType> result;
+		Query(rect, std::back_inserter(result));
+
+		return result;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::Query(const Vector2f& point) const -> std::vector<SizeType>
+	{
+		return Query(RectFloat(point.x, point.y, 0.f, 0.f));
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func> requires std::predicate<Func, const typename AABBTree<T>::ValueType&>
+	inline auto AABBTree<T>::Query(const RectFloat& rect, Func&& func) const -> std::vector<SizeType>
+	{
+		std::vector<SizeType> result;
+		Visit(rect,
+			[&result, &func](SizeType proxy, const ValueType& item)
+			{
+				if (func(item))
+					result.emplace_back(proxy);
+			});
+
+		return result;
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func> requires std::predicate<Func, const typename AABBTree<T>::ValueType&>
+	inline auto AABBTree<T>::Query(const Vector2f& point, Func&& func) const -> std::vector<SizeType>
+	{
+		return Query(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
+	}
+
+	template<std::equality_comparable T>
+	template<std::output_iterator<typename AABBTree<T>::SizeType> OutIt>
+	inline auto AABBTree<T>::Query(const RectFloat& rect, OutIt out) const -> OutIt
+	{
+		Visit(rect,
+			[&out](SizeType proxy, const ValueType&)
+			{
+				*out++ = proxy;
+			});
+
+		return out;
+	}
+
+	template<std::equality_comparable T>
+	template<std::output_iterator<typename AABBTree<T>::SizeType> OutIt>
+	inline auto AABBTree<T>::Query(const Vector2f& point, OutIt out) const -> OutIt
+	{
+		return Query(RectFloat(point.x, point.y, 0.f, 0.f), std::move(out));
+	}
+
+	template<std::equality_comparable T>
+	inline void AABBTree<T>::Clear()
+	{
+		m_nodes.clear();
+
+		m_root = NULL_NODE;
+		m_free = NULL_NODE;
+		m_size = 0;
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::AllocateNode() -> SizeType
+	{
+		if (m_free == NULL_NODE)
+		{
+			m_nodes.emplace_back();
+			return static_cast<SizeType>(m_nodes.size() - 1);
+		}
+
+		const SizeType index = m_free;
+		m_free = m_nodes[index].parent;
+
+		m_nodes[index] = Node{};
+
+		return index;
+	}
+
+	template<std::equality_comparable T>
+	inline void AABBTree<T>::FreeNode(SizeType index)
+	{
+		Node& node = m_nodes[index];
+
+		node.parent = m_free;
+		node.height = -1;
+
+		m_free = index;
+	}
+
+	template<std::equality_comparable T>
+	inline void AABBTree<T>::InsertLeaf(SizeType leaf)
+	{
+		if (m_root == NULL_NODE)
+		{
+			m_root = leaf;
+			m_nodes[leaf].parent = NULL_NODE;
+
+			return;
+		}
+
+		const RectFloat leaf_rect = m_nodes[leaf].rect;
+
+		// find the best sibling by descending towards the child that increases the perimeter the least
+
+		SizeType index = m_root;
+		while (!IsLeaf(m_nodes[index]))
+		{
+			const Node& node = m_nodes[index];
+
+			const float perimeter		= Perimeter(node.rect);
+			const float combined		= Perimeter(node.rect.Union(leaf_rect));
+
+			const float cost			= 2.0f * combined;				// cost of making a new parent for this node and the leaf
+			const float inheritance		= 2.0f * (combined - perimeter);	// minimum cost of pushing the leaf further down
+
+			const auto ChildCost = [this, &leaf_rect, inheritance](SizeType child)
+			{
+				const Node& child_node	= m_nodes[child];
+				const float child_cost	= Perimeter(child_node.rect.Union(leaf_rect));
+
+				return (IsLeaf(child_node) ? child_cost : child_cost - Perimeter(child_node.rect)) + inheritance;
+			};
+
+			const float cost_left	= ChildCost(node.left);
+			const float cost_right	= ChildCost(node.right);
+
+			if (cost < cost_left && cost < cost_right)
+				break;
+
+			index = (cost_left < cost_right) ? node.left : node.right;
+		}
+
+		const SizeType sibling		= index;
+		const SizeType old_parent	= m_nodes[sibling].parent;
+		const SizeType new_parent	= AllocateNode(); // may invalidate references to nodes
+
+		m_nodes[new_parent].parent	= old_parent;
+		m_nodes[new_parent].rect	= m_nodes[sibling].rect.Union(leaf_rect);
+		m_nodes[new_parent].height	= m_nodes[sibling].height + 1;
+		m_nodes[new_parent].left	= sibling;
+		m_nodes[new_parent].right	= leaf;
+
+		m_nodes[sibling].parent		= new_parent;
+		m_nodes[leaf].parent		= new_parent;
+
+		if (old_parent != NULL_NODE)
+		{
+			if (m_nodes[old_parent].left == sibling)
+				m_nodes[old_parent].left = new_parent;
+			else
+				m_nodes[old_parent].right = new_parent;
+		}
+		else m_root = new_parent;
+
+		Refit(m_nodes[leaf].parent);
+	}
+
+	template<std::equality_comparable T>
+	inline void AABBTree<T>::RemoveLeaf(SizeType leaf)
+	{
+		if (leaf == m_root)
+		{
+			m_root = NULL_NODE;
+			return;
+		}
+
+		const SizeType parent		= m_nodes[leaf].parent;
+		const SizeType grand_parent = m_nodes[parent].parent;
+		const SizeType sibling		= (m_nodes[parent].left == leaf) ? m_nodes[parent].right : m_nodes[parent].left;
+
+		if (grand_parent != NULL_NODE) // replace the parent with the sibling
+		{
+			if (m_nodes[grand_parent].left == parent)
+				m_nodes[grand_parent].left = sibling;
+			else
+				m_nodes[grand_parent].right = sibling;
+
+			m_nodes[sibling].parent = grand_parent;
+			FreeNode(parent);
+
+			Refit(grand_parent);
+		}
+		else
+		{
+			m_root = sibling;
+			m_nodes[sibling].parent = NULL_NODE;
+
+			FreeNode(parent);
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline void AABBTree<T>::Refit(SizeType index)
+	{
+		while (index != NULL_NODE) // walk back up, rebalancing and fitting the ancestors
+		{
+			index = Balance(index);
+
+			Node& node = m_nodes[index];
+
+			const Node& left	= m_nodes[node.left];
+			const Node& right	= m_nodes[node.right];
+
+			node.height = 1 + std::max(left.height, right.height);
+			node.rect	= left.rect.Union(right.rect);
+
+			index = node.parent;
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline auto AABBTree<T>::Balance(SizeType ia) -> SizeType
+	{
+		Node& a = m_nodes[ia];
+
+		if (IsLeaf(a) || a.height < 2)
+			return ia;
+
+		const SizeType ib = a.left;
+		const SizeType ic = a.right;
+
+		Node& b = m_nodes[ib];
+		Node& c = m_nodes[ic];
+
+		const SizeType balance = c.height - b.height;
+
+		const auto ReplaceChild = [this](SizeType parent, SizeType old_child, SizeType new_child)
+		{
+			if (parent == NULL_NODE)
+			{
+				m_root = new_child;
+				return;
+			}
+
+			if (m_nodes[parent].left == old_child)
+				m_nodes[parent].left = new_child;
+			else
+				m_nodes[parent].right = new_child;
+		};
+
+		if (balance > 1) // rotate c up
+		{
+			const SizeType ifc = c.left;
+			const SizeType igc = c.right;
+
+			Node& f = m_nodes[ifc];
+			Node& g = m_nodes[igc];
+
+			c.left		= ia;
+			c.parent	= a.parent;
+			a.parent	= ic;
+
+			ReplaceChild(c.parent, ia, ic);
+
+			if (f.height > g.height)
+			{
+				c.right		= ifc;
+				a.right		= igc;
+				g.parent	= ia;
+
+				a.rect		= b.rect.Union(g.rect);
+				c.rect		= a.rect.Union(f.rect);
+
+				a.height	= 1 + std::max(b.height, g.height);
+				c.height	= 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.right		= igc;
+				a.right		= ifc;
+				f.parent	= ia;
+
+				a.rect		= b.rect.Union(f.rect);
+				c.rect		= a.rect.Union(g.rect);
+
+				a.height	= 1 + std::max(b.height, f.height);
+				c.height	= 1 + std::max(a.height, g.height);
+			}
+
+			return ic;
+		}
+
+		if (balance < -1) // rotate b up
+		{
+			const SizeType id = b.left;
+			const SizeType ie = b.right;
+
+			Node& d = m_nodes[id];
+			Node& e = m_nodes[ie];
+
+			b.left		= ia;
+			b.parent	= a.parent;
+			a.parent	= ib;
+
+			ReplaceChild(b.parent, ia, ib);
+
+			if (d.height > e.height)
+			{
+				b.right		= id;
+				a.left		= ie;
+				e.parent	= ia;
+
+				a.rect		= c.rect.Union(e.rect);
+				b.rect		= a.rect.Union(d.rect);
+
+				a.height	= 1 + std::max(c.height, e.height);
+				b.height	= 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.right		= ie;
+				a.left		= id;
+				d.parent	= ia;
+
+				a.rect		= c.rect.Union(d.rect);
+				b.rect		= a.rect.Union(e.rect);
+
+				a.height	= 1 + std::max(c.height, d.height);
+				b.height	= 1 + std::max(a.height, e.height);
+			}
+
+			return ib;
+		}
+
+		return ia;
+	}
+
+	template<std::equality_comparable T>
+	inline bool AABBTree<T>::IsValid(SizeType proxy) const
+	{
+		return proxy >= 0 && proxy < static_cast<SizeType>(m_nodes.size()) &&
+			m_nodes[proxy].height == 0 && IsLeaf(m_nodes[proxy]);
+	}
+
+	template<std::equality_comparable T>
+	inline bool AABBTree<T>::IsLeaf(const Node& node)
+	{
+		return node.left == NULL_NODE;
+	}
+
+	template<std::equality_comparable T>
+	inline float AABBTree<T>::Perimeter(const RectFloat& rect)
+	{
+		return 2.0f * (std::abs(rect.width) + std::abs(rect.height));
+	}
+}
\ No newline at end of file
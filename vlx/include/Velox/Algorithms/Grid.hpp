@@ -1,7 +1,491 @@
 #pragma once
 
-template<typename T>
-class Grid
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <bit>
+
+#include <Velox/System/Rectangle.hpp>
+#include <Velox/System/Vector2.hpp>
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+namespace vlx
 {
+	///	Uniform grid of square cells that is hashed into a fixed number of buckets, so it has no bounds. Items are
+	/// added to every cell their rectangle covers. The contents of all buckets are stored contiguously in a single
+	/// array that is rebuilt from scratch, which is cheap when most items move every frame, e.g., bullets and particles.
+	///
+	/// Modifications only take effect on the next rebuild. Queries do not allocate and report every item once, even
+	/// when it covers several of the searched cells.
+	///
+	/// Best suited for many items of a similar size to the cells, large items cover many cells and are slow to insert.
+	///
+	template<std::equality_comparable T = int>
+	class Grid
+	{
+	public:
+		using ElementType	= T;
+		using ValueType		= std::remove_const_t<T>;
+		using SizeType		= int;
+
+		static constexpr SizeType NULL_PROXY = -1;
+
+	private:
+		static constexpr float CELL_LIMIT = static_cast<float>(1 << 29); // cell coordinates are clamped to keep the ranges within int32
+
+		struct Cells // inclusive range of cells
+		{
+			int32 x0 {0}, y0 {0};
+			int32 x1 {-1}, y1 {-1};
+		};
+
+		struct Box
+		{
+			RectFloat	rect;
+			ValueType	item		{};
+			Cells		cells;					// cells covered when last rebuilt
+			uint32		generation	{0};		// increased when erased, so old entries are not mistaken for a new item
+			SizeType	next_free	{NULL_PROXY};
+			bool		alive		{false};
+		};
+
+		struct Entry
+		{
+			SizeType	proxy		{NULL_PROXY};
+			uint32		generation	{0};	// generation of the item when the entry was placed
+			int32		x			{0};	// cell the entry belongs to, buckets may contain several cells
+			int32		y			{0};
+		};
+
+	public:
+		///	\param CellSize: Width and height of every cell
+		///
+		explicit Grid(float cell_size = 64.0f);
+
+	public:
+		/// Inserts an item, it can be found after the next rebuild.
+		///
+		/// \param Rect: Rectangle encompassing the item.
+		/// \param Item: Item to insert.
+		///
+		/// \returns Proxy to the item, can be used to directly access it when, e.g., erasing it.
+		///
+		auto Insert(const RectFloat& rect, const T& item) -> SizeType;
+
+		/// Emplace constructs an item, it can be found after the next rebuild.
+		///
+		/// \param Rect: Rectangle encompassing the item.
+		/// \param Args: Constructor arguments for the item.
+		///
+		/// \returns Proxy to the item, can be used to directly access it when, e.g., erasing it.
+		///
+		template<typename... Args> requires std::constructible_from<T, Args...>
+		auto Emplace(const RectFloat& rect, Args&&... args) -> SizeType;
+
+		/// Erases an item, it is no longer found by queries.
+		///
+		/// \param Proxy: Proxy to the item to erase.
+		///
+		/// \returns True if successfully removed the item, otherwise false.
+		///
+		bool Erase(SizeType proxy);
+
+		/// Sets the rectangle of the item, the cells it belongs to are updated on the next rebuild.
+		///
+		/// \param Proxy: Proxy to the item to move.
+		/// \param Rect: New rectangle encompassing the item.
+		///
+		void Move(SizeType proxy, const RectFloat& rect);
+
+		/// Updates the given item with new data.
+		///
+		/// \param Proxy: Proxy to the item.
+		/// \param Args: Data to update the current item.
+		///
+		/// \returns True if successfully updated the item, otherwise false.
+		///
+		template<typename... Args> requires std::constructible_from<T, Args...>
+		bool Update(SizeType proxy, Args&&... args);
+
+		/// Redistributes all of the items into the cells they currently cover.
+		///
+		void Rebuild();
+
+		/// Sets the size of the cells, takes effect on the next rebuild.
+		///
+		void SetCellSize(float cell_size);
+
+		NODISC float GetCellSize() const noexcept;
+
+		NODISC auto Get(SizeType proxy) -> ValueType&;
+		NODISC auto Get(SizeType proxy) const -> const ValueType&;
+
+		NODISC auto GetRect(SizeType proxy) const -> const RectFloat&;
+
+	public:
+		/// Calls the function with the proxy of every item overlapping the rectangle.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		/// \param Func: Function called as func(proxy, item).
+		///
+		template<typename Func>
+		void Visit(const RectFloat& rect, Func&& func) const;
+
+		/// Calls the function with the proxy of every item overlapping the point.
+		///
+		/// \param Point: Point to search for overlapping items.
+		/// \param Func: Function called as func(proxy, item).
+		///
+		template<typename Func>
+		void Visit(const Vector2f& point, Func&& func) const;
+
+		/// Calls the function with the proxy of every item overlapping the circle.
+		///
+		/// \param Center: Center of the circle.
+		/// \param Radius: Radius of the circle.
+		/// \param Func: Function called as func(proxy, item).
+		///
+		template<typename Func>
+		void Visit(const Vector2f& center, float radius, Func&& func) const;
+
+		/// Queries the grid for items.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		///
+		/// \returns Proxies to the items overlapping the rectangle.
+		///
+		NODISC auto Query(const RectFloat& rect) const -> std::vector<SizeType>;
+
+		/// Queries the grid for items.
+		///
+		/// \param Point: Point to search for overlapping items.
+		///
+		/// \returns Proxies to the items overlapping the point.
+		///
+		NODISC auto Query(const Vector2f& point) const -> std::vector<SizeType>;
+
+		/// Clears all of the items.
+		///
+		void Clear();
+
+	private:
+		template<typename Overlaps, typename Func>
+		void VisitCells(const Cells& cells, Overlaps&& overlaps, Func&& func) const;
+
+		NODISC Cells GetCells(const RectFloat& rect) const;
+		NODISC int32 GetCell(float value) const;
+		NODISC std::size_t GetBucket(int32 x, int32 y) const;
+
+		NODISC bool IsValid(SizeType proxy) const;
+
+	private:
+		std::vector<Box>			m_boxes;
+		std::vector<Entry>			m_entries;	// contents of every bucket, stored one after another
+		std::vector<SizeType>		m_offsets;	// start of every bucket in the entries, one extra for the end
+		std::vector<SizeType>		m_heads;	// next free entry of every bucket while rebuilding
+
+		float						m_cell_size		{64.0f};
+		float						m_inv_cell_size	{1.0f / 64.0f};
+
+		SizeType					m_free			{NULL_PROXY};
+	};
+
+	template<std::equality_comparable T>
+	inline Grid<T>::Grid(float cell_size)
+	{
+		SetCellSize(cell_size);
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::Insert(const RectFloat& rect, const T& item) -> SizeType
+	{
+		return Emplace(rect, item);
+	}
+
+	template<std::equality_comparable T>
+	template<typename... Args> requires std::constructible_from<T, Args...>
+	inline auto Grid<T>::Emplace(const RectFloat& rect, Args&&... args) -> SizeType
+	{
+		SizeType proxy = m_free;
+
+		if (proxy != NULL_PROXY)
+			m_free = m_boxes[proxy].next_free;
+		else
+		{
+			proxy = static_cast<SizeType>(m_boxes.size());
+			m_boxes.emplace_back();
+		}
+
+		Box& box = m_boxes[proxy];
+
+		box.rect		= rect;
+		box.item		= T(std::forward<Args>(args)...);
+		box.cells		= Cells{};
+		box.next_free	= NULL_PROXY;
+		box.alive		= true;
+
+		return proxy;
+	}
+
+	template<std::equality_comparable T>
+	inline bool Grid<T>::Erase(SizeType proxy)
+	{
+		if (!IsValid(proxy))
+			return false;
+
+		Box& box = m_boxes[proxy];
+
+		box.alive		= false; // entries remain until the next rebuild, but are skipped
+		box.next_free	= m_free;
+
+		++box.generation;
+
+		m_free = proxy;
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	inline void Grid<T>::Move(SizeType proxy, const RectFloat& rect)
+	{
+		assert(IsValid(proxy));
+		m_boxes[proxy].rect = rect;
+	}
+
+	template<std::equality_comparable T>
+	template<typename... Args> requires std::constructible_from<T, Args...>
+	inline bool Grid<T>::Update(SizeType proxy, Args&&... args)
+	{
+		if (!IsValid(proxy))
+			return false;
+
+		m_boxes[proxy].item = T(std::forward<Args>(args)...);
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	inline void Grid<T>::Rebuild()
+	{
+		std::size_t entry_count = 0;
+
+		for (Box& box : m_boxes)
+		{
+			if (!box.alive)
+				continue;
+
+			box.cells = GetCells(box.rect);
+			entry_count += static_cast<std::size_t>(box.cells.x1 - box.cells.x0 + 1) * (box.cells.y1 - box.cells.y0 + 1);
+		}
+
+		// twice as many buckets as entries keeps the buckets short, rounded to a power of two for cheap hashing
+
+		const std::size_t bucket_count = std::bit_ceil(std::max<std::size_t>(entry_count * 2, 64));
+
+		m_offsets.assign(bucket_count + 1, 0);
+		m_entries.resize(entry_count);
+
+		for (const Box& box : m_boxes) // count the entries in every bucket
+		{
+			if (!box.alive)
+				continue;
+
+			for (int32 y = box.cells.y0; y <= box.cells.y1; ++y)
+				for (int32 x = box.cells.x0; x <= box.cells.x1; ++x)
+					++m_offsets[GetBucket(x, y) + 1];
+		}
+
+		for (std::size_t i = 1; i < m_offsets.size(); ++i)
+			m_offsets[i] += m_offsets[i - 1];
+
+		m_heads.assign(m_offsets.begin(), m_offsets.end() - 1);
+
+		for (SizeType proxy = 0; proxy < static_cast<SizeType>(m_boxes.size()); ++proxy) // place the entries
+		{
+			const Box& box = m_boxes[proxy];
+
+			if (!box.alive)
+				continue;
+
+			for (int32 y = box.cells.y0; y <= box.cells.y1; ++y)
+				for (int32 x = box.cells.x0; x <= box.cells.x1; ++x)
+					m_entries[m_heads[GetBucket(x, y)]++] = Entry{ proxy, box.generation, x, y };
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline void Grid<T>::SetCellSize(float cell_size)
+	{
+		assert(cell_size > 0.0f && "Cells have to have a size");
+
+		m_cell_size		= cell_size;
+		m_inv_cell_size = 1.0f / cell_size;
+	}
+
+	template<std::equality_comparable T>
+	inline float Grid<T>::GetCellSize() const noexcept
+	{
+		return m_cell_size;
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::Get(SizeType proxy) -> ValueType&
+	{
+		assert(IsValid(proxy));
+		return m_boxes[proxy].item;
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::Get(SizeType proxy) const -> const ValueType&
+	{
+		assert(IsValid(proxy));
+		return m_boxes[proxy].item;
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::GetRect(SizeType proxy) const -> const RectFloat&
+	{
+		assert(IsValid(proxy));
+		return m_boxes[proxy].rect;
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func>
+	inline void Grid<T>::Visit(const RectFloat& rect, Func&& func) const
+	{
+		VisitCells(GetCells(rect),
+			[&rect](const RectFloat& item_rect)
+			{
+				return rect.Overlaps(item_rect);
+			}, std::forward<Func>(func));
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func>
+	inline void Grid<T>::Visit(const Vector2f& point, Func&& func) const
+	{
+		Visit(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func>
+	inline void Grid<T>::Visit(const Vector2f& center, float radius, Func&& func) const
+	{
+		const RectFloat bounds(center.x - radius, center.y - radius, radius * 2.0f, radius * 2.0f);
+
+		VisitCells(GetCells(bounds),
+			[&center, radius](const RectFloat& item_rect)
+			{
+				const float left	= std::min(item_rect.left, item_rect.Right());
+				const float right	= std::max(item_rect.left, item_rect.Right());
+				const float top		= std::min(item_rect.top, item_rect.Bottom());
+				const float bottom	= std::max(item_rect.top, item_rect.Bottom());
+
+				const float dx = center.x - std::clamp(center.x, left, right); // distance to the closest point
+				const float dy = center.y - std::clamp(center.y, top, bottom);
+
+				return dx * dx + dy * dy <= radius * radius;
+			}, std::forward<Func>(func));
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::Query(const RectFloat& rect) const -> std::vector<SizeType>
+	{
+		std::vector<SizeType> result;
+		Visit(rect,
+			[&result](SizeType proxy, const ValueType&)
+			{
+				result.emplace_back(proxy);
+			});
+
+		return result;
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::Query(const Vector2f& point) const -> std::vector<SizeType>
+	{
+		return Query(RectFloat(point.x, point.y, 0.f, 0.f));
+	}
+
+	template<std::equality_comparable T>
+	inline void Grid<T>::Clear()
+	{
+		m_boxes.clear();
+		m_entries.clear();
+		m_offsets.clear();
+		m_heads.clear();
+
+		m_free = NULL_PROXY;
+	}
+
+	template<std::equality_comparable T>
+	template<typename Overlaps, typename Func>
+	inline void Grid<T>::VisitCells(const Cells& cells, Overlaps&& overlaps, Func&& func) const
+	{
+		if (m_offsets.empty()) // has not been built yet
+			return;
+
+		for (int32 y = cells.y0; y <= cells.y1; ++y)
+		{
+			for (int32 x = cells.x0; x <= cells.x1; ++x)
+			{
+				const std::size_t bucket = GetBucket(x, y);
+
+				for (SizeType i = m_offsets[bucket]; i < m_offsets[bucket + 1]; ++i)
+				{
+					const Entry& entry = m_entries[i];
+
+					if (entry.x != x || entry.y != y) // another cell that hashed to the same bucket
+						continue;
+
+					const Box& box = m_boxes[entry.proxy];
+
+					if (!box.alive || box.generation != entry.generation) // erased, or erased and reused since the rebuild
+						continue;
+
+					// only report from the first cell shared by the item and the searched area, to avoid duplicates
+
+					if (x != std::max(cells.x0, box.cells.x0) || y != std::max(cells.y0, box.cells.y0))
+						continue;
+
+					if (overlaps(box.rect))
+						func(entry.proxy, box.item);
+				}
+			}
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline auto Grid<T>::GetCells(const RectFloat& rect) const -> Cells
+	{
+		const float left	= std::min(rect.left, rect.Right());
+		const float right	= std::max(rect.left, rect.Right());
+		const float top		= std::min(rect.top, rect.Bottom());
+		const float bottom	= std::max(rect.top, rect.Bottom());
+
+		return Cells{ GetCell(left), GetCell(top), GetCell(right), GetCell(bottom) };
+	}
+
+	template<std::equality_comparable T>
+	inline int32 Grid<T>::GetCell(float value) const
+	{
+		const float cell = std::floor(value * m_inv_cell_size);
+		return static_cast<int32>(std::max(-CELL_LIMIT, std::min(cell, CELL_LIMIT))); // casting out of range is undefined, NaN ends up at the lower limit
+	}
+
+	template<std::equality_comparable T>
+	inline std::size_t Grid<T>::GetBucket(int32 x, int32 y) const
+	{
+		const uint32 hash = (static_cast<uint32>(x) * 73856093u) ^ (static_cast<uint32>(y) * 19349663u);
+		return static_cast<std::size_t>(hash) & (m_offsets.size() - 2); // bucket count is a power of two
+	}
 
-};
\ No newline at end of file
+	template<std::equality_comparable T>
+	inline bool Grid<T>::IsValid(SizeType proxy) const
+	{
+		return proxy >= 0 && proxy < static_cast<SizeType>(m_boxes.size()) && m_boxes[proxy].alive;
+	}
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include <optional>
 #include <shared_mutex>
 #include <algorithm>
+#include <iterator>
+#include <concepts>
 
 #include <Velox/System/Rectangle.hpp>
 #include <Velox/System/Vector2.hpp>
@@ -27,6 +29,7 @@ namespace vlx
 		using SizeType		= int;
 
 		static constexpr int CHILD_COUNT = 4;
+		static constexpr int STACK_SIZE	 = 64; // nodes kept on the stack while traversing before spilling to the heap
 
 	public:
 		struct Element
@@ -106,6 +109,40 @@ namespace vlx
 		/// 
 		NODISC auto GetRect(SizeType ei) const -> const RectFloat&;
 
+		/// Calls the function for every element overlapping the rectangle, without allocating any memory.
+		/// 
+		/// \param Rect: Rectangle to search for overlapping elements.
+		/// \param Func: Function called as func(index, item) for every overlapping element.
+		/// 
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void Visit(const RectFloat& rect, Func&& func) const;
+
+		/// Calls the function for every element overlapping the point, without allocating any memory.
+		/// 
+		/// \param Point: Point to search for overlapping elements.
+		/// \param Func: Function called as func(index, item) for every overlapping element.
+		/// 
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void Visit(const Vector2f& point, Func&& func) const;
+
+		/// Same as Visit, but without taking the lock. Only use when the tree is guaranteed to not be modified while
+		/// visiting, e.g., during a read-only phase where many threads search the tree at once.
+		/// 
+		/// \param Rect: Rectangle to search for overlapping elements.
+		/// \param Func: Function called as func(index, item) for every overlapping element.
+		/// 
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void VisitUnlocked(const RectFloat& rect, Func&& func) const;
+
+		/// Same as Visit, but without taking the lock. Only use when the tree is guaranteed to not be modified while
+		/// visiting.
+		/// 
+		/// \param Point: Point to search for overlapping elements.
+		/// \param Func: Function called as func(index, item) for every overlapping element.
+		/// 
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void VisitUnlocked(const Vector2f& point, Func&& func) const;
+
 		/// Queries the tree for elements.
 		/// 
 		/// \param Rect: Bounding rectangle where all the elements are contained.
@@ -129,7 +166,7 @@ namespace vlx
 		/// 
 		/// \returns List of entities contained at the point.
 		/// 
-		template<typename Func>
+		template<typename Func> requires std::predicate<Func, const ValueType&>
 		NODISC auto Query(const RectFloat& rect, Func&& func) const -> std::vector<SizeType>;
 
 		/// Queries the tree for elements, while also omitting elements that does not fulfill the user-provided function.
@@ -139,9 +176,29 @@ namespace vlx
 		/// 
 		/// \returns List of entities contained at the point.
 		/// 
-		template<typename Func>
+		template<typename Func> requires std::predicate<Func, const ValueType&>
 		NODISC auto Query(const Vector2f& point, Func&& func) const -> std::vector<SizeType>;
 
+		/// Queries the tree for elements and writes them to the output, e.g., a back inserter to a reused vector.
+		/// 
+		/// \param Rect: Bounding rectangle where all the elements are contained.
+		/// \param Out: Output iterator that the indices are written to.
+		/// 
+		/// \returns Output iterator one past the last written index.
+		/// 
+		template<std::output_iterator<SizeType> OutIt>
+		auto Query(const RectFloat& rect, OutIt out) const -> OutIt;
+
+		/// Queries the tree for elements and writes them to the output, e.g., a back inserter to a reused vector.
+		/// 
+		/// \param Point: Point to search for overlapping elements.
+		/// \param Out: Output iterator that the indices are written to.
+		/// 
+		/// \returns Output iterator one past the last written index.
+		/// 
+		template<std::output_iterator<SizeType> OutIt>
+		auto Query(const Vector2f& point, OutIt out) const -> OutIt;
+
 		/// Performs a cleanup of the tree
 		/// 
 		void Cleanup();
@@ -279,16 +336,25 @@ namespace vlx
 	}
 
 	template<std::equality_comparable T>
-	inline auto LQuadTree<T>::Query(const RectFloat& rect) const -> std::vector<SizeType>
+	template<typename Func> requires std::invocable<Func, typename LQuadTree<T>::SizeType, const typename LQuadTree<T>::ValueType&>
+	inline void LQuadTree<T>::Visit(const RectFloat& rect, Func&& func) const
 	{
 		std::shared_lock lock(m_mutex);
+		VisitUnlocked(rect, std::forward<Func>(func));
+	}
 
-		std::vector<SizeType> result;
-		std::vector<SizeType> to_process;
-
-		result.reserve(m_max_elements);
-		to_process.reserve(m_max_depth);
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename LQuadTree<T>::SizeType, const typename LQuadTree<T>::ValueType&>
+	inline void LQuadTree<T>::Visit(const Vector2f& point, Func&& func) const
+	{
+		Visit(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
+	}
 
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename LQuadTree<T>::SizeType, const typename LQuadTree<T>::ValueType&>
+	inline void LQuadTree<T>::VisitUnlocked(const RectFloat& rect, Func&& func) const
+	{
+		SmallVector<SizeType, STACK_SIZE> to_process;
 		to_process.emplace_back(0); // push root
 
 		while (!to_process.empty())
@@ -307,7 +373,7 @@ namespace vlx
 					const auto& elt		= m_elements[elt_ptr.element];
 
 					if (elt.rect.Overlaps(rect))
-						result.emplace_back(elt_ptr.element);
+						func(elt_ptr.element, elt.item);
 
 					child = elt_ptr.next;
 				}
@@ -318,6 +384,22 @@ namespace vlx
 					to_process.emplace_back(node.first_child + i);
 			}
 		}
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename LQuadTree<T>::SizeType, const typename LQuadTree<T>::ValueType&>
+	inline void LQuadTree<T>::VisitUnlocked(const Vector2f& point, Func&& func) const
+	{
+		VisitUnlocked(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
+	}
+
+	template<std::equality_comparable T>
+	inline auto LQuadTree<T>::Query(const RectFloat& rect) const -> std::vector<SizeType>
+	{
+		std::vector<SizeType> result;
+		result.reserve(m_max_elements);
+
+		Query(rect, std::back_inserter(result));
 
 		return result;
 	}
@@ -329,57 +411,49 @@ namespace vlx
 	}
 
 	template<std::equality_comparable T>
-	template<typename Func>
+	template<typename Func> requires std::predicate<Func, const typename LQuadTree<T>::ValueType&>
 	inline auto LQuadTree<T>::Query(const RectFloat& rect, Func&& func) const -> std::vector<SizeType>
 	{
-		std::shared_lock lock(m_mutex);
-
 		std::vector<SizeType> result;
-		std::vector<SizeType> to_process;
-
 		result.reserve(m_max_elements);
-		to_process.reserve(m_max_depth);
-
-		to_process.emplace_back(0); // push root
-
-		while (!to_process.empty())
-		{
-			const Node& node = m_nodes[to_process.back()];
-			to_process.pop_back();
-
-			if (!rect.Overlaps(node.rect))
-				continue;
-
-			if (IsLeaf(node))
-			{
-				for (SizeType child = node.first_child; child != -1;) // iterate over all children
-				{
-					const auto& elt_ptr = m_elements_ptr[child];
-					const auto& elt		= m_elements[elt_ptr.element];
 
-					if (elt.rect.Overlaps(rect) && std::forward<Func>(func)(elt.item))
-						result.emplace_back(elt_ptr.element);
-
-					child = elt_ptr.next;
-				}
-			}
-			else // it's a branch
+		Visit(rect, 
+			[&result, &func](SizeType ei, const ValueType& item)
 			{
-				for (SizeType i = 0; i < CHILD_COUNT; ++i)
-					to_process.emplace_back(node.first_child + i);
-			}
-		}
+				if (func(item))
+					result.emplace_back(ei);
+			});
 
 		return result;
 	}
 
 	template<std::equality_comparable T>
-	template<typename Func>
+	template<typename Func> requires std::predicate<Func, const typename LQuadTree<T>::ValueType&>
 	inline auto LQuadTree<T>::Query(const Vector2f& point, Func&& func) const -> std::vector<SizeType>
 	{
 		return Query(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
 	}
 
+	template<std::equality_comparable T>
+	template<std::output_iterator<typename LQuadTree<T>::SizeType> OutIt>
+	inline auto LQuadTree<T>::Query(const RectFloat& rect, OutIt out) const -> OutIt
+	{
+		Visit(rect, 
+			[&out](SizeType ei, const ValueType&)
+			{
+				*out++ = ei;
+			});
+
+		return out;
+	}
+
+	template<std::equality_comparable T>
+	template<std::output_iterator<typename LQuadTree<T>::SizeType> OutIt>
+	inline auto LQuadTree<T>::Query(const Vector2f& point, OutIt out) const -> OutIt
+	{
+		return Query(RectFloat(point.x, point.y, 0.f, 0.f), std::move(out));
+	}
+
 	template<std::equality_comparable T>
 	inline void LQuadTree<T>::Cleanup()
 	{
@@ -74,6 +74,10 @@ namespace vlx
 		/// 
 		bool Contains(const RectFloat& aabb);
 
+		/// Retrieves the rectangle the element was inserted with, must have been inserted.
+		/// 
+		const RectFloat& GetRect() const;
+
 		/// Retrieves inserted element in the quad tree, will throw if no element has been inserted.
 		/// 
 		const T& Get() const;
@@ -179,6 +183,12 @@ namespace vlx
 		return false;
 	}
 
+	template<std::equality_comparable T>
+	inline const RectFloat& QTElement<T>::GetRect() const
+	{
+		assert(IsInserted());
+		return m_quad_tree->GetRect(m_index);
+	}
 	template<std::equality_comparable T>
 	inline const T& QTElement<T>::Get() const
 	{
@@ -3,16 +3,23 @@
 #include <vector>
 #include <shared_mutex>
 #include <concepts>
+#include <iterator>
+#include <limits>
 
 #include <Velox/System/Rectangle.hpp>
 #include <Velox/System/Vector2.hpp>
 #include <Velox/Config.hpp>
 
 #include <Velox/Structures/FreeVector.hpp>
+#include <Velox/Structures/SmallVector.hpp>
 
 namespace vlx
 {
 	///	Quadtree based upon: https://stackoverflow.com/questions/41946007/efficient-and-well-explained-implementation-of-a-quadtree-for-2d-collision-det
+	/// 
+	/// Elements are stored in every leaf they overlap. Queries report an element only from the leaf that contains 
+	/// the top-left corner of where it overlaps the searched area, so no state is written while querying and 
+	/// any number of threads may query concurrently.
 	///
 	template<std::equality_comparable T = int>
 	class QuadTree
@@ -23,6 +30,7 @@ namespace vlx
 		using SizeType		= int;
 
 		static constexpr int CHILD_COUNT = 4;
+		static constexpr int STACK_SIZE	 = 64; // nodes kept on the stack while traversing before spilling to the heap
 
 	public:
 		struct Element
@@ -45,6 +53,19 @@ namespace vlx
 			SizeType depth {0};
 		};
 
+		struct Region // area of the space partitioned to a node, excludes the minimum and includes the maximum
+		{
+			float min_x {-std::numeric_limits<float>::infinity()};
+			float min_y {-std::numeric_limits<float>::infinity()};
+			float max_x { std::numeric_limits<float>::infinity()};
+			float max_y { std::numeric_limits<float>::infinity()};
+
+			NODISC constexpr bool Contains(float x, float y) const noexcept
+			{
+				return x > min_x && x <= max_x && y > min_y && y <= max_y;
+			}
+		};
+
 		struct ElementPtr
 		{
 			SizeType element {-1};	// points to item in elements, not sure if even needed, seems to always be aligned anyways
@@ -100,6 +121,24 @@ namespace vlx
 		/// 
 		NODISC auto GetRect(SizeType idx) const -> const RectFloat&;
 
+		/// Calls the function once for every element overlapping the rectangle, without allocating any memory. Safe
+		/// to call from several threads at once.
+		/// 
+		/// \param Rect: Rectangle to search for overlapping elements.
+		/// \param Func: Function called as func(index, item) for every overlapping element.
+		/// 
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void Visit(const RectFloat& rect, Func&& func) const;
+
+		/// Calls the function once for every element overlapping the point, without allocating any memory. Safe
+		/// to call from several threads at once.
+		/// 
+		/// \param Point: Point to search for overlapping elements.
+		/// \param Func: Function called as func(index, item) for every overlapping element.
+		/// 
+		template<typename Func> requires std::invocable<Func, SizeType, const ValueType&>
+		void Visit(const Vector2f& point, Func&& func) const;
+
 		/// Queries the tree for elements.
 		/// 
 		/// \param Rect: Bounding rectangle where all the elements are contained.
@@ -116,6 +155,26 @@ namespace vlx
 		/// 
 		NODISC auto Query(const Vector2f& point) const-> std::vector<SizeType>;
 
+		/// Queries the tree for elements and writes them to the output, e.g., a back inserter to a reused vector.
+		/// 
+		/// \param Rect: Bounding rectangle where all the elements are contained.
+		/// \param Out: Output iterator that the indices are written to.
+		/// 
+		/// \returns Output iterator one past the last written index.
+		/// 
+		template<std::output_iterator<SizeType> OutIt>
+		auto Query(const RectFloat& rect, OutIt out) const -> OutIt;
+
+		/// Queries the tree for elements and writes them to the output, e.g., a back inserter to a reused vector.
+		/// 
+		/// \param Point: Point to search for overlapping elements.
+		/// \param Out: Output iterator that the indices are written to.
+		/// 
+		/// \returns Output iterator one past the last written index.
+		/// 
+		template<std::output_iterator<SizeType> OutIt>
+		auto Query(const Vector2f& point, OutIt out) const -> OutIt;
+
 		/// Performs a lazy cleanup of the tree; can only be called if erase has been used.
 		/// 
 		void Cleanup();
@@ -130,6 +189,9 @@ namespace vlx
 
 		auto FindLeaves(const NodeReg& node, const RectFloat& rect) const -> std::vector<NodeReg>;
 
+		template<typename Func>
+		void VisitLeaves(const NodeReg& node, const RectFloat& rect, Func&& func) const;
+
 		static bool IsLeaf(const Node& node);
 		static bool IsBranch(const Node& node);
 
@@ -144,7 +206,6 @@ namespace vlx
 		SizeType	m_max_elements		{8}; // max elements before subdivision
 		SizeType	m_max_depth			{8};  // max depth before no more leaves will be created
 
-		mutable std::vector<bool> m_visited;
 		mutable std::shared_mutex m_mutex;
 	};
 
@@ -248,35 +309,44 @@ namespace vlx
 	}
 
 	template<std::equality_comparable T>
-	inline auto QuadTree<T>::Query(const RectFloat& rect) const -> std::vector<SizeType>
+	template<typename Func> requires std::invocable<Func, typename QuadTree<T>::SizeType, const typename QuadTree<T>::ValueType&>
+	inline void QuadTree<T>::Visit(const RectFloat& rect, Func&& func) const
 	{
 		std::shared_lock lock(m_mutex);
 
-		std::vector<SizeType> result;
+		VisitLeaves({ m_root_rect, 0, 0 }, rect, 
+			[this, &rect, &func](const NodeReg& leaf, const Region& region)
+			{
+				for (auto child = m_nodes[leaf.index].first_child; child != -1;)
+				{
+					const auto elt_idx	= m_elements_ptr[child].element;
+					const auto& elt		= m_elements[elt_idx];
 
-		m_visited.resize(m_elements.size());
+					// the element may be in several of the visited leaves, only the one owning the corner reports it
 
-		for (const NodeReg& leaf : FindLeaves({ m_root_rect, 0, 0 }, rect))
-		{
-			const auto nd_index = leaf.index;
-			
-			for (auto child = m_nodes[nd_index].first_child; child != -1;)
-			{
-				const auto elt_idx	= m_elements_ptr[child].element;
-				const auto& elt		= m_elements[elt_idx];
+					if (elt.rect.Overlaps(rect) && region.Contains(
+						std::max(elt.rect.left, rect.left), std::max(elt.rect.top, rect.top)))
+					{
+						func(elt_idx, elt.item);
+					}
 
-				if (!m_visited[elt_idx] && elt.rect.Overlaps(rect))
-				{
-					result.emplace_back(elt_idx);
-					m_visited[elt_idx] = true;
+					child = m_elements_ptr[child].next;
 				}
+			});
+	}
 
-				child = m_elements_ptr[child].next;
-			}
-		}
+	template<std::equality_comparable T>
+	template<typename Func> requires std::invocable<Func, typename QuadTree<T>::SizeType, const typename QuadTree<T>::ValueType&>
+	inline void QuadTree<T>::Visit(const Vector2f& point, Func&& func) const
+	{
+		Visit(RectFloat(point.x, point.y, 0.f, 0.f), std::forward<Func>(func));
+	}
 
-		for (const auto elt_idx : result)
-			m_visited[elt_idx] = false;
+	template<std::equality_comparable T>
+	inline auto QuadTree<T>::Query(const RectFloat& rect) const -> std::vector<SizeType>
+	{
+		std::vector<SizeType> result;
+		Query(rect, std::back_inserter(result));
 
 		return result;
 	}
@@ -287,6 +357,26 @@ namespace vlx
 		return Query(RectFloat(point.x, point.y, 0.f, 0.f));
 	}
 
+	template<std::equality_comparable T>
+	template<std::output_iterator<typename QuadTree<T>::SizeType> OutIt>
+	inline auto QuadTree<T>::Query(const RectFloat& rect, OutIt out) const -> OutIt
+	{
+		Visit(rect, 
+			[&out](SizeType elt_idx, const ValueType&)
+			{
+				*out++ = elt_idx;
+			});
+
+		return out;
+	}
+
+	template<std::equality_comparable T>
+	template<std::output_iterator<typename QuadTree<T>::SizeType> OutIt>
+	inline auto QuadTree<T>::Query(const Vector2f& point, OutIt out) const -> OutIt
+	{
+		return Query(RectFloat(point.x, point.y, 0.f, 0.f), std::move(out));
+	}
+
 	template<std::equality_comparable T>
 	inline void QuadTree<T>::Cleanup()
 	{
@@ -372,8 +462,10 @@ namespace vlx
 			m_nodes.emplace();
 			m_nodes.emplace();
 
-			node.first_child = fc;
-			node.count = -1; // set as branch
+			Node& branch = m_nodes[nr.index]; // emplacing may have reallocated the nodes
+
+			branch.first_child = fc;
+			branch.count = -1; // set as branch
 
 			for (const auto elt : elements)
 				NodeInsert(nr, elt);
@@ -386,17 +478,35 @@ namespace vlx
 	inline auto QuadTree<T>::FindLeaves(const NodeReg& nr, const RectFloat& rect) const -> std::vector<NodeReg>
 	{
 		std::vector<NodeReg> leaves;
-		std::vector<NodeReg> to_process;
+		VisitLeaves(nr, rect, 
+			[&leaves](const NodeReg& leaf, const Region&)
+			{
+				leaves.emplace_back(leaf);
+			});
+
+		return leaves;
+	}
 
-		to_process.emplace_back(nr);
+	template<std::equality_comparable T>
+	template<typename Func>
+	inline void QuadTree<T>::VisitLeaves(const NodeReg& nr, const RectFloat& rect, Func&& func) const
+	{
+		struct RegionReg
+		{
+			NodeReg node;
+			Region	region;
+		};
+
+		SmallVector<RegionReg, STACK_SIZE> to_process;
+		to_process.emplace_back(nr, Region{});
 
 		while (!to_process.empty())
 		{
-			const NodeReg nd = to_process.back();
+			const auto [nd, rg] = to_process.back();
 			to_process.pop_back();
 
 			if (IsLeaf(m_nodes[nd.index]))
-				leaves.emplace_back(nd);
+				func(nd, rg);
 			else
 			{
 				const auto fc	= m_nodes[nd.index].first_child;
@@ -407,24 +517,25 @@ namespace vlx
 				const auto r	= nd.rect.left + hx;
 				const auto b	= nd.rect.top + hy;
 
+				const Region rt { rg.min_x, rg.min_y, rg.max_x, nd.rect.top };
+				const Region rb { rg.min_x, nd.rect.top, rg.max_x, rg.max_y };
+
 				if (rect.top <= nd.rect.top)
 				{
 					if (rect.left <= nd.rect.left)
-						to_process.emplace_back(RectFloat(l, t, hx, hy), fc + 0, nd.depth + 1);
+						to_process.emplace_back(NodeReg(RectFloat(l, t, hx, hy), fc + 0, nd.depth + 1), Region(rt.min_x, rt.min_y, nd.rect.left, rt.max_y));
 					if (rect.Right() > nd.rect.left)
-						to_process.emplace_back(RectFloat(r, t, hx, hy), fc + 1, nd.depth + 1);
+						to_process.emplace_back(NodeReg(RectFloat(r, t, hx, hy), fc + 1, nd.depth + 1), Region(nd.rect.left, rt.min_y, rt.max_x, rt.max_y));
 				}
 				if (rect.Bottom() > nd.rect.top)
 				{
 					if (rect.left <= nd.rect.left)
-						to_process.emplace_back(RectFloat(l, b, hx, hy), fc + 2, nd.depth + 1);
+						to_process.emplace_back(NodeReg(RectFloat(l, b, hx, hy), fc + 2, nd.depth + 1), Region(rb.min_x, rb.min_y, nd.rect.left, rb.max_y));
 					if (rect.Right() > nd.rect.left)
-						to_process.emplace_back(RectFloat(r, b, hx, hy), fc + 3, nd.depth + 1);
+						to_process.emplace_back(NodeReg(RectFloat(r, b, hx, hy), fc + 3, nd.depth + 1), Region(nd.rect.left, rb.min_y, rb.max_x, rb.max_y));
 				}
 			}
 		}
-
-		return leaves;
 	}
 
 	template<std::equality_comparable T>
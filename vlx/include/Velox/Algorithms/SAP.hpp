@@ -1 +1,541 @@
 #pragma once
+
+#include <vector>
+#include <array>
+#include <unordered_set>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include <Velox/System/Rectangle.hpp>
+#include <Velox/Utility/ContainerUtils.h>
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+namespace vlx
+{
+	///	Incremental sweep and prune that keeps the endpoints of every rectangle sorted along both axes between
+	/// sweeps. Since items usually move little from one sweep to the next, the endpoints are nearly sorted and
+	/// insertion sort only has to perform a few swaps. Every swap between the start of one rectangle and the end
+	/// of another is where two rectangles start or stop overlapping, so the set of overlapping pairs is kept
+	/// up to date without querying.
+	///
+	/// Performs best when most items move slowly, and degrades when many items move far or cluster along both axes.
+	///
+	template<std::equality_comparable T = int>
+	class SAP
+	{
+	public:
+		using ElementType	= T;
+		using ValueType		= std::remove_const_t<T>;
+		using SizeType		= int;
+
+		static constexpr SizeType NULL_PROXY = -1;
+
+		struct Pair
+		{
+			SizeType first	{NULL_PROXY}; // always the lower of the two proxies
+			SizeType second	{NULL_PROXY};
+
+			NODISC constexpr bool operator==(const Pair& rhs) const = default;
+		};
+
+	private:
+		struct Box
+		{
+			RectFloat				rect;
+			ValueType				item		{};
+			std::vector<SizeType>	pairs;					// proxies currently overlapping this one
+			SizeType				next_free	{NULL_PROXY};
+			bool					alive		{false};
+			bool					swept		{false};	// endpoints have been sorted into the axes
+		};
+
+		struct Endpoint
+		{
+			float		value	{0.0f};
+			SizeType	proxy	{NULL_PROXY};
+			bool		is_min	{false};
+		};
+
+		using Axis = std::vector<Endpoint>;
+
+	public:
+		SAP() = default;
+
+	public:
+		/// Inserts an item, its overlaps are found on the next sweep.
+		///
+		/// \param Rect: Rectangle encompassing the item.
+		/// \param Item: Item to insert.
+		///
+		/// \returns Proxy to the item, can be used to directly access it when, e.g., erasing it.
+		///
+		auto Insert(const RectFloat& rect, const T& item) -> SizeType;
+
+		/// Emplace constructs an item, its overlaps are found on the next sweep.
+		///
+		/// \param Rect: Rectangle encompassing the item.
+		/// \param Args: Constructor arguments for the item.
+		///
+		/// \returns Proxy to the item, can be used to directly access it when, e.g., erasing it.
+		///
+		template<typename... Args> requires std::constructible_from<T, Args...>
+		auto Emplace(const RectFloat& rect, Args&&... args) -> SizeType;
+
+		/// Erases an item, pairs containing it are reported as removed by the next sweep.
+		///
+		/// \param Proxy: Proxy to the item to erase.
+		///
+		/// \returns True if successfully removed the item, otherwise false.
+		///
+		bool Erase(SizeType proxy);
+
+		/// Sets the rectangle of the item, the overlaps are updated on the next sweep.
+		///
+		/// \param Proxy: Proxy to the item to move.
+		/// \param Rect: New rectangle encompassing the item.
+		///
+		void Move(SizeType proxy, const RectFloat& rect);
+
+		/// Updates the given item with new data.
+		///
+		/// \param Proxy: Proxy to the item.
+		/// \param Args: Data to update the current item.
+		///
+		/// \returns True if successfully updated the item, otherwise false.
+		///
+		template<typename... Args> requires std::constructible_from<T, Args...>
+		bool Update(SizeType proxy, Args&&... args);
+
+		/// Re-sorts the endpoints and updates the overlapping pairs. The pairs added and removed are replaced by
+		/// those found during this sweep.
+		///
+		void Sweep();
+
+		NODISC auto Get(SizeType proxy) -> ValueType&;
+		NODISC auto Get(SizeType proxy) const -> const ValueType&;
+
+		NODISC auto GetRect(SizeType proxy) const -> const RectFloat&;
+
+		/// Calls the function with the proxy of every item overlapping the rectangle. Only the items starting between
+		/// the widest item and the end of the rectangle along the sorted x-axis are checked, so a few wide items make
+		/// every search slower. Items moved since the last sweep are searched for where they were at the sweep.
+		///
+		/// \param Rect: Rectangle to search for overlapping items.
+		/// \param Func: Function called as func(proxy, item).
+		///
+		template<typename Func>
+		void Visit(const RectFloat& rect, Func&& func) const;
+
+		/// \returns All pairs of items that overlapped as of the last sweep, sorted by their proxies.
+		///
+		NODISC auto GetPairs() const noexcept -> const std::vector<Pair>&;
+
+		/// \returns Pairs that started overlapping since the previous sweep, sorted by their proxies.
+		///
+		NODISC auto GetAddedPairs() const noexcept -> const std::vector<Pair>&;
+
+		/// \returns Pairs that stopped overlapping since the previous sweep. Pairs of erased items come first,
+		///		     followed by those found by the sweep, both sorted by their proxies.
+		///
+		NODISC auto GetRemovedPairs() const noexcept -> const std::vector<Pair>&;
+
+		/// Clears all of the items and pairs.
+		///
+		void Clear();
+
+	private:
+		void SortAxis(Axis& axis);
+
+		void AddPair(SizeType lhs, SizeType rhs);
+		void RemovePair(SizeType lhs, SizeType rhs);
+
+		void AppendPairs(std::vector<Pair>& pairs, const std::unordered_set<uint64>& keys);
+
+		NODISC bool IsValid(SizeType proxy) const;
+
+		static constexpr uint64 GetKey(SizeType lhs, SizeType rhs);
+		static constexpr Pair GetPair(uint64 key);
+
+		static constexpr bool IsBelow(const Endpoint& lhs, const Endpoint& rhs);
+
+	private:
+		std::vector<Box>				m_boxes;
+		std::array<Axis, 2>				m_axes;			// sorted endpoints along x and y
+		std::unordered_set<uint64>		m_pair_set;		// keys of the overlapping pairs
+		std::unordered_set<uint64>		m_added_keys;	// pairs that started overlapping during the current sweep
+		std::unordered_set<uint64>		m_removed_keys;	// pairs that stopped overlapping during the current sweep
+		std::vector<uint64>				m_keys;			// scratch for sorting the keys
+
+		std::vector<Pair>				m_pairs;
+		std::vector<Pair>				m_added;
+		std::vector<Pair>				m_removed;
+		std::vector<Pair>				m_erased;		// pairs removed through erasing since the last sweep
+
+		SizeType						m_free		{NULL_PROXY};
+		std::size_t						m_unsorted	{0};	// endpoints appended to every axis since the last sweep
+		float							m_max_width	{0.0f};	// widest item along x as of the last sweep
+		bool							m_dirty		{false}; // pairs have to be rebuilt from the set
+	};
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::Insert(const RectFloat& rect, const T& item) -> SizeType
+	{
+		return Emplace(rect, item);
+	}
+
+	template<std::equality_comparable T>
+	template<typename... Args> requires std::constructible_from<T, Args...>
+	inline auto SAP<T>::Emplace(const RectFloat& rect, Args&&... args) -> SizeType
+	{
+		SizeType proxy = m_free;
+
+		if (proxy != NULL_PROXY)
+			m_free = m_boxes[proxy].next_free;
+		else
+		{
+			proxy = static_cast<SizeType>(m_boxes.size());
+			m_boxes.emplace_back();
+		}
+
+		Box& box = m_boxes[proxy];
+
+		box.rect		= rect;
+		box.item		= T(std::forward<Args>(args)...);
+		box.next_free	= NULL_PROXY;
+		box.alive		= true;
+		box.swept		= false;
+
+		m_unsorted += 2;
+
+		// endpoints are appended at the end, the next sweep moves them into place and finds the overlaps on the way
+
+		for (Axis& axis : m_axes)
+		{
+			axis.emplace_back(0.0f, proxy, true);
+			axis.emplace_back(0.0f, proxy, false);
+		}
+
+		return proxy;
+	}
+
+	template<std::equality_comparable T>
+	inline bool SAP<T>::Erase(SizeType proxy)
+	{
+		if (!IsValid(proxy))
+			return false;
+
+		for (Axis& axis : m_axes)
+		{
+			std::erase_if(axis,
+				[proxy](const Endpoint& endpoint)
+				{
+					return endpoint.proxy == proxy;
+				});
+		}
+
+		Box& box = m_boxes[proxy];
+
+		for (const SizeType other : box.pairs) // only visit the pairs of this item instead of every pair
+		{
+			const uint64 key = GetKey(proxy, other);
+
+			m_pair_set.erase(key);
+			m_erased.emplace_back(GetPair(key));
+
+			cu::SwapPop(m_boxes[other].pairs, proxy);
+
+			m_dirty = true;
+		}
+
+		box.pairs.clear();
+
+		if (!box.swept)
+			m_unsorted -= 2;
+
+		box.alive		= false;
+		box.next_free	= m_free;
+
+		m_free = proxy;
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::Move(SizeType proxy, const RectFloat& rect)
+	{
+		assert(IsValid(proxy));
+		m_boxes[proxy].rect = rect;
+	}
+
+	template<std::equality_comparable T>
+	template<typename... Args> requires std::constructible_from<T, Args...>
+	inline bool SAP<T>::Update(SizeType proxy, Args&&... args)
+	{
+		if (!IsValid(proxy))
+			return false;
+
+		m_boxes[proxy].item = T(std::forward<Args>(args)...);
+
+		return true;
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::Sweep()
+	{
+		m_added.clear();
+		m_removed.clear();
+
+		std::swap(m_removed, m_erased);
+		std::ranges::sort(m_removed, {}, [](const Pair& pair) { return GetKey(pair.first, pair.second); });
+
+		for (std::size_t i = 0; i < m_axes.size(); ++i)
+		{
+			for (Endpoint& endpoint : m_axes[i]) // refresh the values to match the current rectangles
+			{
+				const RectFloat& rect = m_boxes[endpoint.proxy].rect;
+
+				const float lower = (i == 0) ? rect.left : rect.top;
+				const float upper = (i == 0) ? rect.Right() : rect.Bottom();
+
+				endpoint.value = endpoint.is_min ? std::min(lower, upper) : std::max(lower, upper);
+			}
+
+			SortAxis(m_axes[i]);
+		}
+
+		m_unsorted	= 0;
+		m_max_width	= 0.0f;
+
+		for (Box& box : m_boxes)
+		{
+			if (!box.alive)
+				continue;
+
+			box.swept	= true;
+			m_max_width	= std::max(m_max_width, std::abs(box.rect.width));
+		}
+
+		AppendPairs(m_added, m_added_keys); // sorted to keep the order independent of the hashing
+		AppendPairs(m_removed, m_removed_keys);
+
+		m_added_keys.clear();
+		m_removed_keys.clear();
+
+		if (m_dirty)
+		{
+			m_pairs.clear();
+			AppendPairs(m_pairs, m_pair_set);
+
+			m_dirty = false;
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::Get(SizeType proxy) -> ValueType&
+	{
+		assert(IsValid(proxy));
+		return m_boxes[proxy].item;
+	}
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::Get(SizeType proxy) const -> const ValueType&
+	{
+		assert(IsValid(proxy));
+		return m_boxes[proxy].item;
+	}
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::GetRect(SizeType proxy) const -> const RectFloat&
+	{
+		assert(IsValid(proxy));
+		return m_boxes[proxy].rect;
+	}
+
+	template<std::equality_comparable T>
+	template<typename Func>
+	inline void SAP<T>::Visit(const RectFloat& rect, Func&& func) const
+	{
+		const float left	= std::min(rect.left, rect.Right());
+		const float right	= std::max(rect.left, rect.Right());
+
+		const Axis& axis = m_axes[0];
+		const auto sorted_end = axis.end() - m_unsorted;
+
+		const auto VisitEndpoint = [this, &rect, &func](const Endpoint& endpoint)
+		{
+			if (!endpoint.is_min) // every item is visited from its start
+				return;
+
+			const Box& box = m_boxes[endpoint.proxy];
+
+			if (box.rect.Overlaps(rect))
+				func(endpoint.proxy, box.item);
+		};
+
+		// items overlapping the rectangle have to start after its left side minus the widest item
+
+		auto it = std::lower_bound(axis.begin(), sorted_end, left - m_max_width,
+			[](const Endpoint& endpoint, float value)
+			{
+				return endpoint.value < value;
+			});
+
+		for (; it != sorted_end && it->value <= right; ++it)
+			VisitEndpoint(*it);
+
+		for (it = sorted_end; it != axis.end(); ++it) // appended since the last sweep and not yet sorted
+			VisitEndpoint(*it);
+	}
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::GetPairs() const noexcept -> const std::vector<Pair>&
+	{
+		return m_pairs;
+	}
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::GetAddedPairs() const noexcept -> const std::vector<Pair>&
+	{
+		return m_added;
+	}
+
+	template<std::equality_comparable T>
+	inline auto SAP<T>::GetRemovedPairs() const noexcept -> const std::vector<Pair>&
+	{
+		return m_removed;
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::Clear()
+	{
+		m_boxes.clear();
+
+		for (Axis& axis : m_axes)
+			axis.clear();
+
+		m_pair_set.clear();
+		m_added_keys.clear();
+		m_removed_keys.clear();
+
+		m_pairs.clear();
+		m_added.clear();
+		m_removed.clear();
+		m_erased.clear();
+
+		m_free		= NULL_PROXY;
+		m_unsorted	= 0;
+		m_max_width	= 0.0f;
+		m_dirty		= false;
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::SortAxis(Axis& axis)
+	{
+		for (std::size_t i = 1; i < axis.size(); ++i)
+		{
+			const Endpoint key = axis[i];
+
+			std::size_t j = i;
+			while (j > 0 && IsBelow(key, axis[j - 1]))
+			{
+				const Endpoint& other = axis[j - 1]; // the key moves below this endpoint
+
+				if (key.proxy != other.proxy)
+				{
+					if (key.is_min && !other.is_min) // start now lies below the other end, they may overlap
+					{
+						if (m_boxes[key.proxy].rect.Overlaps(m_boxes[other.proxy].rect))
+							AddPair(key.proxy, other.proxy);
+					}
+					else if (!key.is_min && other.is_min) // end now lies below the other start, they are separated
+					{
+						RemovePair(key.proxy, other.proxy);
+					}
+				}
+
+				axis[j] = other;
+				--j;
+			}
+
+			axis[j] = key;
+		}
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::AddPair(SizeType lhs, SizeType rhs)
+	{
+		const uint64 key = GetKey(lhs, rhs);
+
+		if (!m_pair_set.emplace(key).second) // already overlapping, e.g., found on the other axis
+			return;
+
+		m_boxes[lhs].pairs.emplace_back(rhs);
+		m_boxes[rhs].pairs.emplace_back(lhs);
+
+		if (m_removed_keys.erase(key) == 0) // stopped and started again, cancel out
+			m_added_keys.emplace(key);
+
+		m_dirty = true;
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::RemovePair(SizeType lhs, SizeType rhs)
+	{
+		const uint64 key = GetKey(lhs, rhs);
+
+		if (m_pair_set.erase(key) == 0)
+			return;
+
+		cu::SwapPop(m_boxes[lhs].pairs, rhs);
+		cu::SwapPop(m_boxes[rhs].pairs, lhs);
+
+		if (m_added_keys.erase(key) == 0) // started and stopped again, cancel out
+			m_removed_keys.emplace(key);
+
+		m_dirty = true;
+	}
+
+	template<std::equality_comparable T>
+	inline void SAP<T>::AppendPairs(std::vector<Pair>& pairs, const std::unordered_set<uint64>& keys)
+	{
+		m_keys.assign(keys.begin(), keys.end());
+		std::ranges::sort(m_keys); // the lower proxy is in the upper bits, so this sorts by the proxies
+
+		pairs.reserve(pairs.size() + m_keys.size());
+		for (const uint64 key : m_keys)
+			pairs.emplace_back(GetPair(key));
+	}
+
+	template<std::equality_comparable T>
+	inline bool SAP<T>::IsValid(SizeType proxy) const
+	{
+		return proxy >= 0 && proxy < static_cast<SizeType>(m_boxes.size()) && m_boxes[proxy].alive;
+	}
+
+	template<std::equality_comparable T>
+	inline constexpr uint64 SAP<T>::GetKey(SizeType lhs, SizeType rhs)
+	{
+		const auto [min, max] = std::minmax(lhs, rhs);
+		return (static_cast<uint64>(min) << 32) | static_cast<uint64>(static_cast<uint32>(max));
+	}
+
+	template<std::equality_comparable T>
+	inline constexpr auto SAP<T>::GetPair(uint64 key) -> Pair
+	{
+		return Pair{ static_cast<SizeType>(key >> 32), static_cast<SizeType>(key & 0xFFFFFFFF) };
+	}
+
+	template<std::equality_comparable T>
+	inline constexpr bool SAP<T>::IsBelow(const Endpoint& lhs, const Endpoint& rhs)
+	{
+		// at equal values starts are placed before ends so that touching rectangles count as overlapping, same as Rect::Overlaps
+
+		if (lhs.value != rhs.value)
+			return lhs.value < rhs.value;
+
+		return lhs.is_min && !rhs.is_min;
+	}
+}
\ No newline at end of file
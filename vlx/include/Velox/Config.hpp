@@ -23,6 +23,14 @@
 #	define VELOX_DEBUG 1
 #endif
 
+#if !defined(VELOX_PROFILE)
+#	define VELOX_PROFILE 1 // compiles in the profiler zones, recording still has to be enabled at runtime
+#endif
+
+#if !defined(VELOX_DETERMINISTIC)
+#	define VELOX_DETERMINISTIC 0 // strict floating point build, set through the VeloxDeterministic msbuild property
+#endif
+
 #if defined(_MSC_VER)
 #   define VELOX_PRETTY_FUNCTION __FUNCSIG__
 #elif defined(__clang__) || defined(__GNUC__)
@@ -3,8 +3,13 @@
 #include <memory>
 #include <vector>
 #include <unordered_map>
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <atomic>
 
 #include <Velox/Structures/SmallVector.hpp>
+#include <Velox/Config.hpp>
 
 #include "Identifiers.hpp"
 
@@ -12,6 +17,8 @@ namespace vlx
 {
 	using ComponentData = std::unique_ptr<ByteArray>;
 
+	inline constexpr std::size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024; // preferred size in bytes of a chunk
+
 	class Archetype;
 
 	struct ArchetypeEdge
@@ -29,9 +36,91 @@ namespace vlx
 		ArchetypeID					id {NULL_ARCHETYPE};
 		ComponentIDs				type;					// all the component ids
 		std::vector<EntityID>		entities;				// all the entities registered to this archetype
-		std::vector<ComponentData>	component_data;			// all the components data in this archetype stored by type
-		std::vector<uint64>			component_data_size;	// total collective size in bytes of all components stored by type
+		std::vector<ComponentData>	chunks;					// fixed blocks of memory, each storing the components of chunk_capacity entities by type
+		std::vector<uint32>			column_offsets;			// offset in bytes from the start of a chunk to the array of each component
+		std::vector<uint32>			column_sizes;			// size in bytes of each component
+		std::size_t					chunk_capacity	{1};	// number of entities that fit in a chunk
+		std::size_t					chunk_size		{0};	// size in bytes of a chunk
+
+		mutable std::vector<uint32>	versions;				// tick of the last write to each column of every chunk, laid out per chunk
 
 		EdgesMap edges; // what set of component ids leads to which neighbouring archetype
+
+	public:
+		static constexpr std::size_t NULL_COLUMN = std::numeric_limits<std::size_t>::max();
+
+	public:
+		///	\returns Column of the component in the archetype, NULL_COLUMN if it does not exist
+		///
+		NODISC std::size_t FindColumn(ComponentTypeID component_id) const noexcept
+		{
+			const auto it = std::ranges::lower_bound(type, component_id); // type is always sorted and small, faster than a hash lookup
+			return (it != type.end() && *it == component_id) ? static_cast<std::size_t>(it - type.begin()) : NULL_COLUMN;
+		}
+
+		///	\returns Number of entities that can be stored without allocating another chunk
+		///
+		NODISC std::size_t GetCapacity() const noexcept
+		{
+			return chunks.size() * chunk_capacity;
+		}
+
+		///	\returns Number of chunks that contain at least one entity
+		///
+		NODISC std::size_t GetChunkCount() const noexcept
+		{
+			return (entities.size() + chunk_capacity - 1) / chunk_capacity;
+		}
+
+		///	\returns Number of entities stored in the chunk
+		///
+		NODISC std::size_t GetChunkEntityCount(std::size_t chunk) const noexcept
+		{
+			return std::min(entities.size() - chunk * chunk_capacity, chunk_capacity);
+		}
+
+		///	\returns Pointer to the start of the array of components in the chunk
+		///
+		NODISC DataPtr GetColumn(std::size_t chunk, std::size_t column) const
+		{
+			return &chunks[chunk][column_offsets[column]];
+		}
+
+		///	\returns Pointer to the component of the entity located at index
+		///
+		NODISC DataPtr GetData(std::size_t column, std::size_t index) const
+		{
+			return GetColumn(index / chunk_capacity, column) + (index % chunk_capacity) * column_sizes[column];
+		}
+
+		///	\returns Tick of the last write to the column in the chunk
+		///
+		NODISC uint32 GetVersion(std::size_t chunk, std::size_t column) const
+		{
+			return std::atomic_ref(versions[chunk * type.size() + column]).load(std::memory_order_relaxed);
+		}
+
+		///	\returns True if the column in the chunk has been written to after the tick
+		///
+		NODISC bool IsChanged(std::size_t chunk, std::size_t column, uint32 tick) const
+		{
+			return static_cast<int32>(GetVersion(chunk, column) - tick) > 0; // remains correct when the tick wraps around
+		}
+
+		///	Marks the column in the chunk as written to at tick, systems running in parallel may do this concurrently.
+		///
+		void MarkChanged(std::size_t chunk, std::size_t column, uint32 tick) const
+		{
+			std::atomic_ref(versions[chunk * type.size() + column]).store(tick, std::memory_order_relaxed);
+		}
+
+		///	Marks every column in the chunk that holds the entity at index as written to at tick.
+		///
+		void MarkEntityChanged(std::size_t index, uint32 tick) const
+		{
+			const std::size_t chunk = index / chunk_capacity;
+			for (std::size_t i = 0; i < type.size(); ++i)
+				MarkChanged(chunk, i, tick);
+		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <Velox/Config.hpp>
+
+#include "Identifiers.hpp"
+#include "Archetype.hpp"
+
+namespace vlx
+{
+	/// Set of archetypes that contain all of the included components and none of the excluded ones. Queries are
+	/// owned by the EntityAdmin and are kept up to date as new archetypes are created, so iterating over them
+	/// requires no matching.
+	///
+	struct ArchetypeQuery
+	{
+		ComponentIDs			include;	// sorted ids of the components an archetype is required to have
+		ComponentIDs			exclude;	// sorted ids of the components an archetype is not allowed to have
+		std::vector<Archetype*>	archetypes;	// currently matching archetypes, in order of creation
+
+		/// \returns True if the archetype should be part of the query
+		///
+		NODISC bool IsMatch(const Archetype& archetype) const
+		{
+			if (!std::ranges::includes(archetype.type, include))
+				return false;
+
+			return std::ranges::none_of(exclude,
+				[&archetype](const ComponentTypeID component_id)
+				{
+					return std::ranges::binary_search(archetype.type, component_id);
+				});
+		}
+	};
+}
\ No newline at end of file
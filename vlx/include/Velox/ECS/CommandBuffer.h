@@ -0,0 +1,153 @@
+#pragma once
+
+#include <vector>
+#include <span>
+#include <tuple>
+#include <cassert>
+
+#include <Velox/Structures/LinearArena.hpp>
+#include <Velox/System/ThreadPool.h>
+#include <Velox/Utility/ContainerUtils.h>
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+#include "Identifiers.hpp"
+
+namespace vlx
+{
+	class EntityAdmin;
+
+	///	Records structural changes to be applied later on, when the components memory may be modified. Every thread
+	/// records into its own buffer, making it safe to record from inside of systems that are run in parallel without
+	/// any locking. Only the threads of the admin's pool and the thread that owns the admin may record.
+	///
+	/// On execution, the commands of all threads are merged and played back in rounds, where every round holds at most
+	/// one command per entity, taken in the order they were recorded. Within a round, the commands are sorted by type,
+	/// archetype and entity. This makes the playback independent of which thread recorded what and lets entities 
+	/// receiving the same change be migrated together, while the changes to a single entity keep their order.
+	///
+	class CommandBuffer
+	{
+	private:
+		enum class CommandType : uint8
+		{
+			AddComponents,
+			RemoveComponents,
+			RemoveEntity
+		};
+
+		struct Command
+		{
+			const ComponentTypeID*	component_ids	{nullptr}; // static storage or the arena of the recording thread
+			ArchetypeID				archetype_id	{NULL_ARCHETYPE};
+			EntityID				entity_id		{NULL_ENTITY};
+			uint32					component_count	{0};
+			CommandType				type			{CommandType::RemoveEntity};
+			uint32					round			{0}; // number of commands recorded for the entity before this one
+		};
+
+		struct alignas(64) ThreadBuffer // aligned to avoid threads sharing cache lines
+		{
+			std::vector<Command>	commands;
+			LinearArena				arena;
+		};
+
+	public:
+		///	\param ThreadCount: Number of threads that may record, usually the thread count of the pool of the admin
+		///
+		VELOX_API explicit CommandBuffer(std::size_t thread_count);
+
+	public:
+		///	\returns True if no commands have been recorded
+		///
+		NODISC VELOX_API bool IsEmpty() const noexcept;
+
+		///	\returns Total number of recorded commands
+		///
+		NODISC VELOX_API std::size_t GetSize() const noexcept;
+
+	public:
+		template<IsComponent C>
+		void AddComponent(EntityID entity_id);
+
+		template<class... Cs> requires IsComponents<Cs...>
+		void AddComponents(EntityID entity_id);
+
+		template<IsComponent C>
+		void RemoveComponent(EntityID entity_id);
+
+		template<class... Cs> requires IsComponents<Cs...>
+		void RemoveComponents(EntityID entity_id);
+
+		///	Records adding the components to the entity, the component ids are copied into the arena of the thread.
+		///
+		/// \param ComponentIDs: Sorted IDs of the components
+		/// \param ArchetypeID: Combined hash of the component IDs
+		///
+		VELOX_API void AddComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id);
+
+		///	Records removing the components from the entity, the component ids are copied into the arena of the thread.
+		///
+		/// \param ComponentIDs: Sorted IDs of the components
+		/// \param ArchetypeID: Combined hash of the component IDs
+		///
+		VELOX_API void RemoveComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id);
+
+		VELOX_API void RemoveEntity(EntityID entity_id);
+
+	public:
+		///	Plays back all of the recorded commands in sorted order and clears the buffer. Commands recorded during the
+		/// playback, e.g., by listeners, are played back afterwards. Has to be called when the components memory is not 
+		/// locked, i.e., not while systems are running.
+		///
+		VELOX_API void Execute(EntityAdmin& entity_admin);
+
+		///	Discards all of the recorded commands, the memory is kept for reuse.
+		///
+		VELOX_API void Clear();
+
+	private:
+		NODISC VELOX_API ThreadBuffer& GetThreadBuffer();
+
+		VELOX_API void Record(CommandType type, EntityID entity_id, std::span<const ComponentTypeID> component_ids, ArchetypeID archetype_id, bool copy);
+
+		VELOX_API void Sort();
+		VELOX_API void Play(EntityAdmin& entity_admin);
+
+	private:
+		std::vector<ThreadBuffer>	m_buffers;	// one buffer per thread, indexed by the thread index of the pool
+		std::vector<ThreadBuffer>	m_playback;	// buffers being played back, swapped with the recording ones
+		std::vector<Command>		m_sorted;	// merged commands, kept to reuse its memory
+		std::vector<EntityID>		m_entities;	// entities of the current batch
+	};
+
+	template<IsComponent C>
+	inline void CommandBuffer::AddComponent(EntityID entity_id)
+	{
+		AddComponents<C>(entity_id);
+	}
+
+	template<class... Cs> requires IsComponents<Cs...>
+	inline void CommandBuffer::AddComponents(EntityID entity_id)
+	{
+		static constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ id::Type<Cs>::ID()... });
+		static constexpr auto archetype_id	= cu::ContainerHash<ComponentTypeID>()(component_ids);
+
+		Record(CommandType::AddComponents, entity_id, component_ids, archetype_id, false); // ids have static storage, no need to copy
+	}
+
+	template<IsComponent C>
+	inline void CommandBuffer::RemoveComponent(EntityID entity_id)
+	{
+		RemoveComponents<C>(entity_id);
+	}
+
+	template<class... Cs> requires IsComponents<Cs...>
+	inline void CommandBuffer::RemoveComponents(EntityID entity_id)
+	{
+		static constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ id::Type<Cs>::ID()... });
+		static constexpr auto archetype_id	= cu::ContainerHash<ComponentTypeID>()(component_ids);
+
+		Record(CommandType::RemoveComponents, entity_id, component_ids, archetype_id, false);
+	}
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 #include <Velox/System/Concepts.h>
 #include <Velox/Config.hpp>
 
@@ -21,6 +23,7 @@ namespace vlx
 		void Shutdown(			const EntityAdmin& entity_admin, EntityID entity_id, DataPtr data) const override;
 
 		NODISC constexpr std::size_t GetSize() const noexcept override;
+		NODISC constexpr bool IsTriviallyRelocatable() const noexcept override;
 
 		NODISC static constexpr ComponentTypeID GetTypeID() noexcept;
 	};
@@ -125,6 +128,12 @@ namespace vlx
 		return sizeof(C);
 	}
 
+	template<IsComponent C>
+	inline constexpr bool ComponentAlloc<C>::IsTriviallyRelocatable() const noexcept
+	{
+		return std::is_trivially_copyable_v<C> && !HasEvent<C, MovedEvent>; // can be moved by copying its bytes
+	}
+
 	template<IsComponent C>
 	inline constexpr ComponentTypeID ComponentAlloc<C>::GetTypeID() noexcept
 	{
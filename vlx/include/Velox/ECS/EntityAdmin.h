@@ -7,10 +7,14 @@
 #include <optional>
 #include <cassert>
 #include <tuple>
+#include <cstring>
+#include <utility>
+#include <algorithm>
 
 #include <Velox/System/Event.hpp>
 #include <Velox/System/EventID.h>
 #include <Velox/System/IDGenerator.h>
+#include <Velox/System/ThreadPool.h>
 #include <Velox/Utility/NonCopyable.h>
 #include <Velox/Utility/ContainerUtils.h>
 #include <Velox/Types.hpp>
@@ -20,6 +24,7 @@
 #include "ComponentRef.hpp"
 #include "ComponentSet.hpp"
 #include "Archetype.hpp"
+#include "ArchetypeQuery.hpp"
 #include "SystemBase.h"
 #include "ComponentEvents.h"
 #include "IComponentAlloc.hpp"
@@ -38,7 +43,8 @@ namespace vlx
 	// 
 	////////////////////////////////////////////////////////////
 
-	///	Data-oriented ECS design. Components are stored in contiguous memory inside of archetypes to improve cache locality.
+	///	Data-oriented ECS design. Components are stored in contiguous memory inside of archetypes to improve cache locality. The
+	/// memory of an archetype is split into fixed-size chunks that are never relocated when the archetype grows.
 	/// 
 	class EntityAdmin final : private NonCopyable
 	{
@@ -46,7 +52,8 @@ namespace vlx
 		struct Record
 		{
 			Archetype*	archetype	{nullptr};
-			IDType		index		{0}; // where in the archetype entity array is the entity located at
+			IDType		index		{0};			// where in the archetype entity array is the entity located at
+			EntityID	id			{NULL_ENTITY};	// full id of the entity that occupies this slot, null if free
 		};
 
 		struct ArchetypeRecord
@@ -70,19 +77,29 @@ namespace vlx
 			uint16					flag			{0};
 		};
 
+		struct LayerSchedule
+		{
+			std::vector<std::vector<const SystemBase*>>	waves;				// systems in the same wave do not conflict and may run concurrently
+			bool										parallel	{false};
+			bool										dirty		{true};	// rebuild waves before next run
+		};
+
 		using ComponentPtr				= std::unique_ptr<IComponentAlloc>;
 		using ArchetypePtr				= std::unique_ptr<Archetype>;
 
 		using SystemsArrayMap			= std::unordered_map<LayerType, std::vector<SystemBase*>>;
 		using ArchetypesArray			= std::vector<ArchetypePtr>;
 		using ArchetypeMap				= std::unordered_map<ArchetypeID, Archetype*>;
-		using EntityArchetypeMap		= std::unordered_map<EntityID, Record>;
-		using EntityComponentRefMap		= std::unordered_map<EntityID, std::unordered_map<ComponentTypeID, DataRef>>;
+		using EntityRecords				= std::vector<Record>;
+		using ComponentRefs				= std::vector<std::pair<ComponentTypeID, DataRef>>; // few per entity, searched linearly
+		using EntityComponentRefs		= std::vector<ComponentRefs>;
 		using ComponentTypeIDBaseMap	= std::unordered_map<ComponentTypeID, ComponentPtr>;
 		using ComponentArchetypesMap	= std::unordered_map<ComponentTypeID, std::unordered_map<ArchetypeID, ArchetypeRecord>>;
-		using ArchetypeCache			= std::unordered_map<ArchetypeID, std::vector<Archetype*>>;
+		using QueryPtr					= std::unique_ptr<ArchetypeQuery>;
+		using QueryMap					= std::unordered_map<ArchetypeID, QueryPtr>;
 		using EventMap					= std::unordered_map<ComponentTypeID, Event<EntityID, void*>>;
-		using GenerationCountMap		= std::unordered_map<EntityID, std::size_t>;
+		using LayerScheduleMap			= std::unordered_map<LayerType, LayerSchedule>;
+		using ComponentRefEntitiesMap	= std::unordered_map<ComponentTypeID, std::vector<EntityID>>;
 
 		template<IsComponent>
 		friend struct ComponentAlloc;
@@ -167,8 +184,37 @@ namespace vlx
 		template<class... Cs> requires IsComponents<Cs...>
 		bool RemoveComponents(EntityID entity_id, std::type_identity<std::tuple<Cs...>>);
 
+		///	Adds the components to all the specified entities. Entities that share archetype are migrated together, 
+		/// with the destination being reserved for all of them at once.
+		/// 
+		/// \param Entities: IDs of the entities to add the components to
+		///
+		template<class... Cs> requires IsComponents<Cs...>
+		void AddComponents(EntitySpan entities);
+
+		///	Removes the components from all the specified entities. Entities that share archetype are migrated together, 
+		/// with the destination being reserved for all of them at once.
+		/// 
+		/// \param Entities: IDs of the entities to remove the components from
+		/// 
+		/// \returns Whether if it was able to remove any component from any of the entities
+		///
+		template<class... Cs> requires IsComponents<Cs...>
+		bool RemoveComponents(EntitySpan entities);
+
+		///	Creates multiple entities at once directly in the archetype that holds exactly the specified components, 
+		/// the components are default constructed.
+		/// 
+		/// \param Count: Number of entities to create
+		/// 
+		/// \returns IDs of the created entities
+		///
+		template<class... Cs> requires IsComponents<Cs...>
+		NODISC std::vector<EntityID> CreateEntities(std::size_t count);
+
 		///	GetComponent is designed to be as fast as possible without checks to see if it exists, otherwise, will throw error. 
 		/// Therefore, take some caution when using this function. Use instead: TryGetComponent or GetComponentRef for better safety.
+		/// The chunk of the component is marked as changed, since the returned reference may be written to.
 		/// 
 		/// \param EntityID: ID of the entity to retrieve the component from
 		/// 
@@ -373,6 +419,26 @@ namespace vlx
 		///
 		NODISC VELOX_API EntityID Duplicate(EntityID entity_id);
 
+		///	Duplicates the entity multiple times, the copies are placed in the same archetype as the original.
+		/// 
+		/// \param EntityID: entity id of the one to copy the components from
+		/// \param Count: Number of copies to create
+		/// 
+		/// \returns IDs of the newly created entities containing the copied components
+		///
+		NODISC VELOX_API std::vector<EntityID> Duplicate(EntityID entity_id, std::size_t count);
+
+		///	Creates multiple entities at once directly in the archetype that holds exactly the specified components, 
+		/// the components are default constructed.
+		/// 
+		/// \param ComponentIDSpan: The IDs of the components for the entities
+		/// \param ArchetypeID: Combined hash of the component IDs
+		/// \param Count: Number of entities to create
+		/// 
+		/// \returns IDs of the created entities
+		///
+		NODISC VELOX_API std::vector<EntityID> CreateEntities(ComponentIDSpan component_ids, ArchetypeID archetype_id, std::size_t count);
+
 		/// Searches for entities that contains the specified components.
 		/// 
 		/// \param Restricted: Returns all entities that exactly match the provided components
@@ -423,6 +489,21 @@ namespace vlx
 		/// 
 		NODISC VELOX_API std::vector<EntityID> GetEntitiesWith(ComponentIDSpan component_ids, ArchetypeID archetype_id, bool restricted = false) const;
 
+		/// Retrieves the query for the archetypes that contain all of the included components and none of the excluded
+		/// ones. The query is registered on first use and is from then on updated as new archetypes are created, the 
+		/// returned reference stays valid for the lifetime of the admin.
+		/// 
+		/// \param Include: Sorted IDs of the components the archetypes are required to have
+		/// \param Exclude: Sorted IDs of the components the archetypes are not allowed to have
+		/// 
+		/// \returns Query holding the matching archetypes
+		/// 
+		NODISC VELOX_API const ArchetypeQuery& GetQuery(ComponentIDSpan include, ComponentIDSpan exclude = {}) const;
+
+		/// \returns The current change tick, components accessed mutably outside of systems are marked with it
+		/// 
+		NODISC VELOX_API uint32 GetChangeTick() const noexcept;
+
 		///	Increases the capacity of the archetype containing an exact match of the specified components.
 		/// 
 		/// \param ComponentIDSpan: The IDs of the components to search the entity for
@@ -496,6 +577,18 @@ namespace vlx
 		VELOX_API void RunSystems(LayerType layer) const;
 		VELOX_API void SortSystems(LayerType layer);
 
+		///	Allows for the systems in the layer to be run concurrently when they do not write to the same components in 
+		/// the same archetypes. Systems in a parallel layer should only access the components they have declared, and 
+		/// mark the components they only read as const, e.g., System<const BodyTransform, Transform>. Systems that 
+		/// keep mutable state of their own or reach other entities through component references, such as the global 
+		/// transform system, are not safe to run in a parallel layer.
+		/// 
+		/// \param Layer: Layer to set
+		/// \param Flag: Whether to run the systems in parallel
+		/// 
+		VELOX_API void SetLayerParallel(LayerType layer, bool flag);
+		NODISC VELOX_API bool IsLayerParallel(LayerType layer) const;
+
 		VELOX_API void RunSystem(const SystemBase* system) const;
 
 		VELOX_API void AddComponent(EntityID entity_id, ComponentTypeID add_component_id);
@@ -504,10 +597,16 @@ namespace vlx
 		VELOX_API void AddComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id);
 		VELOX_API bool RemoveComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id);
 
+		VELOX_API void AddComponents(EntitySpan entities, ComponentIDSpan component_ids, ArchetypeID archetype_id);
+		VELOX_API bool RemoveComponents(EntitySpan entities, ComponentIDSpan component_ids, ArchetypeID archetype_id);
+
 		VELOX_API void DeregisterOnAddListener(ComponentTypeID component_id, evnt::IDType id);
 		VELOX_API void DeregisterOnMoveListener(ComponentTypeID component_id, evnt::IDType id);
 		VELOX_API void DeregisterOnRemoveListener(ComponentTypeID component_id, evnt::IDType id);
 
+		NODISC VELOX_API const ThreadPool& GetThreadPool() const noexcept;
+		NODISC VELOX_API ThreadPool& GetThreadPool() noexcept;
+
 		NODISC VELOX_API bool HasShutdown() const;
 		VELOX_API void Shutdown();
 
@@ -521,10 +620,37 @@ namespace vlx
 		template<IsComponent C>
 		void UpdateComponentRef(EntityID entity_id, C* new_component) const;
 
+	private:
+		VELOX_API void RunArchetypes(const SystemBase* system, const std::vector<Archetype*>& archetypes) const;
+
+		VELOX_API void BuildSchedule(const std::vector<SystemBase*>& systems, LayerSchedule& schedule) const;
+		VELOX_API void InvalidateSchedules() const;
+
+		NODISC VELOX_API bool IsConflicting(const SystemBase& lhs, const SystemBase& rhs) const;
+
 	private:
 		NODISC VELOX_API Archetype* GetArchetype(ComponentIDSpan component_ids, ArchetypeID archetype_id);
 
-		NODISC VELOX_API const std::vector<Archetype*>& GetArchetypes(ComponentIDSpan component_ids, ArchetypeID archetype_id) const;
+		///	\returns Query of the system, resolved once and then stored in the system
+		/// 
+		NODISC VELOX_API const ArchetypeQuery& GetQuery(const SystemBase& system) const;
+
+		///	Appends the newly created archetype to every query that it matches.
+		/// 
+		VELOX_API void MatchQueries(Archetype* archetype) const;
+
+		///	Matches every query again against all of the archetypes, needed when archetypes have been removed.
+		/// 
+		VELOX_API void RebuildQueries() const;
+
+		///	Assigns the system the tick to mark its writes with and marks the referenced components it filters on.
+		/// 
+		VELOX_API void BeginRun(const SystemBase* system) const;
+
+		///	Writes through a ComponentRef cannot be tracked, so the chunks holding referenced components are 
+		/// conservatively marked as changed.
+		/// 
+		VELOX_API void MarkReferencesChanged(ComponentTypeID component_id) const;
 
 		VELOX_API Archetype* CreateArchetype(ComponentIDSpan component_ids, ArchetypeID archetype_id);
 
@@ -535,6 +661,12 @@ namespace vlx
 		VELOX_API void EraseComponentRef(EntityID entity_id, ComponentTypeID component_id) const;
 		VELOX_API void UpdateComponentRef(EntityID entity_id, ComponentTypeID component_id, void* new_component) const;
 
+		NODISC VELOX_API ComponentRefs& GetComponentRefs(EntityID entity_id) const; // constructs if it does not exist
+		NODISC VELOX_API ComponentRefs* FindComponentRefs(EntityID entity_id) const;
+		NODISC static auto FindComponentRef(ComponentRefs& refs, ComponentTypeID component_id) -> ComponentRefs::iterator;
+
+		VELOX_API void EraseRefEntity(ComponentTypeID component_id, EntityID entity_id) const;
+
 		VELOX_API void ClearEmptyEntityArchetypes();
 		VELOX_API void ClearEmptyTypeArchetypes();
 
@@ -544,28 +676,65 @@ namespace vlx
 		VELOX_API void DestructSwap(Archetype* old_archetype, Archetype* new_archetype, EntityID entity_id, const Record& record, EntityID last_entity_id, Record& last_record) const;
 		VELOX_API void Destruct(Archetype* old_archetype, Archetype* new_archetype, EntityID entity_id, const Record& record) const;
 
-		VELOX_API void MakeRoom(Archetype* archetype, const IComponentAlloc* component, std::size_t data_size, std::size_t i) const;
+		VELOX_API void MakeRoom(Archetype* archetype, std::size_t count = 1) const;
+
+		NODISC VELOX_API Archetype* GetAddArchetype(Archetype* old_archetype, ComponentIDSpan component_ids, ArchetypeID archetype_id);
+		NODISC VELOX_API Archetype* GetRemoveArchetype(Archetype* old_archetype, ComponentIDSpan component_ids, ArchetypeID archetype_id);
+
+		VELOX_API void Migrate(Archetype* old_archetype, Archetype* new_archetype, EntitySpan entities, bool add);
+		VELOX_API void MigrateAll(Archetype* old_archetype, Archetype* new_archetype);
+
+		///	\returns True if the component can be moved by only copying its bytes, requires the component to be trivially
+		///	copyable and that no one is listening to it being moved, either through an event or a ComponentRef.
+		/// 
+		NODISC VELOX_API bool IsRelocatable(ComponentTypeID component_id, const IComponentAlloc* component) const;
+
+		///	Moves the component from source to destination, uses a plain memcpy when the component is relocatable.
+		/// 
+		VELOX_API void RelocateData(ComponentTypeID component_id, const IComponentAlloc* component, 
+			EntityID entity_id, DataPtr source, DataPtr destination) const;
+
+		///	Moves the contiguous range of components from source to destination, uses one memcpy for the entire range 
+		/// when the component is relocatable.
+		/// 
+		/// \param Entities: Entities that own the components in the range
+		/// 
+		VELOX_API void RelocateData(ComponentTypeID component_id, const IComponentAlloc* component, 
+			EntitySpan entities, DataPtr source, DataPtr destination) const;
+
+		VELOX_API void ReleaseEntity(EntityID entity_id);
+
+		NODISC Record* FindRecord(EntityID entity_id);
+		NODISC const Record* FindRecord(EntityID entity_id) const;
+
+		NODISC Record& GetRecord(EntityID entity_id);
+		NODISC const Record& GetRecord(EntityID entity_id) const;
 
 		VELOX_API void Destroy();
 
 	private:
-		EntityID				m_entity_id_counter {1};	// current id counter for entities
-		std::vector<EntityID>	m_reusable_entity_ids;		// reusable ids of entities that have been destroyed
+		IDType					m_entity_id_counter {1};	// next unused index for entities, zero is reserved for the null entity
+		std::vector<EntityID>	m_reusable_entity_ids;		// reusable ids of entities that have been destroyed, with their version increased
 
 		SystemsArrayMap			m_systems;						// map layer to array of systems (layer allows for controlling the order of calls)
 		ArchetypesArray			m_archetypes;					// find matching archetype to update matching entities
 		ArchetypeMap			m_archetype_map;				// map set of components to matching archetype that contains such components
-		EntityArchetypeMap		m_entity_archetype_map;			// map entity to where its data is located at in the archetype
+		EntityRecords			m_entity_records;				// entity table indexed by the entity index, tells where its data is located at in the archetype
 		ComponentArchetypesMap	m_component_archetypes_map;		// map component to the archetypes it exists in and where all of the components data in the archetype is located at
 		ComponentTypeIDBaseMap	m_component_map;				// access to helper functions for modifying each unique component
-		GenerationCountMap		m_generation_count_map;			// tracks how many times a particular entity id has been generated
 
 		EventMap				m_events_add;
 		EventMap				m_events_move;
 		EventMap				m_events_remove;
 		
-		mutable ArchetypeCache			m_archetype_cache;
-		mutable EntityComponentRefMap	m_entity_component_ref_map;
+		mutable QueryMap				m_queries;					// registered queries, updated whenever an archetype is created
+		mutable EntityComponentRefs		m_entity_component_refs;	// references handed out, indexed by the entity index like the records
+		mutable ComponentRefEntitiesMap	m_component_ref_entities;	// entities holding references per component, components with none may be moved without updating them
+		mutable LayerScheduleMap		m_schedules;				// order in which systems in parallel layers may run
+
+		mutable ThreadPool		m_thread_pool;				// workers used for running systems in parallel
+
+		mutable uint32			m_change_tick {1};			// incremented for every system run, used to mark and detect changes to components
 
 		bool m_shutdown			{false};
 		bool m_destroyed		{false};
@@ -609,11 +778,11 @@ namespace vlx
 		if (m_component_lock)
 			throw std::runtime_error("Components memory is currently locked from modifications");
 
-		const auto eit = m_entity_archetype_map.find(entity_id);
-		if (eit == m_entity_archetype_map.end())
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr)
 			return nullptr;
 
-		Record& record = eit->second;
+		Record& record = *record_ptr;
 		Archetype* old_archetype = record.archetype;
 
 		C* add_component = nullptr;
@@ -646,38 +815,35 @@ namespace vlx
 			EntityID last_entity_id = old_archetype->entities.back();
 			assert(last_entity_id != NULL_ENTITY && "There should never exist a null entity");
 
+			MakeRoom(new_archetype);
+
+			const auto new_index = new_archetype->entities.size();
+
 			if (last_entity_id != entity_id) // not same, we'll swap last to current for faster adding
 			{
-				Record& last_record = m_entity_archetype_map[last_entity_id];
+				Record& last_record = GetRecord(last_entity_id);
 
 				for (std::size_t i = 0, j = 0; i < new_archetype->type.size(); ++i) // move all the data from old to new and perform swaps at the same time
 				{
 					const auto component_id		= new_archetype->type[i];
 					const auto component		= m_component_map[component_id].get();
-					const auto component_size	= component->GetSize();
-
-					const auto current_size		= new_archetype->entities.size() * component_size;
-					const auto new_size			= current_size + component_size;
-
-					if (new_size > new_archetype->component_data_size[i])
-						MakeRoom(new_archetype, component, component_size, i);
 
 					if (component_id == add_component_id)
 					{
 						assert(add_component == nullptr && "Component should ever only be constructed once");
 
-						add_component = new(&new_archetype->component_data[i][current_size])
+						add_component = new(new_archetype->GetData(i, new_index))
 							C(std::forward<Args>(args)...);
 					}
 					else
 					{
-						component->MoveDestroyData(*this, entity_id,
-							&old_archetype->component_data[j][record.index * component_size],
-							&new_archetype->component_data[i][current_size]);
+						RelocateData(component_id, component, entity_id,
+							old_archetype->GetData(j, record.index),
+							new_archetype->GetData(i, new_index));
 
-						component->MoveDestroyData(*this, last_entity_id,
-							&old_archetype->component_data[j][last_record.index * component_size],
-							&old_archetype->component_data[j][record.index * component_size]); // move data from last to current
+						RelocateData(component_id, component, last_entity_id,
+							old_archetype->GetData(j, last_record.index),
+							old_archetype->GetData(j, record.index)); // move data from last to current
 
 						++j;
 					}
@@ -685,6 +851,8 @@ namespace vlx
 
 				old_archetype->entities[record.index] = old_archetype->entities.back();
 				last_record.index = record.index;
+
+				old_archetype->MarkEntityChanged(record.index, m_change_tick);
 			}
 			else // same, usually means that this entity is at the back, just perform normal moving
 			{
@@ -692,26 +860,19 @@ namespace vlx
 				{
 					const auto component_id		= new_archetype->type[i];
 					const auto component		= m_component_map[component_id].get();
-					const auto component_size	= component->GetSize();
-
-					const auto current_size		= new_archetype->entities.size() * component_size;
-					const auto new_size			= current_size + component_size;
-
-					if (new_size > new_archetype->component_data_size[i])
-						MakeRoom(new_archetype, component, component_size, i);
 
 					if (component_id == add_component_id)
 					{
 						assert(add_component == nullptr && "Component should ever only be constructed once");
 
-						add_component = new(&new_archetype->component_data[i][current_size])
+						add_component = new(new_archetype->GetData(i, new_index))
 							C(std::forward<Args>(args)...);
 					}
 					else
 					{
-						component->MoveDestroyData(*this, entity_id,
-							&old_archetype->component_data[j][record.index * component_size],
-							&new_archetype->component_data[i][current_size]);
+						RelocateData(component_id, component, entity_id,
+							old_archetype->GetData(j, record.index),
+							new_archetype->GetData(i, new_index));
 
 						++j;
 					}
@@ -727,16 +888,9 @@ namespace vlx
 			ComponentIDs new_archetype_id(1, add_component_id);	// construct archetype with the component id
 			new_archetype = GetArchetype(new_archetype_id, cu::ContainerHash<ComponentTypeID>()(new_archetype_id)); // construct or get archetype using the id
 
-			const auto component		= m_component_map[add_component_id].get();
-			const auto component_size	= component->GetSize();
+			MakeRoom(new_archetype);
 
-			const auto current_size	= new_archetype->entities.size() * component_size;
-			const auto new_size		= current_size + component_size;
-
-			if (new_size > new_archetype->component_data_size[0])
-				MakeRoom(new_archetype, component, component_size, 0); // make room and move over existing data
-
-			add_component = new(&new_archetype->component_data[0][current_size])
+			add_component = new(new_archetype->GetData(0, new_archetype->entities.size()))
 				C(std::forward<Args>(args)...);
 		}
 
@@ -744,6 +898,8 @@ namespace vlx
 		record.index		= static_cast<IDType>(new_archetype->entities.size() - 1);
 		record.archetype	= new_archetype;
 
+		new_archetype->MarkEntityChanged(record.index, m_change_tick);
+
 		if constexpr (HasEvent<C, CreatedEvent>) // call associated event
 			add_component->Created(*this, entity_id);
 
@@ -792,6 +948,39 @@ namespace vlx
 		return RemoveComponents<Cs...>(entity_id);
 	}
 
+	template<class... Cs> requires IsComponents<Cs...>
+	inline void EntityAdmin::AddComponents(EntitySpan entities)
+	{
+		assert(IsComponentsRegistered<Cs...>() && "Components is not registered");
+
+		static constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ GetComponentID<Cs>()... });
+		static constexpr auto archetype_id = cu::ContainerHash<ComponentTypeID>()(component_ids);
+
+		AddComponents(entities, component_ids, archetype_id);
+	}
+
+	template<class... Cs> requires IsComponents<Cs...>
+	inline bool EntityAdmin::RemoveComponents(EntitySpan entities)
+	{
+		assert(IsComponentsRegistered<Cs...>() && "Components is not registered");
+
+		static constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ GetComponentID<Cs>()... });
+		static constexpr auto archetype_id = cu::ContainerHash<ComponentTypeID>()(component_ids);
+
+		return RemoveComponents(entities, component_ids, archetype_id);
+	}
+
+	template<class... Cs> requires IsComponents<Cs...>
+	inline std::vector<EntityID> EntityAdmin::CreateEntities(std::size_t count)
+	{
+		assert(IsComponentsRegistered<Cs...>() && "Components is not registered");
+
+		static constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ GetComponentID<Cs>()... });
+		static constexpr auto archetype_id = cu::ContainerHash<ComponentTypeID>()(component_ids);
+
+		return CreateEntities(component_ids, archetype_id, count);
+	}
+
 	template<IsComponent C>
 	inline C& EntityAdmin::GetComponent(EntityID entity_id) const
 	{
@@ -799,14 +988,15 @@ namespace vlx
 
 		static constexpr ComponentTypeID component_id = GetComponentID<C>();
 
-		const auto& record = m_entity_archetype_map.at(entity_id);
+		const auto& record = GetRecord(entity_id);
 		const auto* archetype = record.archetype;
 
-		const auto& map = m_component_archetypes_map.at(component_id);
-		const auto& arch_record = map.at(archetype->id);
+		const auto column = archetype->FindColumn(component_id);
+		assert(column != Archetype::NULL_COLUMN && "Entity does not hold the component");
+
+		archetype->MarkChanged(record.index / archetype->chunk_capacity, column, m_change_tick); // handing out mutable access counts as a write
 		
-		C* components = reinterpret_cast<C*>(&archetype->component_data[arch_record.column][0]);
-		return components[record.index];
+		return *reinterpret_cast<C*>(archetype->GetData(column, record.index));
 	}
 
 	template<IsComponent C>
@@ -814,11 +1004,11 @@ namespace vlx
 	{
 		assert(IsComponentRegistered<C>() && "Component is not registered");
 
-		const auto eit = m_entity_archetype_map.find(entity_id);
-		if (eit == m_entity_archetype_map.end())
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr)
 			return nullptr;
 
-		const auto& record		= eit->second;
+		const auto& record		= *record_ptr;
 		const auto* archetype	= record.archetype;
 
 		if (archetype == nullptr)
@@ -826,33 +1016,27 @@ namespace vlx
 
 		constexpr ComponentTypeID component_id = GetComponentID<C>();
 
-		const auto cit = m_component_archetypes_map.find(component_id);
-		if (cit == m_component_archetypes_map.end())
-			return nullptr;
-
-		const auto ait = cit->second.find(archetype->id);
-		if (ait == cit->second.end())
+		const auto column = archetype->FindColumn(component_id);
+		if (column == Archetype::NULL_COLUMN)
 			return nullptr;
 
-		const auto& arch_record = ait->second;
+		archetype->MarkChanged(record.index / archetype->chunk_capacity, column, m_change_tick);
 
-		C* components = reinterpret_cast<C*>(&archetype->component_data[arch_record.column][0]);
-		return &components[record.index];
+		return reinterpret_cast<C*>(archetype->GetData(column, record.index));
 	}
 
 	template<class B>
 	inline B& EntityAdmin::GetBase(EntityID entity_id, ComponentTypeID child_component_id, uint16 offset) const
 	{
-		const auto& record = m_entity_archetype_map.at(entity_id);
+		const auto& record = GetRecord(entity_id);
 		const auto* archetype = record.archetype;
 
-		const auto& map = m_component_archetypes_map.at(child_component_id);
-		const auto& arch_record = map.at(archetype->id);
+		const auto column = archetype->FindColumn(child_component_id);
+		assert(column != Archetype::NULL_COLUMN && "Entity does not hold the component");
 
-		const auto component = m_component_map.at(child_component_id).get();
-		const auto component_size = component->GetSize();
+		archetype->MarkChanged(record.index / archetype->chunk_capacity, column, m_change_tick);
 
-		DataPtr ptr = &archetype->component_data[arch_record.column][record.index * component_size];
+		DataPtr ptr = archetype->GetData(column, record.index);
 		B* base_component = reinterpret_cast<B*>(ptr + offset);
 
 		return *base_component;
@@ -861,31 +1045,23 @@ namespace vlx
 	template<class B>
 	inline B* EntityAdmin::TryGetBase(EntityID entity_id, ComponentTypeID child_component_id, uint16 offset) const
 	{
-		const auto eit = m_entity_archetype_map.find(entity_id);
-		if (eit == m_entity_archetype_map.end())
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr)
 			return nullptr;
 
-		const auto& record = eit->second;
+		const auto& record = *record_ptr;
 		const auto* archetype = record.archetype;
 
 		if (archetype == nullptr)
 			return nullptr;
 
-		const auto cit = m_component_archetypes_map.find(child_component_id);
-		if (cit == m_component_archetypes_map.end())
-			return nullptr;
-
-		const auto ait = cit->second.find(archetype->id);
-		if (ait == cit->second.end())
-			return nullptr;
-
-		const auto iit = m_component_map.find(child_component_id);
-		if (iit == m_component_map.end())
+		const auto column = archetype->FindColumn(child_component_id);
+		if (column == Archetype::NULL_COLUMN)
 			return nullptr;
 
-		const auto component_size = iit->second->GetSize();
+		archetype->MarkChanged(record.index / archetype->chunk_capacity, column, m_change_tick);
 
-		DataPtr ptr = &archetype->component_data[ait->second.column][record.index * component_size];
+		DataPtr ptr = archetype->GetData(column, record.index);
 		B* base_component = reinterpret_cast<B*>(ptr + offset);
 
 		return base_component;
@@ -941,9 +1117,9 @@ namespace vlx
 				component = TryGetComponent<C>(entity_id);
 		};
 
-		auto& references = m_entity_component_ref_map[entity_id]; // will construct new if it does not exist
+		auto& references = GetComponentRefs(entity_id);
 
-		const auto cit = references.find(component_id);
+		const auto cit = FindComponentRef(references, component_id);
 		if (cit == references.end()) // it does not yet exist
 		{
 			CheckComponentPtr();
@@ -955,7 +1131,8 @@ namespace vlx
 			data.component_ptr	= ptr;
 			data.flag			= DataRef::R_Component;
 
-			references.try_emplace(component_id, data);
+			references.emplace_back(component_id, data);
+			m_component_ref_entities[component_id].emplace_back(entity_id);
 
 			return ComponentRef<C>(ptr);
 		}
@@ -979,7 +1156,7 @@ namespace vlx
 	template<class B>
 	inline ComponentRef<B> EntityAdmin::GetBaseRef(EntityID entity_id, ComponentTypeID child_component_id, uint16 offset, B* base) const
 	{
-		auto& component_refs = m_entity_component_ref_map[entity_id]; // will construct new if it does not exist
+		auto& component_refs = GetComponentRefs(entity_id);
 
 		const auto CheckBasePtr = [this, entity_id, child_component_id, offset, &base]()
 		{
@@ -987,7 +1164,7 @@ namespace vlx
 				base = TryGetBase<B>(entity_id, child_component_id, offset);
 		};
 
-		const auto cit = component_refs.find(child_component_id);
+		const auto cit = FindComponentRef(component_refs, child_component_id);
 		if (cit == component_refs.end()) // it does not yet exist
 		{
 			CheckBasePtr();
@@ -1000,7 +1177,8 @@ namespace vlx
 			data.base_offset = offset;
 			data.flag = DataRef::R_Base;
 
-			component_refs.emplace(child_component_id, data);
+			component_refs.emplace_back(child_component_id, data);
+			m_component_ref_entities[child_component_id].emplace_back(entity_id);
 
 			return ComponentRef<B>(ptr);
 		}
@@ -1043,17 +1221,18 @@ namespace vlx
 	template<class... Cs> requires (IsComponents<Cs...> && sizeof...(Cs) > 1)
 	inline std::tuple<Cs&...> EntityAdmin::GetComponents(EntityID entity_id) const
 	{
-		const auto& record = m_entity_archetype_map.at(entity_id);
+		const auto& record = GetRecord(entity_id);
 
 		const auto GetComponent = [this]<class C>(const Record& record) -> C&
 		{
 			static constexpr ComponentTypeID component_id = GetComponentID<C>();
 
-			const auto& map = m_component_archetypes_map.at(component_id);
-			const auto& arch_record = map.at(record.archetype->id);
+			const auto column = record.archetype->FindColumn(component_id);
+			assert(column != Archetype::NULL_COLUMN && "Entity does not hold the component");
 
-			C* components = reinterpret_cast<C*>(&record.archetype->component_data[arch_record.column][0]);
-			return components[record.index];
+			record.archetype->MarkChanged(record.index / record.archetype->chunk_capacity, column, m_change_tick);
+
+			return *reinterpret_cast<C*>(record.archetype->GetData(column, record.index));
 		};
 
 		return std::tie(GetComponent.template operator()<Cs>(record)...);
@@ -1068,27 +1247,24 @@ namespace vlx
 	template<class... Cs> requires (IsComponents<Cs...> && sizeof...(Cs) > 1)
 	inline std::tuple<Cs*...> EntityAdmin::TryGetComponents(EntityID entity_id) const
 	{
-		const auto it = m_entity_archetype_map.find(entity_id);
-		if (it == m_entity_archetype_map.end())
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr || record_ptr->archetype == nullptr)
 			return {};
 
 		const auto GetComponent = [this]<class C>(const Record& record) -> C*
 		{
 			static constexpr ComponentTypeID component_id = GetComponentID<C>();
 
-			const auto cit = m_component_archetypes_map.find(component_id);
-			if (cit == m_component_archetypes_map.end())
+			const auto column = record.archetype->FindColumn(component_id);
+			if (column == Archetype::NULL_COLUMN)
 				return nullptr;
 
-			const auto ait = cit->second.find(record.archetype->id);
-			if (ait == cit->second.end())
-				return nullptr;
+			record.archetype->MarkChanged(record.index / record.archetype->chunk_capacity, column, m_change_tick);
 
-			C* components = reinterpret_cast<C*>(&record.archetype->component_data[ait->second.column][0]);
-			return &components[record.index];
+			return reinterpret_cast<C*>(record.archetype->GetData(column, record.index));
 		};
 
-		return std::make_tuple(GetComponent.template operator()<Cs>(it->second)...);
+		return std::make_tuple(GetComponent.template operator()<Cs>(*record_ptr)...);
 	}
 
 	template<class... Cs> requires (IsComponents<Cs...> && sizeof...(Cs) == 1)
@@ -1129,11 +1305,11 @@ namespace vlx
 	template<IsComponent C, class Comp> requires SameTypeParamDecay<Comp, C, 0, 1>
 	inline bool EntityAdmin::SortComponents(EntityID entity_id, Comp&& comparison)
 	{
-		const auto it = m_entity_archetype_map.find(entity_id);
-		if (it == m_entity_archetype_map.end())
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr)
 			return false;
 
-		Archetype* archetype = it->second.archetype;
+		Archetype* archetype = record_ptr->archetype;
 
 		return SortComponents<C>(archetype, std::forward<Comp>(comparison));
 	}
@@ -1263,55 +1439,68 @@ namespace vlx
 		if (archetype == nullptr)
 			return false;
 
-		const auto cit = m_component_archetypes_map.find(GetComponentID<C>());
-		if (cit == m_component_archetypes_map.end())
+		const auto column = archetype->FindColumn(GetComponentID<C>());
+		if (column == Archetype::NULL_COLUMN)
 			return false;
 
-		const auto ait = cit->second.find(archetype->id);
-		if (ait == cit->second.end())
-			return false;
-
-		const ArchetypeRecord& a_record = ait->second;
-
-		C* components = reinterpret_cast<C*>(&archetype->component_data[a_record.column][0]);
-
 		std::vector<uint32> indices(archetype->entities.size());
 		std::iota(indices.begin(), indices.end(), 0);
 
 		std::ranges::sort(indices,
-			[&comparison, &components](uint32 lhs, uint32 rhs)
+			[&comparison, &archetype, column](uint32 lhs, uint32 rhs)
 			{
-				return std::forward<Comp>(comparison)(components[lhs], components[rhs]);
+				return std::forward<Comp>(comparison)(
+					*reinterpret_cast<C*>(archetype->GetData(column, lhs)),
+					*reinterpret_cast<C*>(archetype->GetData(column, rhs)));
 			});
 
+		decltype(archetype->chunks) new_chunks; // components are moved over to a new set of chunks in sorted order
+		new_chunks.reserve(archetype->chunks.size());
+
+		for (std::size_t i = 0; i < archetype->chunks.size(); ++i)
+			new_chunks.emplace_back(std::make_unique_for_overwrite<ByteArray>(archetype->chunk_size));
+
+		const auto capacity = archetype->chunk_capacity;
+
+		std::vector<std::pair<std::size_t, std::size_t>> runs; // [start, count] of entities that remain in the same order, allows for them to be moved at once
+		for (std::size_t j = 0; j < indices.size();)
+		{
+			std::size_t count = 1;
+			while (j + count < indices.size() && 
+				indices[j + count] == indices[j] + count && 
+				(indices[j] + count) % capacity != 0 && (j + count) % capacity != 0) // neither source or destination may cross a chunk
+			{
+				++count;
+			}
+
+			runs.emplace_back(j, count);
+			j += count;
+		}
+
 		for (std::size_t i = 0; i < archetype->type.size(); ++i) // sort the components, all need to be sorted
 		{
 			const auto component_id		= archetype->type[i];
 			const auto component		= m_component_map[component_id].get();
-			const auto component_size	= component->GetSize();
+			const auto component_size	= archetype->column_sizes[i];
 
-			ComponentData new_data = std::make_unique<ByteArray>(archetype->component_data_size[i]);
-
-			for (std::size_t j = 0; j < archetype->entities.size(); ++j)
+			for (const auto [j, count] : runs)
 			{
-				component->MoveDestroyData(*this, archetype->entities[j],
-					&archetype->component_data[i][indices[j] * component_size],
-					&new_data[j * component_size]);
+				RelocateData(component_id, component, EntitySpan(archetype->entities).subspan(indices[j], count),
+					archetype->GetData(i, indices[j]),
+					&new_chunks[j / capacity][archetype->column_offsets[i] + (j % capacity) * component_size]);
 			}
-
-			archetype->component_data[i] = std::move(new_data);
 		}
 
+		archetype->chunks = std::move(new_chunks);
+		std::ranges::fill(archetype->versions, m_change_tick); // entities have been moved between chunks
+
 		decltype(archetype->entities) new_entities;
 		for (std::size_t i = 0; i < archetype->entities.size(); ++i) // now swap the entities
 		{
 			std::size_t index = indices[i];
 			EntityID entity_id = archetype->entities[index];
 
-			auto it = m_entity_archetype_map.find(entity_id);
-			assert(it != m_entity_archetype_map.end()); // should never happen
-
-			it->second.index = IDType(i);
+			GetRecord(entity_id).index = IDType(i);
 			new_entities.push_back(entity_id);
 		}
 
@@ -1320,6 +1509,38 @@ namespace vlx
 		return true;
 	}
 
+	inline auto EntityAdmin::FindRecord(EntityID entity_id) -> Record*
+	{
+		return const_cast<Record*>(std::as_const(*this).FindRecord(entity_id));
+	}
+	inline auto EntityAdmin::FindRecord(EntityID entity_id) const -> const Record*
+	{
+		const auto index = GetEntityIndex(entity_id);
+
+		if (index >= m_entity_records.size() || m_entity_records[index].id != entity_id || entity_id == NULL_ENTITY) // stale handles have a different version
+			return nullptr;
+
+		return &m_entity_records[index];
+	}
+
+	inline auto EntityAdmin::GetRecord(EntityID entity_id) -> Record&
+	{
+		return const_cast<Record&>(std::as_const(*this).GetRecord(entity_id));
+	}
+	inline auto EntityAdmin::GetRecord(EntityID entity_id) const -> const Record&
+	{
+		const auto index = GetEntityIndex(entity_id);
+
+		assert(index < m_entity_records.size() && m_entity_records[index].id == entity_id && "Entity is not registered");
+
+		return m_entity_records[index];
+	}
+
+	inline auto EntityAdmin::FindComponentRef(ComponentRefs& refs, ComponentTypeID component_id) -> ComponentRefs::iterator
+	{
+		return std::ranges::find(refs, component_id, &ComponentRefs::value_type::first);
+	}
+
 	template<IsComponent C>
 	inline void EntityAdmin::EraseComponentRef(EntityID entity_id) const
 	{
@@ -24,5 +24,6 @@ namespace vlx
 		virtual void Shutdown(			const EntityAdmin& entity_admin, EntityID entity_id, DataPtr data) const = 0;
 
 		virtual constexpr std::size_t GetSize() const noexcept = 0;
+		virtual constexpr bool IsTriviallyRelocatable() const noexcept = 0;
 	};
 }
\ No newline at end of file
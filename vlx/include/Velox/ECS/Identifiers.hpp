@@ -2,11 +2,15 @@
 
 #include <cstdint>
 #include <vector>
+#include <array>
 #include <span>
+#include <algorithm>
 
 #include <Velox/Structures/SmallVector.hpp>
 #include <Velox/System/Concepts.h>
+#include <Velox/System/IDGenerator.h>
 #include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
 
 namespace vlx
 {
@@ -35,7 +39,49 @@ namespace vlx
 
 	using EntitySpan		= std::span<const EntityID>;
 
+	/// Retrieves the sorted IDs of the components that are only read (const) or written to (non-const)
+	/// 
+	template<bool ReadOnly, class... Cs>
+	consteval auto GetAccessIDs()
+	{
+		constexpr std::size_t count = (std::size_t(std::is_const_v<Cs> == ReadOnly) + ... + 0);
+
+		std::array<ComponentTypeID, count> result{};
+		std::size_t i = 0;
+
+		((std::is_const_v<Cs> == ReadOnly ? void(result[i++] = id::Type<std::remove_const_t<Cs>>::ID()) : void()), ...);
+
+		std::ranges::sort(result);
+
+		return result;
+	}
+
 	inline constexpr EntityID			NULL_ENTITY		= NULL;
+
+	inline constexpr IDType				ENTITY_INDEX_BITS	= 20;								// lower bits of the id is the index of the entity in the entity table
+	inline constexpr IDType				ENTITY_INDEX_MASK	= (IDType(1) << ENTITY_INDEX_BITS) - 1;	// upper bits is the version, increased every time the index is reused
+	inline constexpr IDType				ENTITY_VERSION_MASK	= ~ENTITY_INDEX_MASK;
+
+	///	\returns Index of the entity in the entity table
+	///
+	NODISC constexpr IDType GetEntityIndex(EntityID entity_id) noexcept
+	{
+		return entity_id & ENTITY_INDEX_MASK;
+	}
+
+	///	\returns Version of the entity, used to detect handles to entities that have been removed
+	///
+	NODISC constexpr IDType GetEntityVersion(EntityID entity_id) noexcept
+	{
+		return (entity_id & ENTITY_VERSION_MASK) >> ENTITY_INDEX_BITS;
+	}
+
+	///	\returns Entity id made from the index and version, the version wraps around when it overflows
+	///
+	NODISC constexpr EntityID MakeEntityID(IDType index, IDType version) noexcept
+	{
+		return ((version << ENTITY_INDEX_BITS) & ENTITY_VERSION_MASK) | (index & ENTITY_INDEX_MASK);
+	}
 	inline constexpr ComponentTypeID	NULL_COMPONENT	= NULL;
 	inline constexpr ArchetypeID		NULL_ARCHETYPE	= NULL;
 
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <span>
+#include <array>
+#include <utility>
 #include <functional>
 #include <unordered_set>
 #include <algorithm>
@@ -39,6 +41,9 @@ namespace vlx
 		static constexpr ArchetypeID SystemID =
 			cu::ContainerHash<ComponentTypeID>{}(SystemIDs);
 
+		static constexpr auto ReadIDs	= GetAccessIDs<true, Cs...>();
+		static constexpr auto WriteIDs	= GetAccessIDs<false, Cs...>();
+
 	public:
 		System() = delete;
 
@@ -58,6 +63,9 @@ namespace vlx
 		NODISC virtual ArchetypeID GetIDKey() const override;
 		NODISC virtual ComponentIDSpan GetArchKey() const override;
 
+		NODISC virtual ComponentIDSpan GetReadKey() const override;
+		NODISC virtual ComponentIDSpan GetWriteKey() const override;
+
 		/// Determines the priority of the system in the layer.
 		/// 
 		/// /param Value: priority value, for example, high value means that the system will likely be called first
@@ -65,7 +73,8 @@ namespace vlx
 		virtual void SetPriority(float val) override;
 
 	public:
-		/// Set function to be called for all the entities when system is run.
+		/// Set function to be called for all the entities when system is run. Components are stored in chunks, so 
+		/// the function is called once for every chunk with the entities and components that are contiguous in it.
 		/// 
 		template<typename Func> requires HasParameters<Func, EntitySpan, Cs*...>
 		void All(Func&& func);
@@ -139,10 +148,14 @@ namespace vlx
 		bool ForceRemove();
 
 	protected:
-		virtual void Run(const Archetype* const archetype) const override;
+		virtual void Run(const Archetype* const archetype, std::size_t begin, std::size_t end) const override;
 
 		template<typename... Ts> requires (sizeof...(Ts) < sizeof...(Cs))
-		void RunImpl(const Archetype* const archetype, Ts... cs) const;
+		void RunImpl(const Archetype* const archetype, std::size_t begin, std::size_t end, Ts... columns) const;
+
+		template<std::size_t... Is>
+		void RunChunks(const Archetype* const archetype, std::size_t begin, std::size_t end, 
+			const std::array<std::size_t, sizeof...(Cs)>& columns, std::index_sequence<Is...>) const;
 
 	protected:	
 		EntityAdmin*	m_entity_admin	{nullptr};
@@ -220,6 +233,18 @@ namespace vlx
 		return SystemIDs;
 	}
 
+	template<class... Cs> requires IsComponents<Cs...>
+	inline ComponentIDSpan System<Cs...>::GetReadKey() const
+	{
+		return ReadIDs;
+	}
+
+	template<class... Cs> requires IsComponents<Cs...>
+	inline ComponentIDSpan System<Cs...>::GetWriteKey() const
+	{
+		return WriteIDs;
+	}
+
 	template<class... Cs> requires IsComponents<Cs...>
 	inline void System<Cs...>::SetPriority(float val)
 	{
@@ -389,23 +414,24 @@ namespace vlx
 	}
 
 	template<class... Cs> requires IsComponents<Cs...>
-	inline void System<Cs...>::Run(const Archetype* const archetype) const
+	inline void System<Cs...>::Run(const Archetype* const archetype, std::size_t begin, std::size_t end) const
 	{
 		assert(IsEnabled() && "System is disabled and cannot be run (EntityAdmin checks for this condition beforehand)");
 		assert(archetype != nullptr && !archetype->type.empty() && "Has to be a valid archetype");
+		assert(begin <= end && end <= archetype->entities.size() && "Range is outside of the archetype");
 
 		if (m_func) // check if func stores callable object
-			RunImpl(archetype);
+			RunImpl(archetype, begin, end);
 	}
 
 	template<class... Cs> requires IsComponents<Cs...>
 	template<typename... Ts> requires (sizeof...(Ts) < sizeof...(Cs))
-	inline void System<Cs...>::RunImpl(const Archetype* const archetype, Ts... cs) const
+	inline void System<Cs...>::RunImpl(const Archetype* const archetype, std::size_t begin, std::size_t end, Ts... columns) const
 	{
 		using ComponentType = std::tuple_element_t<sizeof...(Ts), ComponentTypes>; // get type of component at index in system components
 		static constexpr auto find_id = EntityAdmin::GetComponentID<ComponentType>();
 
-		auto i			{0};
+		std::size_t i	{0};
 		auto curr_id	{archetype->type[i]};
 
 		while (curr_id != find_id)	// iterate until matching component is found
@@ -414,15 +440,44 @@ namespace vlx
 			curr_id = archetype->type[++i];
 		}
 
-		// run again on next component, or call func
+		// run again on next component, or run the chunks
 		if constexpr ((sizeof...(Ts) + 1) != sizeof...(Cs))
 		{
-			RunImpl(archetype, cs..., reinterpret_cast<ComponentType*>(&archetype->component_data[i][0]));
+			RunImpl(archetype, begin, end, columns..., i);
 		}
 		else
 		{
-			m_func(archetype->entities, cs..., reinterpret_cast<ComponentType*>(&archetype->component_data[i][0]));
+			RunChunks(archetype, begin, end, { columns..., i }, std::index_sequence_for<Cs...>{});
 		}
 	}
-}
 
+	template<class... Cs> requires IsComponents<Cs...>
+	template<std::size_t... Is>
+	inline void System<Cs...>::RunChunks(const Archetype* const archetype, std::size_t begin, std::size_t end, 
+		const std::array<std::size_t, sizeof...(Cs)>& columns, std::index_sequence<Is...>) const
+	{
+		const std::size_t capacity = archetype->chunk_capacity;
+
+		const uint32 tick = this->GetRunTick();
+		const ComponentIDSpan changed = this->GetChangedKey();
+
+		const std::array<bool, sizeof...(Cs)> mark = // components the system filters changes on are not marked, otherwise it would trigger itself
+		{ 
+			(!std::is_const_v<Cs> && !std::ranges::binary_search(changed, id::Type<std::remove_const_t<Cs>>::ID()))... 
+		};
+
+		while (begin < end) // func is called once for every chunk the range overlaps
+		{
+			const std::size_t chunk	= begin / capacity;
+			const std::size_t slot	= begin % capacity;
+			const std::size_t last	= std::min(end, (chunk + 1) * capacity);
+
+			((mark[Is] ? archetype->MarkChanged(chunk, columns[Is], tick) : void()), ...); // writable components are assumed to be written to
+
+			m_func(EntitySpan(archetype->entities).subspan(begin, last - begin),
+				(reinterpret_cast<std::tuple_element_t<Is, ComponentTypes>*>(archetype->GetColumn(chunk, columns[Is])) + slot)...);
+
+			begin = last;
+		}
+	}
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <compare>
+#include <algorithm>
+#include <string_view>
 
 #include <Velox/Utility/NonCopyable.h>
 
@@ -10,6 +12,7 @@
 namespace vlx
 {
 	class EntityAdmin;
+	struct ArchetypeQuery;
 
 	class VELOX_API SystemBase : private NonCopyable
 	{
@@ -26,25 +29,69 @@ namespace vlx
 		NODISC virtual ArchetypeID GetIDKey() const = 0;
 		NODISC virtual ComponentIDSpan GetArchKey() const = 0;
 
+		/// \returns The sorted IDs of the components that an archetype may not contain for the system to run on it
+		/// 
+		NODISC virtual ComponentIDSpan GetExcludeKey() const;
+
+		/// \returns The sorted IDs of the components that a chunk must have changed since the last run for the system to run on it
+		/// 
+		NODISC virtual ComponentIDSpan GetChangedKey() const;
+
+		/// \returns The sorted IDs of the components that are only read by the system
+		/// 
+		NODISC virtual ComponentIDSpan GetReadKey() const;
+
+		/// \returns The sorted IDs of the components that are written to by the system, defaults to all components
+		/// 
+		NODISC virtual ComponentIDSpan GetWriteKey() const;
+
+		///	\returns Name shown in the profiler, defaults to the readable name of the type of the system
+		/// 
+		NODISC const char* GetName() const;
+
 		NODISC float GetPriority() const noexcept;
 		NODISC bool IsRunningParallel() const noexcept;
 		NODISC bool IsEnabled() const noexcept;
+		NODISC std::size_t GetBatchSize() const noexcept;
+
+		/// \returns Tick that the components written to by the current run are marked with
+		/// 
+		NODISC uint32 GetRunTick() const noexcept;
+
+		/// \returns Tick of the previous run, changes marked after it have not yet been seen by the system
+		/// 
+		NODISC uint32 GetLastRunTick() const noexcept;
+
+		void SetName(std::string_view name);
 
 		virtual void SetPriority(float val);
 		virtual void SetRunParallel(bool flag);
 		virtual void SetEnabled(bool flag);
 
+		/// Determines the number of entities that are processed per job when the system is run in parallel.
+		/// 
+		/// /param Size: number of entities, large archetypes are split into ranges of this size
+		/// 
+		virtual void SetBatchSize(std::size_t size);
+
 	public:
 		virtual void Start() const;
 		virtual void End() const;
 
 	protected:
-		virtual void Run(const Archetype* const archetype) const = 0;
+		virtual void Run(const Archetype* const archetype, std::size_t begin, std::size_t end) const = 0;
 
 	private:
-		float	m_priority		{0.0f};		// priority is for controlling the underlying order of calls inside a layer
-		bool	m_run_parallel	{false};	// determines if whether to parallelize archetypes when being run
-		bool	m_enabled		{true};		// enables or disables the system from being run
+		float		m_priority		{0.0f};		// priority is for controlling the underlying order of calls inside a layer
+		std::size_t	m_batch_size	{512};		// number of entities processed per job when running in parallel
+		bool		m_run_parallel	{false};	// determines if whether to split archetypes across threads when being run
+		bool		m_enabled		{true};		// enables or disables the system from being run
+
+		mutable const ArchetypeQuery* m_query {nullptr}; // matching archetypes, resolved by the admin on first run
+		mutable const char* m_name {nullptr}; // interned, resolved from the type on first use since it is not known during construction
+
+		mutable uint32	m_run_tick		{0};	// assigned by the admin before every run
+		mutable uint32	m_last_run_tick	{0};
 
 		friend class EntityAdmin;
 	};
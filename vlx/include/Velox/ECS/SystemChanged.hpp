@@ -0,0 +1,85 @@
+#pragma once
+
+#include "System.hpp"
+
+namespace vlx
+{
+	template<class S, class... Cs>
+	class SystemChanged;
+
+	/// Only runs on the chunks where any of the filtered components have been written to since the previous run of
+	/// the system. A chunk counts as written to when a system with mutable access has run on it, when mutable access
+	/// was given through the EntityAdmin, or when entities were moved into it. Writes made by this system to the filtered
+	/// components are not tracked, which lets it clear its own state without triggering itself on the next run.
+	///
+	template<class... Cs1, class... Cs2> requires IsComponents<Cs1...> && IsComponents<Cs2...> &&
+		(Contains<std::remove_const_t<Cs2>, std::remove_const_t<Cs1>...> && ...)
+	class SystemChanged<System<Cs1...>, Cs2...> final : public virtual System<Cs1...>
+	{
+	private:
+		using ChangedComponentIDs = ArrComponentIDs<std::remove_const_t<Cs2>...>;
+
+		static constexpr ChangedComponentIDs ChangedIDs =
+			cu::Sort<ChangedComponentIDs>({ id::Type<std::remove_const_t<Cs2>>::ID()... });
+
+	public:
+		using System<Cs1...>::System;
+
+	public:
+		NODISC ComponentIDSpan GetChangedKey() const override;
+
+	protected:
+		void Run(const Archetype* const archetype, std::size_t begin, std::size_t end) const override;
+	};
+
+	template<class... Cs1, class... Cs2> requires IsComponents<Cs1...> && IsComponents<Cs2...> &&
+		(Contains<std::remove_const_t<Cs2>, std::remove_const_t<Cs1>...> && ...)
+	inline ComponentIDSpan SystemChanged<System<Cs1...>, Cs2...>::GetChangedKey() const
+	{
+		return ChangedIDs;
+	}
+
+	template<class... Cs1, class... Cs2> requires IsComponents<Cs1...> && IsComponents<Cs2...> &&
+		(Contains<std::remove_const_t<Cs2>, std::remove_const_t<Cs1>...> && ...)
+	inline void SystemChanged<System<Cs1...>, Cs2...>::Run(const Archetype* const archetype, std::size_t begin, std::size_t end) const
+	{
+		assert(this->IsEnabled() && "System is disabled and cannot be run (EntityAdmin checks for this beforehand)");
+
+		if (!this->m_func) // check if func stores callable object
+			return;
+
+		std::array<std::size_t, sizeof...(Cs2)> columns{};
+		for (std::size_t i = 0; i < ChangedIDs.size(); ++i)
+			columns[i] = archetype->FindColumn(ChangedIDs[i]);
+
+		const std::size_t capacity	= archetype->chunk_capacity;
+		const uint32 last_run		= this->GetLastRunTick();
+
+		std::size_t first = begin; // start of the current sequence of changed chunks
+
+		while (begin < end)
+		{
+			const std::size_t chunk	= begin / capacity;
+			const std::size_t last	= std::min(end, (chunk + 1) * capacity);
+
+			const bool changed = std::ranges::any_of(columns,
+				[archetype, chunk, last_run](const std::size_t column)
+				{
+					return archetype->IsChanged(chunk, column, last_run);
+				});
+
+			if (!changed) // run the changed chunks gathered so far and skip this one
+			{
+				if (first != begin)
+					System<Cs1...>::RunImpl(archetype, first, begin);
+
+				first = last;
+			}
+
+			begin = last;
+		}
+
+		if (first != end)
+			System<Cs1...>::RunImpl(archetype, first, end);
+	}
+}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <span>
+#include <array>
+#include <utility>
 #include <functional>
 #include <unordered_set>
 #include <algorithm>
@@ -41,6 +43,9 @@ namespace vlx
 		static constexpr ArchetypeID SystemID =
 			cu::ContainerHash<ComponentTypeID>{}(SystemIDs);
 
+		static constexpr auto ReadIDs	= GetAccessIDs<true, Cs1..., Cs2...>();
+		static constexpr auto WriteIDs	= GetAccessIDs<false, Cs1..., Cs2...>();
+
 	public:
 		SystemOptional() = delete;
 
@@ -92,6 +97,9 @@ namespace vlx
 		NODISC virtual ArchetypeID GetIDKey() const override		{ return SystemID; }
 		NODISC virtual ComponentIDSpan GetArchKey() const override	{ return SystemIDs; }
 
+		NODISC virtual ComponentIDSpan GetReadKey() const override	{ return ReadIDs; }
+		NODISC virtual ComponentIDSpan GetWriteKey() const override	{ return WriteIDs; }
+
 		/// Determines the priority of the system in the layer.
 		/// 
 		/// /param Value: priority value, for example, high value means that the system will likely be called first
@@ -209,38 +217,56 @@ namespace vlx
 		}
 
 	protected:
-		void Run(const Archetype* const archetype) const override 
+		void Run(const Archetype* const archetype, std::size_t begin, std::size_t end) const override 
 		{
 			assert(IsEnabled() && "System is disabled and cannot be run (EntityAdmin checks for this beforehand)");
 
 			if (m_func) // check if func stores callable object
-				RunImpl(archetype);
+				RunImpl(archetype, begin, end);
 		}
 
 		template<typename... Ts> requires (sizeof...(Ts) < (sizeof...(Cs1) + sizeof...(Cs2)))
-		void RunImpl(const Archetype* const archetype, Ts... cs) const 
+		void RunImpl(const Archetype* const archetype, std::size_t begin, std::size_t end, Ts... columns) const 
 		{
 			using ComponentType = std::tuple_element_t<sizeof...(Ts), ComponentTypes>; // get type of component at index in system components
 			static constexpr auto find_id = EntityAdmin::GetComponentID<ComponentType>();
 
-			auto i		 {0};
-			auto curr_id {archetype->type[i]};
-
-			while (curr_id != find_id && (i + 1) < archetype->type.size()) // iterate until matching component is found
-			{
-				curr_id = archetype->type[++i];
-			}
-
-			const bool found = (curr_id == find_id);
+			const std::size_t column = archetype->FindColumn(find_id); // optional components may be missing
 
-			// run again on next component, or call func
+			// run again on next component, or run the chunks
 			if constexpr ((sizeof...(Ts) + 1) != (sizeof...(Cs1) + sizeof...(Cs2)))
 			{
-				RunImpl(archetype, cs..., found ? reinterpret_cast<ComponentType*>(&archetype->component_data[i][0]) : nullptr);
+				RunImpl(archetype, begin, end, columns..., column);
 			}
 			else
 			{
-				m_func(archetype->entities, cs..., found ? reinterpret_cast<ComponentType*>(&archetype->component_data[i][0]) : nullptr);
+				RunChunks(archetype, begin, end, { columns..., column }, std::make_index_sequence<sizeof...(Cs1) + sizeof...(Cs2)>{});
+			}
+		}
+
+		template<std::size_t... Is>
+		void RunChunks(const Archetype* const archetype, std::size_t begin, std::size_t end, 
+			const std::array<std::size_t, sizeof...(Is)>& columns, std::index_sequence<Is...>) const
+		{
+			using AccessTypes = std::tuple<Cs1..., Cs2...>;
+
+			const std::size_t capacity	= archetype->chunk_capacity;
+			const uint32 tick			= GetRunTick();
+
+			while (begin < end) // func is called once for every chunk the range overlaps
+			{
+				const std::size_t chunk	= begin / capacity;
+				const std::size_t slot	= begin % capacity;
+				const std::size_t last	= std::min(end, (chunk + 1) * capacity);
+
+				((!std::is_const_v<std::tuple_element_t<Is, AccessTypes>> && columns[Is] != Archetype::NULL_COLUMN ? // mark the writable components
+					archetype->MarkChanged(chunk, columns[Is], tick) : void()), ...);
+
+				m_func(EntitySpan(archetype->entities).subspan(begin, last - begin),
+					((columns[Is] != Archetype::NULL_COLUMN) ? // optional components that are missing are given as nullptr
+						reinterpret_cast<std::tuple_element_t<Is, ComponentTypes>*>(archetype->GetColumn(chunk, columns[Is])) + slot : nullptr)...);
+
+				begin = last;
 			}
 		}
 
@@ -6,6 +6,7 @@
 
 #include <Velox/ECS/SystemAction.h>
 #include <Velox/ECS/System.hpp>
+#include <Velox/ECS/SystemChanged.hpp>
 
 #include <Velox/System/Vector2.hpp>
 
@@ -40,12 +41,12 @@ namespace vlx
 			GlobalTransformMatrix>;
 
 		using SyncLocalSystem			= System<Transform, TransformMatrix>;
-		using DirtyLocalSystem			= System<Transform, GlobalTransformDirty>;
+		using DirtyLocalSystem			= SystemChanged<System<Transform, GlobalTransformDirty>, Transform>;
 		using DirtyDescendantsSystem	= System<GlobalTransformDirty, Relation>;
 		using UpdateGlobalSystem		= System<TransformMatrix, GlobalTransformDirty, GlobalTransformMatrix, Relation>;
-		using UpdatePositionSystem		= System<GlobalTransformDirty, GlobalTransformMatrix, GlobalTransformTranslation>;
-		using UpdateRotationSystem		= System<GlobalTransformDirty, GlobalTransformMatrix, GlobalTransformRotation>;
-		using UpdateScaleSystem			= System<GlobalTransformDirty, GlobalTransformMatrix, GlobalTransformScale>;
+		using UpdatePositionSystem		= System<GlobalTransformDirty, const GlobalTransformMatrix, GlobalTransformTranslation>;
+		using UpdateRotationSystem		= System<GlobalTransformDirty, const GlobalTransformMatrix, GlobalTransformRotation>;
+		using UpdateScaleSystem			= System<GlobalTransformDirty, const GlobalTransformMatrix, GlobalTransformScale>;
 
 	public:
 		GlobalTransformSystem(EntityAdmin& entity_admin, LayerType id);
@@ -2,6 +2,7 @@
 
 #include <Velox/ECS/SystemAction.h>
 #include <Velox/ECS/System.hpp>
+#include <Velox/ECS/SystemChanged.hpp>
 
 #include <Velox/Graphics/Components/Transform.h>
 #include <Velox/Graphics/Components/TransformMatrix.h>
@@ -13,7 +14,7 @@ namespace vlx
 	class VELOX_API LocalTransformSystem final : public SystemAction
 	{
 	private:
-		using SyncLocalSystem = System<Transform, TransformMatrix>;
+		using SyncLocalSystem = SystemChanged<System<Transform, TransformMatrix>, Transform>; // only chunks with modified transforms
 
 	public:
 		LocalTransformSystem(EntityAdmin& entity_admin, LayerType id);
@@ -14,9 +14,12 @@
 #include "Physics/Collision/CollisionResult.h"
 #include "Physics/Collision/CollisionTable.h"
 #include "Physics/Collision/CollisionBody.h"
+#include "Physics/Collision/TimeOfImpact.h"
+#include "Physics/Collision/ShapeQueries.h"
 
 #include "Physics/PhysicsBody.h"
 #include "Physics/PhysicsCommon.hpp"
+#include "Physics/Islands.h"
 #include "Physics/PhysicsMaterial.h"
 
 #include "Physics/Systems/PhysicsDirtySystem.h"
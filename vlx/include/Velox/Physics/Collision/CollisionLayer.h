@@ -13,8 +13,8 @@ namespace vlx
 		constexpr void Add(std::size_t layer);
 		constexpr void Remove(std::size_t layer);
 
-		constexpr bool Has(std::size_t layer);
-		constexpr bool HasAny(std::size_t layers);
+		constexpr bool Has(std::size_t layer) const;
+		constexpr bool HasAny(std::size_t layers) const;
 
 	private:
 		std::size_t m_layer {~std::size_t(0)}; // collide with all by default
@@ -34,12 +34,12 @@ namespace vlx
 		m_layer &= ~layer;
 	}
 
-	constexpr bool CollisionLayer::Has(std::size_t layer)
+	constexpr bool CollisionLayer::Has(std::size_t layer) const
 	{
 		return (m_layer & layer) == layer;
 	}
 
-	constexpr bool CollisionLayer::HasAny(std::size_t layers)
+	constexpr bool CollisionLayer::HasAny(std::size_t layers) const
 	{
 		return (m_layer & layers) != 0;
 	}
@@ -27,6 +27,7 @@ namespace vlx
 			const Shape&, const SimpleTransform&, const Shape&, const SimpleTransform&)>, Shape::Count * Shape::Count>;
 
 		using Face = std::array<Vector2f, 2>;
+		using FaceIDs = std::array<uint32, 2>; // features that produced each point of a face
 		using VectorSpan = std::span<const Vector2f>;
 
 	public:
@@ -88,9 +89,9 @@ namespace vlx
 
 		static auto FindIncidentFace(
 			const SimpleTransform& t1, VectorSpan vs1, VectorSpan ns1,
-			const SimpleTransform& t2, const Vector2f& n2) -> Face;
+			const SimpleTransform& t2, const Vector2f& n2, FaceIDs& ids) -> Face;
 
-		static int Clip(Face& face, const Vector2f& n, float c);
+		static int Clip(Face& face, FaceIDs& ids, const Vector2f& n, float c, uint32 clip_id);
 
 	private:
 		static Matrix table;
@@ -12,11 +12,15 @@ namespace vlx
 	class VELOX_API LocalManifold
 	{
 	public:
+		static constexpr uint32 ID_CLIPPED	= 1 << 16; // point was created by clipping against a side of the reference face
+		static constexpr uint32 ID_FLIP		= 1 << 17; // reference face belongs to the second shape
+
 		struct Point
 		{
 			Vector2f	point;
 			float		impulse_normal	{0.0f};
 			float		impulse_tangent {0.0f};
+			uint32		id				{0};	// features that produced the point, same between steps if the contact persists
 		};
 
 		enum class Type
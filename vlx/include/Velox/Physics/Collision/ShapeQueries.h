@@ -0,0 +1,65 @@
+#pragma once
+
+#include <optional>
+
+#include <Velox/ECS/Identifiers.hpp>
+#include <Velox/System/SimpleTransform.h>
+#include <Velox/System/Rectangle.hpp>
+#include <Velox/System/Vector2.hpp>
+
+#include "../Shapes/Shape.h"
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+namespace vlx
+{
+	///	Segment from origin to origin + direction.
+	///
+	struct VELOX_API Ray
+	{
+		Vector2f origin;
+		Vector2f direction;
+	};
+
+	///	Where a ray or a moving shape first touches a collider.
+	///
+	struct VELOX_API QueryHit
+	{
+		EntityID	entity		{NULL_ENTITY};
+		Vector2f	point;
+		Vector2f	normal;					// surface normal of the collider that was hit
+		float		fraction	{1.0f};		// of the ray or translation travelled before the hit
+	};
+
+	///	Exact tests of rays and shapes against a single shape, used by the queries of the broad phase once the 
+	/// candidates have been found.
+	///
+	class VELOX_API ShapeQueries
+	{
+	public:
+		///	Casts the ray against the shape. Rays that start inside of the shape, as well as points, are never hit.
+		///
+		/// \returns Hit without the entity set, or nothing if the ray misses
+		///
+		NODISC static std::optional<QueryHit> RayCast(const Ray& ray, 
+			const Shape& shape, typename Shape::Type type, const SimpleTransform& transform);
+
+		///	Moves the first shape along the translation until it touches the second one, which is assumed to not move.
+		/// 
+		/// \returns Hit without the entity set, at fraction zero if the shapes already overlap, or nothing if they 
+		///			 never touch
+		///
+		NODISC static std::optional<QueryHit> ShapeCast(
+			const Shape& s1, typename Shape::Type st1, const SimpleTransform& t1, const Vector2f& translation,
+			const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2);
+
+		NODISC static bool Overlaps(
+			const Shape& s1, typename Shape::Type st1, const SimpleTransform& t1,
+			const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2);
+
+		///	Bounds of the shape when placed with the transform, including its radius.
+		///
+		NODISC static RectFloat ComputeAABB(const Shape& shape, typename Shape::Type type, const SimpleTransform& transform);
+	};
+}
\ No newline at end of file
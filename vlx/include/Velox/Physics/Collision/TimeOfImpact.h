@@ -0,0 +1,73 @@
+#pragma once
+
+#include <span>
+
+#include <SFML/System/Angle.hpp>
+
+#include <Velox/System/SimpleTransform.h>
+#include <Velox/System/Vector2.hpp>
+
+#include "../Shapes/Shape.h"
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+namespace vlx
+{
+	///	Motion of a body during a step, the position and rotation are interpolated linearly from start to end.
+	///
+	struct VELOX_API Sweep
+	{
+		NODISC SimpleTransform GetTransform(float t) const;
+
+		Vector2f	position_start;
+		Vector2f	position_end;
+		sf::Angle	rotation_start;
+		sf::Angle	rotation_end;
+	};
+
+	class VELOX_API TimeOfImpact
+	{
+	private:
+		using VectorSpan = std::span<const Vector2f>;
+
+		struct Proxy // convex core of a shape, the shape is every point within the radius of the core
+		{
+			VectorSpan	vertices;
+			VectorSpan	normals;
+			float		radius {0.0f};
+		};
+
+	public:
+		static constexpr int32 MAX_ITERATIONS = 20;
+
+		///	Finds when a moving shape first touches a still one, using conservative advancement. The moving shape is
+		/// stopped slightly within the other so that the contact is found by the narrow phase on the next step.
+		///
+		/// \param Sweep: Motion of the first shape
+		/// \param T2: Transform of the second shape, which is assumed to not move
+		///
+		/// \returns Fraction of the sweep at impact, or 1.0 if they never touch or already touch at the start
+		///
+		static float Compute(
+			const Shape& s1, typename Shape::Type st1, const Sweep& sweep,
+			const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2);
+
+		///	Distance between the surfaces of two shapes.
+		///
+		/// \returns Distance, negative if the shapes overlap
+		///
+		static float Distance(
+			const Shape& s1, const SimpleTransform& t1, typename Shape::Type st1,
+			const Shape& s2, const SimpleTransform& t2, typename Shape::Type st2);
+
+	private:
+		static Proxy GetProxy(const Shape& shape, typename Shape::Type type);
+
+		static float Distance(const Proxy& A, const SimpleTransform& t1, const Proxy& B, const SimpleTransform& t2);
+		static float SegmentDistance(const Vector2f& p1, const Vector2f& q1, const Vector2f& p2, const Vector2f& q2);
+		static float PointSegmentDistance(const Vector2f& p, const Vector2f& a, const Vector2f& b);
+
+		friend class ShapeQueries;
+	};
+}
\ No newline at end of file
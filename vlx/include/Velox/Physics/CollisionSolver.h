@@ -3,6 +3,7 @@
 #include <vector>
 #include <array>
 #include <span>
+#include <unordered_map>
 
 #include <Velox/System/Vector2.hpp>
 #include <Velox/System/Time.h>
@@ -10,29 +11,50 @@
 #include <Velox/Types.hpp>
 #include <Velox/Config.hpp>
 
+#include "SIMD.hpp"
+#include "Islands.h"
+
 namespace vlx
 {
 	class SimpleTransform;
 	class LocalManifold;
 	class CollisionBody;
+	class PhysicsBody;
 
+	///	Contact constraints between simd::WIDTH pairs of bodies that are solved at once. No two pairs in the same 
+	/// constraint share a moving body, so the lanes can read and write their bodies without interfering. Lanes that 
+	/// are left unused, or contacts beyond the ones in the manifold, have no mass and apply no impulse.
+	///
 	struct VELOX_API VelocityConstraint
 	{
 		struct Contact
 		{
-			Vector2f	ra;
-			Vector2f	rb;
-			float		mass_normal		{0.0f};
-			float		mass_tangent	{0.0f};
-			float		impulse_normal	{0.0f};
-			float		impulse_tangent	{0.0f};
+			simd::FloatL	ra_x;
+			simd::FloatL	ra_y;
+			simd::FloatL	rb_x;
+			simd::FloatL	rb_y;
+			simd::FloatL	mass_normal;
+			simd::FloatL	mass_tangent;
+			simd::FloatL	impulse_normal;
+			simd::FloatL	impulse_tangent;
+			simd::FloatL	velocity_bias;	// separating velocity wanted from restitution
+			simd::FloatL	separation;		// at the start of the step, negative when overlapping
 		};
 
 		std::array<Contact, 2>	contacts;
-		Vector2f				normal;
-		float					restitution		{0.0f};	// minimum TODO: allow user to change mode: min, max, or average
-		float					friction		{0.0f};	// average
-		int32					contacts_count	{0};
+		simd::FloatL			normal_x;
+		simd::FloatL			normal_y;
+		simd::FloatL			friction;		// average
+		simd::FloatL			inv_mass_a;		// zero for bodies that are not moved by the solver
+		simd::FloatL			inv_mass_b;
+		simd::FloatL			inv_inertia_a;
+		simd::FloatL			inv_inertia_b;
+
+		std::array<uint32, simd::WIDTH> body_a	{};	// solver body of every lane
+		std::array<uint32, simd::WIDTH> body_b	{};
+
+		uint32 moves_a	{0};	// mask of the lanes whose body is written back after solving
+		uint32 moves_b	{0};
 	};
 
 	struct VELOX_API PositionSolverManifold
@@ -44,6 +66,15 @@ namespace vlx
 		float		penetration	{0.0f};
 	};
 
+	///	Sequential impulse solver for the contacts. The velocities and masses of the bodies in contact are gathered into
+	/// compact arrays when the constraints are created, solved there, and written back to the bodies once afterwards.
+	/// 
+	/// The contacts can instead be solved as soft constraints over several sub-steps, where the bodies in contact are
+	/// also moved by the solver and the overlap is removed by the velocity passes rather than by a position pass.
+	/// 
+	/// The contacts of every batch are colored so that contacts of the same color share no moving body, contacts of 
+	/// one color are then solved simd::WIDTH at a time.
+	/// 
 	class VELOX_API CollisionSolver
 	{
 	private:
@@ -52,15 +83,141 @@ namespace vlx
 		using BodiesSpan	= std::span<const CollisionBody>;
 		using CollisionSpan = std::span<const CollisionPair>;
 		using ManifoldSpan	= std::span<const LocalManifold>;
+		using BatchSpan		= std::span<const Islands::Batch>;
+
+		static constexpr uint32 MAX_COLORS = 64; // contacts that do not fit in any color are solved one at a time
+
+		struct CachedContact // impulses of a pair kept from the previous step
+		{
+			struct Point
+			{
+				uint32	id				{0};
+				float	impulse_normal	{0.0f};
+				float	impulse_tangent	{0.0f};
+			};
+
+			std::array<Point, 2>	points;
+			int32					points_count	{0};
+			uint32					step			{0}; // last step the pair was stored
+		};
+
+		struct SolverBodies // bodies in contact this step, the first one stands in for every static body
+		{
+			std::vector<float>	velocity_x;
+			std::vector<float>	velocity_y;
+			std::vector<float>	angular_velocity;
+			std::vector<float>	inv_mass;	// zero for bodies that are not moved
+			std::vector<float>	inv_inertia;
+			std::vector<float>	position_x;	// at the start of the step
+			std::vector<float>	position_y;
+			std::vector<float>	rotation;
+			std::vector<float>	delta_x;	// moved so far by the sub-steps
+			std::vector<float>	delta_y;
+			std::vector<float>	delta_rotation;
+			std::vector<float>	external_x;	// velocity gained from gravity and forces over the step
+			std::vector<float>	external_y;
+			std::vector<float>	external_angular;
+			std::vector<uint64>	colors;		// colors already used by the contacts of the body
+			std::vector<uint32>	indices;	// index in the bodies span
+		};
+
+		struct SolverBatch
+		{
+			uint32 contacts_begin	{0};
+			uint32 contacts_end		{0};
+			uint32 constraints_begin{0};
+			uint32 constraints_end	{0};
+			uint32 bodies_begin		{0}; // solver bodies first added by the batch, every moving body belongs to one
+			uint32 bodies_end		{0};
+		};
+
+		struct Softness // coefficients of a contact that acts as a damped spring
+		{
+			float bias_rate		{0.0f};
+			float mass_scale	{1.0f};
+			float impulse_scale	{0.0f};
+		};
+
+		using ContactCache = std::unordered_map<uint64, CachedContact>;
 
 	public:
-		void CreateConstraints(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds);
-		void SetupConstraints(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds, const Time& time, const Vector2f& gravity);
+		///	Creates the constraints for this step, contacts that persist from the previous step start with the 
+		/// impulses they ended with. Reads the velocities of the bodies in contact, so it has to be called after 
+		/// they have been integrated.
+		/// 
+		/// \param Batches: Ranges of contacts that share no moving bodies with each other, such as separate islands
+		/// 
+		void CreateConstraints(BodiesSpan bodies, CollisionSpan collisions, BatchSpan batches);
 
-		void ResolveVelocity(BodiesSpan bodies, CollisionSpan collisions);
-		bool ResolvePosition(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds);
+		///	Computes the masses of the constraints and, if warm starting, loads the impulses from the previous step.
+		/// 
+		/// Setup and resolve only process the constraints of the given batch. Separate batches may therefore be 
+		/// processed concurrently.
+		/// 
+		void SetupConstraints(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds, 
+			const Time& time, const Vector2f& gravity, std::size_t batch);
+
+		///	Applies the impulses accumulated so far to the bodies.
+		/// 
+		void WarmStart(std::size_t batch);
+
+		void ResolveVelocity(std::size_t batch);
+
+		///	Solves the batch as soft contacts over several sub-steps, replaces both warm starting and resolving the 
+		/// velocities. Gravity and forces are spread over the sub-steps, so the velocities are expected to have been 
+		/// integrated over the whole step already.
+		/// 
+		/// \param SubSteps: Number of sub-steps the step is divided into
+		/// 
+		void SolveSubSteps(BodiesSpan bodies, const Time& time, const Vector2f& gravity, int sub_steps, std::size_t batch);
+
+		bool ResolvePosition(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds, std::size_t begin, std::size_t end);
+
+		///	Writes the solved velocities back to the bodies.
+		/// 
+		void StoreVelocities(BodiesSpan bodies);
+
+		///	Moves the bodies to where the sub-steps left them, has to be called after the positions of all bodies
+		/// have been integrated so that the solved bodies are not moved twice.
+		/// 
+		void StorePositions(BodiesSpan bodies);
+
+		///	Keeps the impulses of this step for the next one, pairs no longer in contact are forgotten.
+		/// 
+		void StoreImpulses(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds);
+
+		///	Forgets the impulses of every pair, e.g., when they are no longer comparable after switching solver.
+		/// 
+		void ClearImpulses();
+
+	public:
+		NODISC bool GetWarmStarting() const noexcept;
+		void SetWarmStarting(bool flag);
+
+	private:
+		uint32 AddSolverBody(BodiesSpan bodies, uint32 index);
+		void ColorBatch(CollisionSpan collisions, const Islands::Batch& batch);
+
+		void SolveSoft(const SolverBatch& batch, const Softness& softness, float inv_h, bool use_bias);
+		void ApplyRestitution(const SolverBatch& batch);
+
+		static Softness GetSoftness(float hertz, float damping_ratio, float h);
+
+		static bool IsMovable(const PhysicsBody& body);
+		static uint64 GetPairKey(const CollisionBody& A, const CollisionBody& B);
+		static uint32 GetCachedID(const CollisionBody& A, const CollisionBody& B, uint32 id);
 
 	private:
 		std::vector<VelocityConstraint> m_velocity_constraints;
+		std::vector<SolverBatch>		m_batches;
+		SolverBodies					m_solver_bodies;
+
+		std::vector<int32>				m_body_slots;		// solver body of every body, -1 if not in contact
+		std::vector<uint32>				m_contact_slots;	// constraint and lane of every contact, as constraint * WIDTH + lane
+		std::vector<uint32>				m_contact_colors;
+
+		ContactCache	m_contact_cache;
+		uint32			m_step			{0};
+		bool			m_warm_starting	{true};
 	};
 }
\ No newline at end of file
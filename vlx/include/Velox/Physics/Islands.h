@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+#include <span>
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+#include "Collision/LocalManifold.h"
+
+namespace vlx
+{
+	class CollisionBody;
+
+	///	Groups the dynamic bodies that are connected through contacts into islands. Islands do not share any dynamic
+	/// bodies, so they can be solved independently of each other on separate threads. Static and kinematic bodies are
+	/// never moved by the solver, and do therefore not connect islands.
+	///
+	/// Bodies in an island are woken and put to sleep together.
+	///
+	class VELOX_API Islands
+	{
+	public:
+		using CollisionPair		= std::pair<uint32, uint32>;
+		using CollisionList		= std::vector<CollisionPair>;
+		using LocalManifolds	= std::vector<LocalManifold>;
+
+		using BodiesSpan		= std::span<const CollisionBody>;
+		using CollisionSpan		= std::span<const CollisionPair>;
+		using ManifoldSpan		= std::span<const LocalManifold>;
+
+		static constexpr uint32 BATCH_SIZE = 64; // minimum contacts per batch, small islands are grouped together
+
+		struct Island
+		{
+			uint32 contacts_begin	{0};	// range in the sorted contacts
+			uint32 contacts_end		{0};
+			uint32 bodies_begin		{0};	// range in the island bodies
+			uint32 bodies_end		{0};
+		};
+
+		struct Batch // consecutive islands that are solved by the same thread
+		{
+			uint32 contacts_begin	{0};
+			uint32 contacts_end		{0};
+		};
+
+	public:
+		///	Finds the islands for this step and wakes every island that has an awake body in it. The contacts are
+		/// sorted so that the contacts of every island are next to each other.
+		///
+		/// \param Bodies: All of the bodies
+		/// \param Collisions: Pairs of bodies in contact, at least one body in every pair has to be dynamic
+		/// \param Manifolds: Manifold of every pair
+		///
+		void Build(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds);
+
+		///	Puts every island to sleep where all of the bodies have rested long enough.
+		///
+		void Sleep(BodiesSpan bodies);
+
+	public:
+		NODISC auto GetCollisions() const noexcept -> const CollisionList&;
+		NODISC auto GetManifolds() const noexcept -> const LocalManifolds&;
+
+		NODISC auto GetIslands() const noexcept -> std::span<const Island>;
+		NODISC auto GetBatches() const noexcept -> std::span<const Batch>;
+
+	private:
+		uint32 Find(uint32 i);
+		void Union(uint32 i, uint32 j);
+
+	private:
+		std::vector<uint32>		m_parents;		// union-find forest over the bodies
+		std::vector<int32>		m_island_ids;	// island of every root, -1 if not part of any island
+		std::vector<uint32>		m_offsets;		// used while counting sort
+
+		CollisionList			m_collisions;	// contacts sorted by island
+		LocalManifolds			m_manifolds;
+
+		std::vector<uint32>		m_bodies;		// bodies sorted by island
+		std::vector<Island>		m_islands;
+		std::vector<Batch>		m_batches;
+	};
+}
\ No newline at end of file
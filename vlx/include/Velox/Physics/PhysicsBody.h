@@ -26,7 +26,8 @@ namespace vlx
 			B_Awake			= 1 << 0,
 			B_AutoSleep		= 1 << 1,
 			B_FixedRotation = 1 << 2,
-			B_Enabled		= 1 << 3
+			B_Enabled		= 1 << 3,
+			B_Bullet		= 1 << 4
 		};
 
 	public:
@@ -58,6 +59,7 @@ namespace vlx
 		NODISC constexpr bool IsEnabled() const noexcept;
 		NODISC constexpr bool IsFixedRotation() const noexcept;
 		NODISC constexpr bool IsSleepingAllowed() const noexcept;
+		NODISC constexpr bool IsBullet() const noexcept;
 
 	public:
 		constexpr void SetType(const BodyType type);
@@ -95,6 +97,12 @@ namespace vlx
 		constexpr void SetFixedRotation(const bool flag);
 		constexpr void SetEnabled(const bool flag);
 
+		///	Bullets are swept against the other bodies at the end of every step and stopped at the first time of 
+		/// impact, preventing fast bodies from passing through thin ones. Costs more, so only use for bodies that 
+		/// move a large distance compared to their size in a single step.
+		/// 
+		constexpr void SetBullet(const bool flag);
+
 	private:
 		BodyType		m_type				{BodyType::Dynamic}; // type of body
 		uint16			m_flags				{B_Enabled | B_Awake | B_AutoSleep};
@@ -120,9 +128,11 @@ namespace vlx
 
 		float			m_gravity_scale		{1.0f};
 		float			m_sleep_time		{0.0f};
+		int32			m_island			{-1};			// island the body was solved in this step, -1 if not touching anything
 
 		friend class PhysicsSystem;
 		friend class CollisionSolver;
+		friend class Islands;
 	};
 
 	constexpr BodyType PhysicsBody::GetType() const noexcept				{ return m_type; }
@@ -151,6 +161,7 @@ namespace vlx
 	constexpr bool PhysicsBody::IsEnabled() const noexcept					{ return (m_flags & B_Enabled) == B_Enabled; }
 	constexpr bool PhysicsBody::IsFixedRotation() const noexcept			{ return (m_flags & B_FixedRotation) == B_FixedRotation; }
 	constexpr bool PhysicsBody::IsSleepingAllowed() const noexcept			{ return (m_flags & B_AutoSleep) == B_AutoSleep; }
+	constexpr bool PhysicsBody::IsBullet() const noexcept					{ return (m_flags & B_Bullet) == B_Bullet; }
 
 	constexpr void PhysicsBody::SetType(const BodyType type)
 	{
@@ -407,4 +418,12 @@ namespace vlx
 			// todo: tell broad phase to remove from quad tree
 		}
 	}
+
+	constexpr void PhysicsBody::SetBullet(const bool flag)
+	{
+		if (flag)
+			m_flags |= B_Bullet;
+		else
+			m_flags &= ~B_Bullet;
+	}
 }
\ No newline at end of file
@@ -17,7 +17,15 @@ namespace vlx
 	inline constexpr float P_MAX_CORRECTION				= 0.2f;
 	inline constexpr float P_BAUMGARTE					= 0.2f;
 
-	inline constexpr float P_AABB_INFLATE				= 1.05f;
+	inline constexpr float P_CONTACT_HERTZ				= 30.0f;	// stiffness of the soft contacts when sub-stepping
+	inline constexpr float P_CONTACT_DAMPING_RATIO		= 10.0f;
+	inline constexpr float P_CONTACT_PUSH_VELOCITY		= 10.0f;	// fastest that overlapping bodies are pushed apart
+
+	inline constexpr float P_AABB_MARGIN				= 2.0f;		// added on every side of the bounds stored in the trees
+	inline constexpr float P_AABB_DISPLACEMENT			= 2.0f;		// steps of motion that the bounds are extended ahead by
+	inline constexpr float P_AABB_MAX_DISPLACEMENT		= 64.0f;
+	inline constexpr float P_AABB_SHRINK				= 4.0f;		// bounds this many times larger in area than needed are refit
+	inline constexpr float P_GRID_CELL_SIZE				= 64.0f;
 
 	inline constexpr float P_POLYGON_RADIUS				= 2.0f * P_SLOP;
 }
\ No newline at end of file
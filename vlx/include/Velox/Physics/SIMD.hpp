@@ -0,0 +1,132 @@
+#pragma once
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#	define VELOX_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	include <emmintrin.h>
+#	define VELOX_SIMD_SSE2
+#endif
+
+#include <bit>
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+///	Minimal wide float used by the contact solver, maps to AVX2 or SSE2 depending on what the target is built for
+/// and otherwise falls back on plain loops that the compiler is free to vectorize. Comparisons return masks with 
+/// every bit of a lane set where they hold, which Select uses to pick between two values per lane.
+///
+namespace vlx::simd
+{
+#if defined(VELOX_SIMD_AVX2)
+	inline constexpr uint32 WIDTH = 8;
+
+	struct FloatW { __m256 v; };
+
+	NODISC inline FloatW Load(const float* src)				{ return { _mm256_load_ps(src) }; }
+	inline void Store(float* dst, FloatW a)					{ _mm256_store_ps(dst, a.v); }
+	NODISC inline FloatW Splat(float a)						{ return { _mm256_set1_ps(a) }; }
+
+	NODISC inline FloatW operator+(FloatW a, FloatW b)		{ return { _mm256_add_ps(a.v, b.v) }; }
+	NODISC inline FloatW operator-(FloatW a, FloatW b)		{ return { _mm256_sub_ps(a.v, b.v) }; }
+	NODISC inline FloatW operator*(FloatW a, FloatW b)		{ return { _mm256_mul_ps(a.v, b.v) }; }
+	NODISC inline FloatW operator-(FloatW a)				{ return { _mm256_sub_ps(_mm256_setzero_ps(), a.v) }; }
+
+	NODISC inline FloatW Min(FloatW a, FloatW b)			{ return { _mm256_min_ps(a.v, b.v) }; }
+	NODISC inline FloatW Max(FloatW a, FloatW b)			{ return { _mm256_max_ps(a.v, b.v) }; }
+
+	NODISC inline FloatW Greater(FloatW a, FloatW b)		{ return { _mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ) }; }
+
+	NODISC inline FloatW Select(FloatW mask, FloatW a, FloatW b) { return { _mm256_blendv_ps(b.v, a.v, mask.v) }; }
+#elif defined(VELOX_SIMD_SSE2)
+	inline constexpr uint32 WIDTH = 4;
+
+	struct FloatW { __m128 v; };
+
+	NODISC inline FloatW Load(const float* src)				{ return { _mm_load_ps(src) }; }
+	inline void Store(float* dst, FloatW a)					{ _mm_store_ps(dst, a.v); }
+	NODISC inline FloatW Splat(float a)						{ return { _mm_set1_ps(a) }; }
+
+	NODISC inline FloatW operator+(FloatW a, FloatW b)		{ return { _mm_add_ps(a.v, b.v) }; }
+	NODISC inline FloatW operator-(FloatW a, FloatW b)		{ return { _mm_sub_ps(a.v, b.v) }; }
+	NODISC inline FloatW operator*(FloatW a, FloatW b)		{ return { _mm_mul_ps(a.v, b.v) }; }
+	NODISC inline FloatW operator-(FloatW a)				{ return { _mm_sub_ps(_mm_setzero_ps(), a.v) }; }
+
+	NODISC inline FloatW Min(FloatW a, FloatW b)			{ return { _mm_min_ps(a.v, b.v) }; }
+	NODISC inline FloatW Max(FloatW a, FloatW b)			{ return { _mm_max_ps(a.v, b.v) }; }
+
+	NODISC inline FloatW Greater(FloatW a, FloatW b)		{ return { _mm_cmpgt_ps(a.v, b.v) }; }
+
+	NODISC inline FloatW Select(FloatW mask, FloatW a, FloatW b) { return { _mm_or_ps(_mm_and_ps(mask.v, a.v), _mm_andnot_ps(mask.v, b.v)) }; }
+#else
+	inline constexpr uint32 WIDTH = 4;
+
+	struct FloatW { float v[WIDTH]; };
+
+	template<class Func>
+	NODISC inline FloatW Apply(FloatW a, FloatW b, Func&& func)
+	{
+		FloatW result;
+		for (uint32 i = 0; i < WIDTH; ++i)
+			result.v[i] = func(a.v[i], b.v[i]);
+
+		return result;
+	}
+
+	NODISC inline FloatW Load(const float* src)
+	{
+		FloatW result;
+		for (uint32 i = 0; i < WIDTH; ++i)
+			result.v[i] = src[i];
+
+		return result;
+	}
+	inline void Store(float* dst, FloatW a)
+	{
+		for (uint32 i = 0; i < WIDTH; ++i)
+			dst[i] = a.v[i];
+	}
+	NODISC inline FloatW Splat(float a)
+	{
+		FloatW result;
+		for (uint32 i = 0; i < WIDTH; ++i)
+			result.v[i] = a;
+
+		return result;
+	}
+
+	NODISC inline FloatW operator+(FloatW a, FloatW b)		{ return Apply(a, b, [](float x, float y) { return x + y; }); }
+	NODISC inline FloatW operator-(FloatW a, FloatW b)		{ return Apply(a, b, [](float x, float y) { return x - y; }); }
+	NODISC inline FloatW operator*(FloatW a, FloatW b)		{ return Apply(a, b, [](float x, float y) { return x * y; }); }
+	NODISC inline FloatW operator-(FloatW a)				{ return Splat(0.0f) - a; }
+
+	// same as the instructions when the values are equal, such as zeros of different sign, so results do not differ by target
+
+	NODISC inline FloatW Min(FloatW a, FloatW b)			{ return Apply(a, b, [](float x, float y) { return (x < y) ? x : y; }); }
+	NODISC inline FloatW Max(FloatW a, FloatW b)			{ return Apply(a, b, [](float x, float y) { return (x > y) ? x : y; }); }
+
+	NODISC inline FloatW Greater(FloatW a, FloatW b)		{ return Apply(a, b, [](float x, float y) { return std::bit_cast<float>((x > y) ? ~0u : 0u); }); }
+
+	NODISC inline FloatW Select(FloatW mask, FloatW a, FloatW b)
+	{
+		FloatW result;
+		for (uint32 i = 0; i < WIDTH; ++i)
+			result.v[i] = (std::bit_cast<uint32>(mask.v[i]) != 0) ? a.v[i] : b.v[i];
+
+		return result;
+	}
+#endif
+
+	NODISC inline FloatW Clamp(FloatW a, FloatW lo, FloatW hi) { return Min(Max(a, lo), hi); }
+
+	///	Wide float stored in memory, aligned so that it can be loaded directly.
+	///
+	struct alignas(32) FloatL
+	{
+		float v[WIDTH] {};
+
+		NODISC FloatW Load() const		{ return simd::Load(v); }
+		void Store(FloatW a)			{ simd::Store(v, a); }
+	};
+}
\ No newline at end of file
@@ -2,9 +2,15 @@
 
 #include <vector>
 #include <unordered_map>
+#include <optional>
+#include <span>
 
 #include <Velox/ECS/System.hpp>
 
+#include <Velox/Algorithms/AABBTree.hpp>
+#include <Velox/Algorithms/SAP.hpp>
+#include <Velox/Algorithms/Grid.hpp>
+
 #include <Velox/Physics/Shapes/Shape.h>
 #include <Velox/Physics/Shapes/Circle.h>
 #include <Velox/Physics/Shapes/Box.h>
@@ -15,6 +21,8 @@
 #include <Velox/Types.hpp>
 
 #include <Velox/Physics/Collision/CollisionBody.h>
+#include <Velox/Physics/Collision/CollisionLayer.h>
+#include <Velox/Physics/Collision/ShapeQueries.h>
 
 #include "../PhysicsBody.h"
 #include "../BodyTransform.h"
@@ -32,6 +40,18 @@ namespace vlx
 	{
 	private:
 		static constexpr int NULL_BODY = -1;
+		static constexpr std::size_t BATCH_SIZE = 128; // bodies per job when searching for collisions in parallel
+		static constexpr std::size_t RAY_BATCH_SIZE = 32; // rays per job when casting many at once
+
+	public:
+		enum class Backend : uint8
+		{
+			QuadTree,	// loose quadtree with fixed bounds, bodies outside of them are never found
+			AABBTree,		// dynamic tree without bounds
+			SweepAndPrune,	// sorted endpoints kept between updates, suited for many slowly moving bodies. Queries search
+							// the bodies along x from the widest body before the area, so wide bodies slow every query
+			Grid			// hashed uniform grid rebuilt every update, suited for many fast moving bodies of similar size
+		};
 
 	public:
 		using CollisionPair			= std::pair<uint32, uint32>;
@@ -41,14 +61,82 @@ namespace vlx
 		using BodyList				= std::vector<CollisionBody>;
 
 		using QuadTreeType			= typename QTBody::QuadTreeType;
+		using AABBTreeType			= AABBTree<uint32>;
+		using SAPType				= SAP<uint32>;
+		using GridType				= Grid<uint32>;
 
 		using InsertSystem			= System<ColliderAABB, QTBody>;
 
 	public:
-		BroadSystem(EntityAdmin& entity_admin);
+		BroadSystem(EntityAdmin& entity_admin, Backend backend = Backend::QuadTree);
+
+	public:
+		///	Finds every potential pair for the coming step. The bounds of bullets are swept along their velocity, 
+		/// so that everything they might hit during the step is found.
+		/// 
+		void Update(float time_step);
+
+		///	Switches the structure used for finding potential collisions. Bodies are moved over to the new structure
+		/// on the next update.
+		///
+		void SetBackend(Backend backend);
+		NODISC Backend GetBackend() const noexcept;
+
+		///	Number of bodies that were inserted or reinserted into the quadtree or the AABB tree in the last update, 
+		/// the other backends do not keep enlarged bounds and are not counted.
+		///
+		NODISC uint32 GetReinsertCount() const noexcept;
+
+		///	Keeps the bodies sorted by entity and the potential pairs sorted by body, so that the order no longer 
+		/// depends on when bodies were added and removed or how the structures were built up. Costs a sort of the 
+		/// pairs every update, and of the bodies whenever any have been added or removed.
+		///
+		void SetDeterministic(bool flag);
+		NODISC bool GetDeterministic() const noexcept;
 
 	public:
-		void Update();
+		///	Finds the closest collider hit by the ray. The colliders are as they were at the end of the last step.
+		/// 
+		/// \param Ray: Segment to cast
+		/// \param Layer: Only colliders that share any layer with it are considered
+		/// 
+		/// \returns Closest hit, or nothing if the ray hits nothing
+		/// 
+		NODISC std::optional<QueryHit> RayCast(const Ray& ray, CollisionLayer layer = {}) const;
+
+		///	Casts every ray, split across the worker threads. Suited for many independent rays at once, such as 
+		/// line of sight checks for every agent.
+		/// 
+		/// \param Rays: Segments to cast
+		/// \param Hits: Closest hit of every ray, has to be at least as large as the rays
+		/// \param Layer: Only colliders that share any layer with it are considered
+		/// 
+		void RayCast(std::span<const Ray> rays, std::span<std::optional<QueryHit>> hits, CollisionLayer layer = {}) const;
+
+		///	Moves the shape along the translation and finds the first collider it touches.
+		/// 
+		/// \param Transform: Where the shape starts
+		/// \param Translation: How far the shape is moved
+		/// \param Layer: Only colliders that share any layer with it are considered
+		/// 
+		/// \returns First hit, at fraction zero if the shape already overlaps a collider, or nothing if it hits nothing
+		/// 
+		NODISC std::optional<QueryHit> ShapeCast(const Shape& shape, typename Shape::Type type, 
+			const SimpleTransform& transform, const Vector2f& translation, CollisionLayer layer = {}) const;
+
+		///	Finds every collider that overlaps the shape.
+		/// 
+		/// \param Transform: Where the shape is placed
+		/// \param Layer: Only colliders that share any layer with it are considered
+		/// 
+		/// \returns Entities of the overlapping colliders
+		/// 
+		NODISC std::vector<EntityID> Overlap(const Shape& shape, typename Shape::Type type, 
+			const SimpleTransform& transform, CollisionLayer layer = {}) const;
+
+		///	Finds every collider that overlaps the circle.
+		/// 
+		NODISC std::vector<EntityID> Overlap(const Vector2f& center, float radius, CollisionLayer layer = {}) const;
 
 	public:
 		auto GetBodies() const noexcept -> const BodyList&;
@@ -62,14 +150,33 @@ namespace vlx
 
 	private:
 		void InsertAABB(EntityID entity_id, ColliderAABB& ab, QTBody& qtb);
+		void UpdateTree();
+		void UpdateSAP();
+		void UpdateGrid();
 
-		void GatherCollisions();
-		void CullDuplicates();
+		template<class Tree>
+		void GatherCollisions(const Tree& tree);
+		void GatherPairs();
+
+		void SortBodies();
+
+		template<typename Func>
+		void VisitBodies(const RectFloat& rect, Func&& func) const;
+		template<typename Func>
+		void VisitBodies(const Ray& ray, Func&& func) const;
+
+		static bool IsQueryable(const CollisionBody& body, CollisionLayer layer);
+		static SimpleTransform GetTransform(const CollisionBody& body);
 
 		int CreateBody(EntityID eid, Shape* shape, typename Shape::Type type);
 		int FindBody(EntityID eid);
 		void RemoveBody(EntityID eid);
 
+		RectFloat GetSweptAABB(const RectFloat& aabb, const PhysicsBody* body) const;
+		RectFloat GetFatAABB(const RectFloat& aabb, const PhysicsBody* body) const;
+
+		static bool IsOversized(const RectFloat& stored, const RectFloat& fat);
+
 		static bool HasDataForCollision(const CollisionBody& body);
 
 		void RegisterEvents();
@@ -79,11 +186,21 @@ namespace vlx
 		InsertSystem			m_insert;
 
 		QuadTreeType			m_quad_tree;
+		AABBTreeType			m_aabb_tree;
+		SAPType					m_sap;
+		GridType				m_grid;
+		Backend					m_backend		{Backend::QuadTree};
+		float					m_time_step		{0.0f};
+		uint32					m_reinsert_count{0};
+		bool					m_deterministic	{false};
+		bool					m_order_dirty	{false};	// bodies have been added or removed since they were last sorted
 
 		EntityBodyMap			m_entity_body_map;
 		BodyList				m_bodies; // TODO: maybe separate to distinct class?
+		std::vector<int>		m_proxies; // proxy in the aabb tree, sap, or grid for each body, null if not inserted
 
-		CollisionList			m_collisions;
+		CollisionList			m_collisions;		// every potential pair once, with the lower body index first
+		std::vector<CollisionList>	m_batch_collisions;	// collisions found by every batch of bodies, merged in order
 
 		std::vector<EventID>	m_event_ids;
 
@@ -25,7 +25,23 @@ namespace vlx
 		using CollisionList		= std::vector<CollisionPair>;
 		using LocalManifolds	= std::vector<LocalManifold>;
 
+		static constexpr std::size_t BATCH_SIZE = 64; // pairs per job when colliding in parallel
+
 	private:
+		struct CollisionEvent // pair whose callbacks are called once every pair has been collided
+		{
+			uint32			l {0};
+			uint32			r {0};
+			LocalManifold	manifold;
+		};
+
+		struct Batch // results of one job, merged in order so that they do not depend on how the jobs were run
+		{
+			CollisionList				collisions;
+			LocalManifolds				manifolds;
+			std::vector<CollisionEvent> events;
+		};
+
 		struct CollisionEventPair
 		{
 			using ExitRef = ComponentRef<ColliderExit>;
@@ -63,6 +79,9 @@ namespace vlx
 		NarrowSystem(EntityAdmin& entity_admin);
 
 	public:
+		///	Collides the pairs found by the broad phase on the worker threads, the collision callbacks are called 
+		/// afterwards from the calling thread.
+		/// 
 		void Update(BroadSystem& broad);
 
 	public:
@@ -73,7 +92,8 @@ namespace vlx
 		auto GetManifolds() noexcept -> LocalManifolds&;
 
 	private:
-		void CheckCollision(BroadSystem& broad, uint32 l, uint32 r);
+		void CheckCollision(const BroadSystem& broad, uint32 l, uint32 r, Batch& batch) const;
+		void DispatchEvent(const BroadSystem& broad, const CollisionEvent& event);
 
 	private:
 		EntityAdmin*			m_entity_admin	{nullptr};
@@ -81,6 +101,8 @@ namespace vlx
 		CollisionList			m_collisions;
 		LocalManifolds			m_manifolds;
 
+		std::vector<Batch>		m_batches;
+
 		std::vector<EntityPair> m_curr_collisions; // TODO: fix this
 		std::vector<EntityPair> m_prev_collisions;
 		std::vector<EntityPair> m_difference;
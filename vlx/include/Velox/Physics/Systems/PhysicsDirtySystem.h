@@ -5,6 +5,7 @@
 
 #include <Velox/ECS/SystemAction.h>
 #include <Velox/ECS/System.hpp>
+#include <Velox/ECS/SystemChanged.hpp>
 
 #include <Velox/Physics/Shapes/Shape.h>
 #include <Velox/Physics/Shapes/Circle.h>
@@ -21,11 +22,11 @@ namespace vlx
 	class VELOX_API PhysicsDirtySystem final : public SystemAction
 	{
 	public:
-		using DirtyLocalSystem	= System<Collider, Transform>;
-		using CircleSystem		= System<Circle, Collider, ColliderAABB, Transform>;
-		using BoxSystem			= System<Box, Collider, ColliderAABB, TransformMatrix>;
-		using PointSystem		= System<Point, Collider, ColliderAABB>;
-		using PolySystem		= System<Polygon, Collider, ColliderAABB, TransformMatrix>;
+		using DirtyLocalSystem	= SystemChanged<System<Collider, const Transform>, Transform>;
+		using CircleSystem		= SystemChanged<System<const Circle, Collider, ColliderAABB, const Transform>, Collider>;
+		using BoxSystem			= SystemChanged<System<const Box, Collider, ColliderAABB, const TransformMatrix>, Collider>;
+		using PointSystem		= SystemChanged<System<const Point, Collider, ColliderAABB>, Collider>;
+		using PolySystem		= SystemChanged<System<const Polygon, Collider, ColliderAABB, const TransformMatrix>, Collider>;
 
 	public:
 		PhysicsDirtySystem(EntityAdmin& entity_admin, LayerType id);
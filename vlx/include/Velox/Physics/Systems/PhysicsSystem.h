@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <span>
+#include <optional>
 
 #include <Velox/ECS/SystemAction.h>
 #include <Velox/ECS/System.hpp>
@@ -18,6 +19,11 @@
 #include "../BodyLastTransform.h"
 #include "../PhysicsCommon.hpp"
 #include "../CollisionSolver.h"
+#include "../Islands.h"
+
+#include "../Collision/TimeOfImpact.h"
+#include "../Collision/ShapeQueries.h"
+#include "../Collision/CollisionLayer.h"
 
 #include "BroadSystem.h"
 #include "NarrowSystem.h"
@@ -26,6 +32,22 @@ namespace vlx
 {
 	class VELOX_API PhysicsSystem final : public SystemAction
 	{
+	public:
+		enum class SolverType
+		{
+			SequentialImpulse,	// velocity iterations followed by position iterations once per step
+			SoftStep			// soft contacts solved over several sub-steps, with the collisions found once per step
+		};
+
+	private:
+		static constexpr std::size_t BULLET_BATCH_SIZE = 16; // bullets per job when sweeping in parallel
+
+		struct Bullet
+		{
+			uint32	index {0};	// in the broad phase bodies
+			Sweep	sweep;
+		};
+
 	public:
 		PhysicsSystem(EntityAdmin& entity_admin, LayerType id, Time& time);
 
@@ -39,24 +61,88 @@ namespace vlx
 		void SetVelocityIterations(int iterations);
 		void SetPositionIterations(int iterations);
 
+		///	Starts the solver with the impulses from the previous step for contacts that persist, lets stacks 
+		/// settle with far fewer velocity iterations. Enabled by default.
+		/// 
+		void SetWarmStarting(bool flag);
+
+		///	Sets how the contacts are solved, can be changed between any two steps.
+		/// 
+		void SetSolverType(SolverType type);
+		NODISC SolverType GetSolverType() const noexcept;
+
+		///	Number of sub-steps the step is divided into when solving with SolverType::SoftStep, more sub-steps give 
+		/// stiffer stacks at roughly the cost of a velocity iteration each.
+		/// 
+		void SetSubSteps(int sub_steps);
+
+		///	Makes the steps reproducible, given the same bodies created and removed in the same order and the same 
+		/// inputs every step. The bodies and pairs are kept in a fixed order and the state is hashed after every 
+		/// step. Results only match across machines when built with the VeloxDeterministic property, which compiles 
+		/// with strict floating point, keeps the runtime from using the FMA3 math functions and enables this by default.
+		/// 
+		void SetDeterministic(bool flag);
+		NODISC bool GetDeterministic() const noexcept;
+
+		///	Hash of the transform and physics body of every body after the last step, compare with the hash from 
+		/// another machine or run to find the step where they diverged. Only computed when deterministic.
+		/// 
+		NODISC uint64 GetStateHash() const noexcept;
+
+		///	Switches the structure used for finding potential collisions, see BroadSystem::Backend.
+		/// 
+		void SetBroadPhase(BroadSystem::Backend backend);
+		NODISC BroadSystem::Backend GetBroadPhase() const noexcept;
+
+		///	Broad phase of the physics, e.g., for inspecting the potential pairs found in the last step.
+		/// 
+		NODISC const BroadSystem& GetBroadSystem() const noexcept;
+
+	public:
+		///	Queries against the colliders as of the last step, see the queries of BroadSystem.
+		/// 
+		NODISC std::optional<QueryHit> RayCast(const Ray& ray, CollisionLayer layer = {}) const;
+		void RayCast(std::span<const Ray> rays, std::span<std::optional<QueryHit>> hits, CollisionLayer layer = {}) const;
+
+		NODISC std::optional<QueryHit> ShapeCast(const Shape& shape, typename Shape::Type type, 
+			const SimpleTransform& transform, const Vector2f& translation, CollisionLayer layer = {}) const;
+
+		NODISC std::vector<EntityID> Overlap(const Shape& shape, typename Shape::Type type, 
+			const SimpleTransform& transform, CollisionLayer layer = {}) const;
+		NODISC std::vector<EntityID> Overlap(const Vector2f& center, float radius, CollisionLayer layer = {}) const;
+
 	private:
 		void IntegrateVelocity(PhysicsBody& pb) const;
 		void IntegratePosition(PhysicsBody& pb, BodyTransform& bt) const;
 		void SleepBodies(PhysicsBody& pb) const;
 
+		void GatherBullets();
+		void SolveBullets();
+
 		void PreSolve(BodyTransform& pbt, BodyLastTransform& blt, const Transform& t) const;
 		void PostSolve(const BodyTransform& pbt, Transform& t) const;
 
+		NODISC uint64 ComputeStateHash() const;
+
 	private:
 		Time*			m_time			{nullptr};
 		Vector2f		m_gravity		{0.0f, 60.82f};
 
-		int				m_velocity_iterations	{20};
+		int				m_velocity_iterations	{8}; // warm starting lets this stay low, stacks of ten boxes stay up in the tests
 		int				m_position_iterations	{10};
+		int				m_sub_steps				{4};
+		SolverType		m_solver_type			{SolverType::SequentialImpulse};
+		bool			m_deterministic			{false};
+		uint64			m_state_hash			{0};
 
 		BroadSystem		m_broad_system;
 		NarrowSystem	m_narrow_system;
 		CollisionSolver	m_collision_solver;
+		Islands			m_islands;
+
+		std::vector<Bullet>						m_bullets;
+		std::vector<int32>						m_bullet_indices;		// bullet of every body, -1 if not one
+		std::vector<std::pair<uint32, uint32>>	m_bullet_candidates;	// bullet and body it may hit, sorted by bullet
 
 		System<PhysicsBody>					m_integrate_velocity;
 		System<PhysicsBody, BodyTransform>	m_integrate_position;
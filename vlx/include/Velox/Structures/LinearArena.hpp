@@ -0,0 +1,90 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#include <Velox/Config.hpp>
+
+namespace vlx
+{
+	///	Bump allocator that hands out memory from large blocks. Memory is never freed individually, instead everything
+	/// is released at once by resetting the arena, which keeps the blocks around so that they can be reused without
+	/// allocating again. Only meant for trivial types since no destructors are called.
+	///
+	class LinearArena
+	{
+	private:
+		struct Block
+		{
+			std::unique_ptr<std::byte[]>	data;
+			std::size_t						size {0};
+		};
+
+	public:
+		///	\param BlockSize: Size in bytes of every block, larger allocations are given a block of their own
+		///
+		explicit LinearArena(std::size_t block_size = 16 * 1024)
+			: m_block_size(block_size) {}
+
+	public:
+		///	\returns Uninitialized memory for count objects of T, remains valid until the arena is reset
+		///
+		template<class T> requires std::is_trivially_destructible_v<T>
+		NODISC T* Allocate(std::size_t count)
+		{
+			return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		///	\returns Uninitialized memory of size with the specified alignment, remains valid until the arena is reset
+		///
+		NODISC void* Allocate(std::size_t size, std::size_t alignment)
+		{
+			while (m_block < m_blocks.size())
+			{
+				Block& block = m_blocks[m_block];
+
+				void* ptr			= block.data.get() + m_offset;
+				std::size_t space	= block.size - m_offset;
+
+				if (std::align(alignment, size, ptr, space) != nullptr)
+				{
+					m_offset = block.size - space + size;
+					return ptr;
+				}
+
+				++m_block; // move on to the next block that has been kept from before
+				m_offset = 0;
+			}
+
+			const std::size_t block_size = std::max(m_block_size, size + alignment);
+			m_blocks.emplace_back(std::make_unique_for_overwrite<std::byte[]>(block_size), block_size);
+
+			return Allocate(size, alignment); // guaranteed to fit in the new block
+		}
+
+		///	Releases all of the allocations while keeping the blocks for reuse.
+		///
+		void Reset() noexcept
+		{
+			m_block		= 0;
+			m_offset	= 0;
+		}
+
+		///	Releases all of the allocations and frees the blocks.
+		///
+		void Release() noexcept
+		{
+			m_blocks.clear();
+			Reset();
+		}
+
+	private:
+		std::vector<Block>	m_blocks;
+		std::size_t			m_block			{0};	// block currently allocated from
+		std::size_t			m_offset		{0};	// offset into the current block
+		std::size_t			m_block_size	{0};
+	};
+}
\ No newline at end of file
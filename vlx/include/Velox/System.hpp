@@ -6,4 +6,6 @@
 #include "System/Traits.h"
 #include "System/IDGenerator.h"
 #include "System/Event.hpp"
-#include "System/EventHandler.hpp"
\ No newline at end of file
+#include "System/EventHandler.hpp"
+#include "System/ThreadPool.h"
+#include "System/Profiler.h"
\ No newline at end of file
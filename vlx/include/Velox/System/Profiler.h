@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+
+#include <Velox/Types.hpp>
+#include <Velox/Config.hpp>
+
+#define VELOX_PROFILE_CONCAT_IMPL(x, y) x##y
+#define VELOX_PROFILE_CONCAT(x, y) VELOX_PROFILE_CONCAT_IMPL(x, y)
+
+#if VELOX_PROFILE
+#	define VELOX_PROFILE_SCOPE(name) const ::vlx::ProfileScope VELOX_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
+#else
+#	define VELOX_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+namespace vlx
+{
+	///	Records timed zones that may be nested to form a hierarchy. Every thread records into a ring buffer of its own,
+	/// so recording takes no locks and only ever touches memory owned by the calling thread. When the buffer is full,
+	/// the oldest zones are overwritten.
+	///
+	/// Zones are kept in memory until written out as Chrome trace JSON, which can be opened with chrome://tracing
+	/// or Perfetto. Recording is disabled by default and costs a single relaxed load per zone while disabled.
+	///
+	class Profiler
+	{
+	public:
+		static constexpr std::size_t ZONE_CAPACITY	= 1 << 16; // zones kept per thread, has to be a power of two
+		static constexpr std::size_t MAX_DEPTH		= 64;
+
+		struct Zone
+		{
+			const char*	name	{nullptr};	// has to outlive the profiler, e.g., a string literal
+			uint64		begin	{0};		// nanoseconds since the profiler was first used
+			uint64		end		{0};
+			uint32		depth	{0};		// number of zones this zone is nested in
+		};
+
+	public:
+		Profiler() = delete;
+
+	public:
+		NODISC VELOX_API static bool IsEnabled() noexcept;
+		VELOX_API static void SetEnabled(bool flag) noexcept;
+
+		///	\returns Nanoseconds since the profiler was first used, monotonic and shared across threads
+		///
+		NODISC VELOX_API static uint64 Now() noexcept;
+
+	public:
+		///	Opens a zone on the calling thread, has to be matched by a call to EndZone on the same thread.
+		///
+		/// \param Name: Name of the zone, has to outlive the profiler
+		///
+		VELOX_API static void BeginZone(const char* name);
+
+		///	Closes the most recently opened zone on the calling thread.
+		///
+		VELOX_API static void EndZone();
+
+		///	Copies the name into storage that lasts for the rest of the program, for zone names that are only known
+		/// at runtime. Interning the same name again returns the same pointer.
+		///
+		NODISC VELOX_API static const char* Intern(std::string_view name);
+
+	public:
+		///	\returns Copy of the zones currently kept for every thread that has recorded, oldest first
+		///
+		NODISC VELOX_API static std::vector<std::vector<Zone>> GetZones();
+
+		///	Discards all of the recorded zones.
+		///
+		VELOX_API static void Clear();
+
+		///	Writes all of the recorded zones as complete events in the Chrome trace format. Zones that are recorded
+		/// while writing may or may not be included.
+		///
+		/// \param Path: Path of the file to write to
+		///
+		/// \returns True if the file could be written to
+		///
+		VELOX_API static bool WriteChromeTrace(std::string_view path);
+	};
+
+	///	Records a zone that lasts for the lifetime of the scope.
+	///
+	class ProfileScope
+	{
+	public:
+		explicit ProfileScope(const char* name)
+			: m_active(Profiler::IsEnabled())
+		{
+			if (m_active)
+				Profiler::BeginZone(name);
+		}
+
+		~ProfileScope()
+		{
+			if (m_active) // also closes the zone if profiling was disabled in the meantime
+				Profiler::EndZone();
+		}
+
+		ProfileScope(const ProfileScope&) = delete;
+		ProfileScope& operator=(const ProfileScope&) = delete;
+
+	private:
+		bool m_active {false};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <concepts>
+#include <exception>
+
+#include <Velox/Utility/NonCopyable.h>
+#include <Velox/Config.hpp>
+
+namespace vlx
+{
+	///	Work-stealing thread pool owned by the engine. Every worker has its own queue of jobs and will steal
+	/// from the other queues once its own has run dry. The thread that submits work will also help with
+	/// executing the jobs while waiting, meaning that nested calls from inside of a job will not deadlock.
+	///
+	class VELOX_API ThreadPool final : private NonCopyable
+	{
+	public:
+		using RangeFunc = void(*)(void* data, std::size_t begin, std::size_t end);
+
+	private:
+		struct Batch // state of a single call to ParallelFor, lives on the stack of the caller
+		{
+			std::atomic<std::size_t>	pending		{0};
+			std::atomic<bool>			failed		{false};
+			std::exception_ptr			exception;	// first exception thrown by any of the jobs
+		};
+
+		struct Job
+		{
+			RangeFunc	func	{nullptr};
+			void*		data	{nullptr};
+			std::size_t	begin	{0};
+			std::size_t	end		{0};
+			Batch*		batch	{nullptr};
+		};
+
+		struct JobQueue
+		{
+			std::mutex		mutex;
+			std::deque<Job>	jobs;
+		};
+
+		using QueuePtr = std::unique_ptr<JobQueue>;
+
+	public:
+		///	\param ThreadCount: Number of worker threads to create, the calling thread is not included
+		///
+		explicit ThreadPool(std::size_t thread_count = GetDefaultThreadCount());
+		~ThreadPool();
+
+	public:
+		///	\returns Number of threads that may execute jobs, including the calling thread
+		///
+		NODISC std::size_t GetThreadCount() const noexcept;
+
+		///	\returns Index of the current thread, zero for threads not owned by any pool, [1, count) for workers
+		///
+		NODISC static std::size_t GetThreadIndex() noexcept;
+
+		///	\returns The number of workers that is suitable for this machine
+		///
+		NODISC static std::size_t GetDefaultThreadCount() noexcept;
+
+	public:
+		///	Splits the range [0, count) into jobs of grain size and executes them over all the threads. Returns
+		/// once every job has been completed.
+		///
+		/// \param Count: Total number of elements in the range
+		/// \param GrainSize: Maximum number of elements that are processed per job
+		/// \param Func: Function called with the subrange [begin, end) that should be processed
+		///
+		/// If any job throws, the remaining jobs are still run and the first exception is rethrown once they are done.
+		///
+		template<typename Func> requires std::invocable<Func&, std::size_t, std::size_t>
+		void ParallelFor(std::size_t count, std::size_t grain_size, Func&& func);
+
+	private:
+		void Submit(RangeFunc func, void* data, std::size_t count, std::size_t grain_size, Batch& batch);
+		void Wait(const Batch& batch);
+
+		bool TryPop(std::size_t index, Job& job);
+		bool TrySteal(std::size_t index, Job& job, bool block = false);
+
+		void Execute(const Job& job);
+		void WorkerLoop(std::size_t index);
+
+	private:
+		std::vector<std::thread>	m_workers;
+		std::vector<QueuePtr>		m_queues;		// one queue per worker, index zero is shared by external threads
+
+		std::atomic<std::size_t>	m_queued {0};	// number of jobs waiting in the queues
+		std::mutex					m_mutex;
+		std::condition_variable		m_cv;			// workers waiting for jobs
+		std::condition_variable		m_done_cv;		// callers waiting for their batch to complete
+		bool						m_stop {false};
+	};
+
+	template<typename Func> requires std::invocable<Func&, std::size_t, std::size_t>
+	inline void ThreadPool::ParallelFor(std::size_t count, std::size_t grain_size, Func&& func)
+	{
+		if (count == 0)
+			return;
+
+		grain_size = std::max<std::size_t>(grain_size, 1);
+
+		if (m_workers.empty() || count <= grain_size) // not worth distributing
+		{
+			func(std::size_t(0), count);
+			return;
+		}
+
+		using FuncType = std::remove_reference_t<Func>;
+
+		const RangeFunc invoke = [](void* data, std::size_t begin, std::size_t end)
+		{
+			(*static_cast<FuncType*>(data))(begin, end);
+		};
+
+		Batch batch;
+
+		Submit(invoke, const_cast<void*>(static_cast<const void*>(std::addressof(func))), count, grain_size, batch);
+		Wait(batch);
+
+		if (batch.exception)
+			std::rethrow_exception(batch.exception);
+	}
+}
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include "Utility/Random.h"
 #include "Utility/ArithmeticUtils.h"
 #include "Utility/ContainerUtils.h"
-#include "Utility/Benchmark.h"
 #include "Utility/PolicySelect.h"
 #include "Utility/NonCopyable.h"
 #include "Utility/FPSCounter.h"
\ No newline at end of file
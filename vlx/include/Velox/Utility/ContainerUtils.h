@@ -176,7 +176,7 @@ namespace vlx::cu
 	template<typename T>
 	inline bool InsertUniqueSorted(std::vector<T>& vec, const T& item)
 	{
-		const auto it = std::ranges::upper_bound(vec, item);
+		const auto it = std::ranges::lower_bound(vec, item); // upper bound would point past an equal item
 
 		if (it == vec.cend() || *it != item)
 		{
@@ -190,7 +190,7 @@ namespace vlx::cu
 	template<typename T, typename Comp>
 	inline bool InsertUniqueSorted(std::vector<T>& vec, const T& item, Comp&& comparison)
 	{
-		const auto it = std::ranges::upper_bound(vec, item, std::forward<Comp>(comparison));
+		const auto it = std::ranges::lower_bound(vec, item, std::forward<Comp>(comparison));
 
 		if (it == vec.cend() || *it != item)
 		{
@@ -275,6 +275,27 @@ namespace vlx::cu
 		return std::ranges::is_sorted(items, std::forward<Comp>(comp));
 	}
 
+	/// Checks if two sorted ranges share any element
+	/// 
+	template<typename T>
+	NODISC constexpr bool HasIntersection(std::span<const T> lhs, std::span<const T> rhs)
+	{
+		auto it1 = lhs.begin();
+		auto it2 = rhs.begin();
+
+		while (it1 != lhs.end() && it2 != rhs.end())
+		{
+			if (*it1 < *it2)
+				++it1;
+			else if (*it2 < *it1)
+				++it2;
+			else
+				return true;
+		}
+
+		return false;
+	}
+
 	template<typename T, typename U, typename V>
 	NODISC constexpr V Merge(const T& r1, const U& r2)
 	{
@@ -1,11 +1,9 @@
 #pragma once
 
-#include <variant>
-#include <array>
-#include <queue>
+#include <vector>
 
 #include <Velox/ECS.hpp>
-#include <Velox/System/Traits.h>
+#include <Velox/ECS/CommandBuffer.h>
 #include <Velox/Types.hpp>
 #include <Velox/Config.hpp>
 
@@ -27,42 +25,6 @@ namespace vlx
 			S_Count
 		};
 
-	private:
-		struct AddCompData
-		{
-			EntityID		entity_id;
-			ComponentTypeID component_id;
-		};
-
-		struct AddCompsData
-		{
-			EntityID		entity_id;
-			ComponentIDs	component_ids;
-			ArchetypeID		archetype_id;
-		};
-
-		struct RmvCompData
-		{
-			EntityID		entity_id;
-			ComponentTypeID component_id;
-		};
-
-		struct RmvCompsData
-		{
-			EntityID		entity_id;
-			ComponentIDs	component_ids;
-			ArchetypeID		archetype_id;
-		};
-
-		struct RmvEntityData
-		{
-			EntityID entity_id;
-		};
-
-	private:
-		using Command = std::variant<AddCompData, AddCompsData, RmvCompData, RmvCompsData, RmvEntityData>;
-		using CommandTable = std::array<std::queue<Command>, S_Count>;
-
 	public:
 		ObjectSystem(EntityAdmin& entity_admin, LayerType id);
 
@@ -95,11 +57,10 @@ namespace vlx
 		void RemoveComponents(EntityID entity_id, std::type_identity<std::tuple<Cs...>>, ExecutionStage stage = S_PostUpdate);
 
 	private:
-		void ExecuteCommands(ExecutionStage when);
-		void VisitCommand(const Command& command);
+		void ExecuteCommands(ExecutionStage stage);
 
 	private:
-		CommandTable m_command_table;
+		std::vector<CommandBuffer> m_command_buffers; // one buffer per stage, safe to record into from parallel systems
 	};
 
 	template<IsComponent C>
@@ -111,7 +72,7 @@ namespace vlx
 			return;
 		}
 
-		m_command_table[stage].emplace(std::in_place_index<0>, entity_id, m_entity_admin->GetComponentID<C>());
+		m_command_buffers[stage].AddComponent<C>(entity_id);
 	}
 	template<class... Cs> requires IsComponents<Cs...>
 	inline void ObjectSystem::AddComponents(EntityID entity_id, ExecutionStage stage)
@@ -122,11 +83,7 @@ namespace vlx
 			return;
 		}
 
-		constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ m_entity_admin->GetComponentID<Cs>()... });
-		constexpr auto archetype_id = cu::ContainerHash<ArrComponentIDs<Cs...>>()(component_ids);
-
-		m_command_table[stage].emplace(std::in_place_index<1>, entity_id,
-			ComponentIDs(component_ids.begin(), component_ids.end()), archetype_id);
+		m_command_buffers[stage].AddComponents<Cs...>(entity_id);
 	}
 	template<class... Cs> requires IsComponents<Cs...>
 	inline void ObjectSystem::AddComponents(EntityID entity_id, std::type_identity<std::tuple<Cs...>>, ExecutionStage stage)
@@ -143,7 +100,7 @@ namespace vlx
 			return;
 		}
 
-		m_command_table[stage].emplace(std::in_place_index<2>, entity_id, m_entity_admin->GetComponentID<C>());
+		m_command_buffers[stage].RemoveComponent<C>(entity_id);
 	}
 	template<class... Cs> requires IsComponents<Cs...>
 	inline void ObjectSystem::RemoveComponents(EntityID entity_id, ExecutionStage stage)
@@ -154,11 +111,7 @@ namespace vlx
 			return;
 		}
 
-		constexpr auto component_ids = cu::Sort<ArrComponentIDs<Cs...>>({ m_entity_admin->GetComponentID<Cs>()... });
-		constexpr auto archetype_id = cu::ContainerHash<ArrComponentIDs<Cs...>>()(component_ids);
-
-		m_command_table[stage].emplace(std::in_place_index<3>, entity_id,
-			ComponentIDs(component_ids.begin(), component_ids.end()), archetype_id);
+		m_command_buffers[stage].RemoveComponents<Cs...>(entity_id);
 	}
 	template<class... Cs> requires IsComponents<Cs...>
 	inline void ObjectSystem::RemoveComponents(EntityID entity_id, std::type_identity<std::tuple<Cs...>>, ExecutionStage stage)
@@ -0,0 +1,156 @@
+#include <Velox/ECS/CommandBuffer.h>
+
+#include <Velox/ECS/EntityAdmin.h>
+
+using namespace vlx;
+
+CommandBuffer::CommandBuffer(std::size_t thread_count)
+	: m_buffers(std::max<std::size_t>(thread_count, 1)), m_playback(m_buffers.size()) {}
+
+bool CommandBuffer::IsEmpty() const noexcept
+{
+	return std::ranges::all_of(m_buffers,
+		[](const ThreadBuffer& buffer)
+		{
+			return buffer.commands.empty();
+		});
+}
+
+std::size_t CommandBuffer::GetSize() const noexcept
+{
+	std::size_t size = 0;
+	for (const ThreadBuffer& buffer : m_buffers)
+		size += buffer.commands.size();
+
+	return size;
+}
+
+void CommandBuffer::AddComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id)
+{
+	Record(CommandType::AddComponents, entity_id, component_ids, archetype_id, true);
+}
+
+void CommandBuffer::RemoveComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id)
+{
+	Record(CommandType::RemoveComponents, entity_id, component_ids, archetype_id, true);
+}
+
+void CommandBuffer::RemoveEntity(EntityID entity_id)
+{
+	Record(CommandType::RemoveEntity, entity_id, {}, NULL_ARCHETYPE, false);
+}
+
+void CommandBuffer::Execute(EntityAdmin& entity_admin)
+{
+	while (!IsEmpty()) // listeners may record while playing back, those commands are played back in the next pass
+	{
+		std::swap(m_buffers, m_playback);
+
+		Sort();
+		Play(entity_admin);
+
+		for (ThreadBuffer& buffer : m_playback)
+		{
+			buffer.commands.clear();
+			buffer.arena.Reset();
+		}
+	}
+
+	m_sorted.clear();
+}
+
+void CommandBuffer::Clear()
+{
+	for (ThreadBuffer& buffer : m_buffers)
+	{
+		buffer.commands.clear();
+		buffer.arena.Reset();
+	}
+
+	m_sorted.clear();
+}
+
+auto CommandBuffer::GetThreadBuffer() -> ThreadBuffer&
+{
+	const std::size_t index = ThreadPool::GetThreadIndex();
+	assert(index < m_buffers.size() && "Thread is not allowed to record into this buffer");
+
+	return m_buffers[index];
+}
+
+void CommandBuffer::Record(CommandType type, EntityID entity_id, std::span<const ComponentTypeID> component_ids, ArchetypeID archetype_id, bool copy)
+{
+	assert(cu::IsSorted<ComponentTypeID>(component_ids));
+
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	const ComponentTypeID* ids = component_ids.data();
+	if (copy && !component_ids.empty()) // caller owns the ids, keep a copy that lives until playback
+	{
+		ComponentTypeID* dest = buffer.arena.Allocate<ComponentTypeID>(component_ids.size());
+		std::ranges::copy(component_ids, dest);
+
+		ids = dest;
+	}
+
+	buffer.commands.emplace_back(ids, archetype_id, entity_id, static_cast<uint32>(component_ids.size()), type);
+}
+
+void CommandBuffer::Sort()
+{
+	m_sorted.clear();
+
+	for (const ThreadBuffer& buffer : m_playback)
+		m_sorted.insert(m_sorted.end(), buffer.commands.begin(), buffer.commands.end());
+
+	std::ranges::stable_sort(m_sorted, {}, &Command::entity_id); // keeps the recording order of every entity
+
+	for (std::size_t i = 1; i < m_sorted.size(); ++i)
+	{
+		if (m_sorted[i].entity_id == m_sorted[i - 1].entity_id)
+			m_sorted[i].round = m_sorted[i - 1].round + 1;
+	}
+
+	std::ranges::sort(m_sorted,
+		[](const Command& lhs, const Command& rhs)
+		{
+			return std::tie(lhs.round, lhs.type, lhs.archetype_id, lhs.entity_id) < 
+				   std::tie(rhs.round, rhs.type, rhs.archetype_id, rhs.entity_id);
+		});
+}
+
+void CommandBuffer::Play(EntityAdmin& entity_admin)
+{
+	for (std::size_t i = 0; i < m_sorted.size();)
+	{
+		const Command& command = m_sorted[i];
+
+		std::size_t j = i + 1; // commands of the same round, type and archetype are played back as one batch
+		while (j < m_sorted.size() && m_sorted[j].round == command.round && 
+			m_sorted[j].type == command.type && m_sorted[j].archetype_id == command.archetype_id)
+		{
+			++j;
+		}
+
+		if (command.type == CommandType::RemoveEntity)
+		{
+			for (std::size_t k = i; k < j; ++k)
+				entity_admin.RemoveEntity(m_sorted[k].entity_id);
+		}
+		else
+		{
+			m_entities.clear();
+			for (std::size_t k = i; k < j; ++k)
+				m_entities.emplace_back(m_sorted[k].entity_id);
+
+			const ComponentIDSpan component_ids(command.component_ids, command.component_count);
+
+			if (command.type == CommandType::AddComponents)
+				entity_admin.AddComponents(m_entities, component_ids, command.archetype_id);
+			else
+				entity_admin.RemoveComponents(m_entities, component_ids, command.archetype_id);
+		}
+
+		i = j;
+	}
+}
\ No newline at end of file
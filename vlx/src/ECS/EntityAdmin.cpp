@@ -1,5 +1,7 @@
 #include <Velox/ECS/EntityAdmin.h>
 
+#include <Velox/System/Profiler.h>
+
 using namespace vlx;
 
 EntityAdmin::~EntityAdmin()
@@ -34,7 +36,7 @@ std::vector<EntityID> EntityAdmin::GetEntitiesWith(ComponentIDSpan component_ids
 
 	if (!restricted)
 	{
-		for (const Archetype* archetype : GetArchetypes(component_ids, archetype_id))
+		for (const Archetype* archetype : GetQuery(component_ids).archetypes)
 		{
 			entities.insert(entities.end(),
 				archetype->entities.begin(),
@@ -63,88 +65,71 @@ void EntityAdmin::Reserve(ComponentIDSpan component_ids, ArchetypeID archetype_i
 		throw std::runtime_error("Components memory is currently locked from modifications");
 
 	Archetype* archetype = GetArchetype(component_ids, archetype_id);
-	for (std::size_t i = 0; i < archetype->type.size(); ++i)
-	{
-		const auto component		= m_component_map[archetype->type[i]].get();
-		const auto component_size	= component->GetSize();
-
-		const auto current_size		= archetype->component_data_size[i];
-		const auto new_size			= component_count * component_size;
 
-		if (new_size > current_size) // only reserve if larger than current size
-		{
-			auto new_data = std::make_unique_for_overwrite<ByteArray>(new_size);
-
-			for (std::size_t j = 0; j < archetype->entities.size(); ++j)
-			{
-				component->MoveDestroyData(*this, archetype->entities[j],
-					&archetype->component_data[i][j * component_size],
-					&new_data[j * component_size]);
-			}
+	while (archetype->GetCapacity() < component_count) // existing chunks are never moved, only append new ones
+		archetype->chunks.emplace_back(std::make_unique_for_overwrite<ByteArray>(archetype->chunk_size));
 
-			archetype->component_data_size[i] = new_size;
-			archetype->component_data[i] = std::move(new_data);
-		}
-	}
+	archetype->versions.resize(archetype->chunks.size() * archetype->type.size(), m_change_tick);
 }
 
 EntityID EntityAdmin::GetNewEntityID()
 {
-	const auto GenerateID = [this]()
+	if (!m_reusable_entity_ids.empty())
 	{
-		if (!m_reusable_entity_ids.empty())
-		{
-			EntityID entity_id = m_reusable_entity_ids.back();
-			m_reusable_entity_ids.pop_back();
-
-			return entity_id;
-		}
-
-		return m_entity_id_counter++;
-	};
+		EntityID entity_id = m_reusable_entity_ids.back();
+		m_reusable_entity_ids.pop_back();
 
-	const EntityID entity_id = GenerateID();
+		return entity_id;
+	}
 
-	m_generation_count_map[entity_id]++; // increment generation count
+	if (m_entity_id_counter > ENTITY_INDEX_MASK)
+		throw std::runtime_error("Maximum number of entities has been reached");
 
-	return entity_id;
+	return MakeEntityID(m_entity_id_counter++, 0);
 }
 
 std::size_t EntityAdmin::GetGenerationCount(EntityID entity_id) const
 {
-	return m_generation_count_map.at(entity_id);
+	return static_cast<std::size_t>(GetEntityVersion(entity_id)) + 1; // the version is increased every time the index is reused
 }
 
 bool EntityAdmin::IsEntityRegistered(EntityID entity_id) const
 {
-	return m_entity_archetype_map.contains(entity_id);
+	return FindRecord(entity_id) != nullptr;
 }
 bool EntityAdmin::HasComponent(EntityID entity_id, ComponentTypeID component_id) const
 {
-	const auto eit = m_entity_archetype_map.find(entity_id);
-	if (eit == m_entity_archetype_map.end())
+	const auto record_ptr = FindRecord(entity_id);
+	if (record_ptr == nullptr)
 		return false;
 
-	const Archetype* archetype = eit->second.archetype;
+	const Archetype* archetype = record_ptr->archetype;
 
 	if (archetype == nullptr)
 		return false;
 
-	const auto cit = m_component_archetypes_map.find(component_id);
-	if (cit == m_component_archetypes_map.end())
-		return false;
-
-	return cit->second.contains(archetype->id);
+	return archetype->FindColumn(component_id) != Archetype::NULL_COLUMN;
 }
 
 auto EntityAdmin::RegisterEntity(EntityID entity_id) -> Record&
 {
 	assert(entity_id != NULL_ENTITY && "Cannot register a null entity id");
 
-	auto [it, success] = m_entity_archetype_map.try_emplace(entity_id, Record());
-	assert(success);
+	const auto index = GetEntityIndex(entity_id);
+
+	if (index >= m_entity_id_counter) // not handed out yet, would collide with a later entity
+		throw std::runtime_error("Entity id has not been created by this admin");
+
+	if (index >= m_entity_records.size())
+		m_entity_records.resize(index + 1);
+
+	Record& record = m_entity_records[index];
+	if (record.id != NULL_ENTITY) // would otherwise silently take over the slot of a live entity
+		throw std::runtime_error("Entity index is already in use");
+
+	record = Record{ .archetype = nullptr, .index = 0, .id = entity_id };
 
-	return it->second;
+	return record;
 }
 bool EntityAdmin::RegisterSystem(LayerType layer, SystemBase* system)
 {
@@ -168,6 +153,7 @@ bool EntityAdmin::RegisterSystem(LayerType layer, SystemBase* system)
 		return false;
 
 	systems.emplace_back(system);
+	m_schedules[layer].dirty = true;
 
 	return true;
 }
@@ -178,10 +164,71 @@ void EntityAdmin::RunSystems(LayerType layer) const
 	if (sit == m_systems.end())
 		return;
 
+	VELOX_PROFILE_SCOPE("EntityAdmin::RunSystems");
+
 	m_system_lock = true;
 
-	for (const SystemBase* system : sit->second)
-		RunSystem(system);
+	const auto lit = m_schedules.find(layer);
+	if (lit != m_schedules.end() && lit->second.parallel)
+	{
+		LayerSchedule& schedule = lit->second;
+
+		if (schedule.dirty)
+			BuildSchedule(sit->second, schedule);
+
+		std::vector<const SystemBase*> systems;
+		std::vector<const std::vector<Archetype*>*> archetypes;
+
+		for (const auto& wave : schedule.waves)
+		{
+			if (wave.size() == 1) // nothing to run concurrently with
+			{
+				RunSystem(wave.front());
+				continue;
+			}
+
+			systems.clear();
+			archetypes.clear();
+
+			for (const SystemBase* system : wave)
+			{
+				if (!system->IsEnabled())
+					continue;
+
+				system->Start(); // start and end are called on this thread
+				systems.emplace_back(system);
+			}
+
+			for (const SystemBase* system : systems) // resolve queries, names and ticks beforehand since none are thread-safe
+			{
+				(void)system->GetName();
+				archetypes.emplace_back(&GetQuery(*system).archetypes);
+				BeginRun(system);
+			}
+
+			m_component_lock = true;
+
+			m_thread_pool.ParallelFor(systems.size(), 1,
+				[this, &systems, &archetypes](std::size_t begin, std::size_t end)
+				{
+					for (std::size_t i = begin; i < end; ++i)
+					{
+						VELOX_PROFILE_SCOPE(systems[i]->GetName());
+						RunArchetypes(systems[i], *archetypes[i]);
+					}
+				});
+
+			m_component_lock = false;
+
+			for (const SystemBase* system : systems)
+				system->End();
+		}
+	}
+	else
+	{
+		for (const SystemBase* system : sit->second)
+			RunSystem(system);
+	}
 
 	m_system_lock = false;
 }
@@ -200,6 +247,25 @@ void EntityAdmin::SortSystems(LayerType layer)
 		{
 			return *lhs > *rhs;
 		});
+
+	m_schedules[layer].dirty = true;
+}
+
+void EntityAdmin::SetLayerParallel(LayerType layer, bool flag)
+{
+	if (m_system_lock)
+		throw std::runtime_error("Systems are currently locked from modifications");
+
+	LayerSchedule& schedule = m_schedules[layer];
+
+	schedule.parallel	= flag;
+	schedule.dirty		= true;
+}
+
+bool EntityAdmin::IsLayerParallel(LayerType layer) const
+{
+	const auto it = m_schedules.find(layer);
+	return it != m_schedules.end() && it->second.parallel;
 }
 
 void EntityAdmin::RunSystem(const SystemBase* system) const
@@ -207,28 +273,16 @@ void EntityAdmin::RunSystem(const SystemBase* system) const
 	if (!system->IsEnabled())
 		return;
 
+	VELOX_PROFILE_SCOPE(system->GetName());
+
 	system->Start();
 
-	const auto& archetypes = GetArchetypes(system->GetArchKey(), system->GetIDKey());
+	const auto& archetypes = GetQuery(*system).archetypes;
+	BeginRun(system);
 
 	m_component_lock = true;
 
-	if (system->IsRunningParallel())
-	{
-		std::for_each(std::execution::par, archetypes.begin(), archetypes.end(),
-			[&system](const Archetype* const archetype)
-			{
-				system->Run(archetype);
-			});
-	}
-	else
-	{
-		std::ranges::for_each(archetypes,
-			[&system](const Archetype* const archetype)
-			{
-				system->Run(archetype);
-			});
-	}
+	RunArchetypes(system, archetypes);
 
 	m_component_lock = false;
 
@@ -240,6 +294,8 @@ bool EntityAdmin::RemoveSystem(LayerType layer, SystemBase* system)
 	if (m_system_lock)
 		throw std::runtime_error("Systems are currently locked from modifications");
 
+	m_schedules[layer].dirty = true;
+
 	return cu::Erase(m_systems[layer], system);
 }
 
@@ -248,18 +304,16 @@ bool EntityAdmin::RemoveEntity(EntityID entity_id)
 	if (m_component_lock)
 		throw std::runtime_error("Components memory is currently locked from modifications");
 
-	const auto eit = m_entity_archetype_map.find(entity_id);
-	if (eit == m_entity_archetype_map.end()) // entity does not exist
+	const auto record_ptr = FindRecord(entity_id);
+	if (record_ptr == nullptr) // entity does not exist
 		return false;
 
-	Record& record		 = eit->second;
+	Record& record		 = *record_ptr;
 	Archetype* archetype = record.archetype;
 
 	if (archetype == nullptr) // entity has not been assigned an archetype anyways
 	{
-		m_entity_archetype_map.erase(entity_id);
-		m_reusable_entity_ids.emplace_back(entity_id);
-
+		ReleaseEntity(entity_id);
 		return true;
 	}
 
@@ -267,23 +321,24 @@ bool EntityAdmin::RemoveEntity(EntityID entity_id)
 
 	if (last_entity_id != entity_id)
 	{
-		Record& last_record = m_entity_archetype_map[last_entity_id];
+		Record& last_record = GetRecord(last_entity_id);
 
 		for (std::size_t i = 0; i < archetype->type.size(); ++i)
 		{
 			const auto component_id		= archetype->type[i];
 			const auto component		= m_component_map[component_id].get();
-			const auto component_size	= component->GetSize();
 
-			const auto entity_data		= &archetype->component_data[i][record.index * component_size];
-			const auto last_entity_data	= &archetype->component_data[i][last_record.index * component_size];
+			const auto entity_data		= archetype->GetData(i, record.index);
+			const auto last_entity_data	= archetype->GetData(i, last_record.index);
 
 			component->DestroyData(*this, entity_id, entity_data);
-			component->MoveDestroyData(*this, last_entity_id, last_entity_data, entity_data); // move data from current to last
+			RelocateData(component_id, component, last_entity_id, last_entity_data, entity_data); // move data from current to last
 		}
 
 		archetype->entities[record.index] = last_entity_id; // now swap ids with last
 		last_record.index = record.index;
+
+		archetype->MarkEntityChanged(record.index, m_change_tick); // the moved entity has to be seen by change filters in its new chunk
 	}
 	else
 	{
@@ -291,16 +346,14 @@ bool EntityAdmin::RemoveEntity(EntityID entity_id)
 		{
 			const auto component_id		= archetype->type[i];
 			const auto component		= m_component_map[component_id].get();
-			const auto component_size	= component->GetSize();
 
-			component->DestroyData(*this, entity_id, &archetype->component_data[i][record.index * component_size]);
+			component->DestroyData(*this, entity_id, archetype->GetData(i, record.index));
 		}
 	}
 
 	archetype->entities.pop_back();
 
-	m_entity_archetype_map.erase(entity_id);
-	m_reusable_entity_ids.emplace_back(entity_id);
+	ReleaseEntity(entity_id);
 
 	return true;
 }
@@ -329,40 +382,18 @@ void EntityAdmin::AddComponents(EntityID entity_id, ComponentIDSpan component_id
 	if (m_component_lock)
 		throw std::runtime_error("Components memory is currently locked from modifications");
 
-	const auto eit = m_entity_archetype_map.find(entity_id);
-	if (eit == m_entity_archetype_map.end())
+	const auto record_ptr = FindRecord(entity_id);
+	if (record_ptr == nullptr)
 		return;
 
-	Record& record = eit->second;
+	Record& record = *record_ptr;
 	Archetype* old_archetype = record.archetype;
 
 	Archetype* new_archetype = nullptr; // we are going to be moving to a new archetype
 
 	if (old_archetype) // already has an attached archetype, define a new archetype
 	{
-		if (const auto ait = old_archetype->edges.find(archetype_id); ait == old_archetype->edges.end())
-		{
-			ComponentIDs new_archetype_id = old_archetype->type; // create copy
-
-			bool found = false;
-			for (ComponentTypeID component_id : component_ids) // determine valid components
-			{
-				if (cu::InsertUniqueSorted<ComponentTypeID>(new_archetype_id, component_id)) // insert while keeping the vector sorted (this should ensure that the archetype is always sorted)
-					found = true;
-			}
-
-			if (!found) // unable to add any component
-				return;
-
-			new_archetype = GetArchetype(new_archetype_id, cu::ContainerHash<ComponentTypeID>()(new_archetype_id));
-
-			old_archetype->edges[archetype_id].add = new_archetype;
-			new_archetype->edges[archetype_id].rmv = old_archetype;
-
-			assert(new_archetype_id != old_archetype->type);
-			assert(new_archetype_id == new_archetype->type);
-		}
-		else new_archetype = ait->second.add;
+		new_archetype = GetAddArchetype(old_archetype, component_ids, archetype_id);
 
 		if (!new_archetype) // exit if no archetype was found
 			return;
@@ -371,7 +402,7 @@ void EntityAdmin::AddComponents(EntityID entity_id, ComponentIDSpan component_id
 
 		if (last_entity_id != entity_id)
 		{
-			Record& last_record = m_entity_archetype_map[last_entity_id];
+			Record& last_record = GetRecord(last_entity_id);
 			ConstructSwap(new_archetype, old_archetype, entity_id, record, last_entity_id, last_record);
 		}
 		else
@@ -385,25 +416,24 @@ void EntityAdmin::AddComponents(EntityID entity_id, ComponentIDSpan component_id
 	{
 		new_archetype = GetArchetype(component_ids, archetype_id); // construct or get archetype using the id
 
+		MakeRoom(new_archetype);
+
+		const auto new_index = new_archetype->entities.size();
+
 		for (std::size_t i = 0; i < component_ids.size(); ++i)
 		{
 			const auto component_id		= component_ids[i];
 			const auto component		= m_component_map[component_id].get();
-			const auto component_size	= component->GetSize();
-
-			const auto current_size = new_archetype->entities.size() * component_size;
-			const auto new_size		= current_size + component_size;
 
-			if (new_size > new_archetype->component_data_size[i])
-				MakeRoom(new_archetype, component, component_size, i); // make room and move over existing data
-
-			component->ConstructData(*this, entity_id, &new_archetype->component_data[i][current_size]);
+			component->ConstructData(*this, entity_id, new_archetype->GetData(i, new_index));
 		}
 	}
 
 	new_archetype->entities.emplace_back(entity_id);
 	record.index		= static_cast<IDType>(new_archetype->entities.size() - 1);
 	record.archetype	= new_archetype;
+
+	new_archetype->MarkEntityChanged(record.index, m_change_tick);
 }
 
 bool EntityAdmin::RemoveComponents(EntityID entity_id, ComponentIDSpan component_ids, ArchetypeID archetype_id)
@@ -413,38 +443,17 @@ bool EntityAdmin::RemoveComponents(EntityID entity_id, ComponentIDSpan component
 	if (m_component_lock)
 		throw std::runtime_error("Components memory is currently locked from modifications");
 
-	const auto eit = m_entity_archetype_map.find(entity_id);
-	if (eit == m_entity_archetype_map.end())
+	const auto record_ptr = FindRecord(entity_id);
+	if (record_ptr == nullptr)
 		return false;
 
-	Record& record				= eit->second;
+	Record& record				= *record_ptr;
 	Archetype* old_archetype	= record.archetype;
 
 	if (old_archetype == nullptr) // not registered anyways, nothing to remove from
 		return false;
 
-	Archetype* new_archetype = nullptr;
-
-	if (auto ait = old_archetype->edges.find(archetype_id); ait == old_archetype->edges.end())
-	{
-		ComponentIDs new_archetype_id = old_archetype->type; // create copy
-
-		bool found = false;
-		for (ComponentTypeID component_id : component_ids) // erase while keeping the vector sorted
-		{
-			if (cu::EraseUniqueSorted<ComponentTypeID>(new_archetype_id, component_id))
-				found = true;
-		}
-
-		if (!found) // unable to remove any component
-			return false;
-
-		new_archetype = GetArchetype(new_archetype_id, cu::ContainerHash<ComponentTypeID>()(new_archetype_id));
-
-		new_archetype->edges[archetype_id].add = old_archetype;
-		old_archetype->edges[archetype_id].rmv = new_archetype;
-	}
-	else new_archetype = ait->second.rmv;
+	Archetype* new_archetype = GetRemoveArchetype(old_archetype, component_ids, archetype_id);
 
 	if (!new_archetype) // exit if no archetype was found
 		return false;
@@ -453,7 +462,7 @@ bool EntityAdmin::RemoveComponents(EntityID entity_id, ComponentIDSpan component
 
 	if (last_entity_id != entity_id)
 	{
-		Record& last_record = m_entity_archetype_map[last_entity_id];
+		Record& last_record = GetRecord(last_entity_id);
 		DestructSwap(old_archetype, new_archetype, entity_id, record, last_entity_id, last_record);
 	}
 	else
@@ -467,9 +476,122 @@ bool EntityAdmin::RemoveComponents(EntityID entity_id, ComponentIDSpan component
 	record.index		= static_cast<IDType>(new_archetype->entities.size() - 1);
 	record.archetype	= new_archetype;
 
+	new_archetype->MarkEntityChanged(record.index, m_change_tick);
+
 	return true;
 }
 
+void EntityAdmin::AddComponents(EntitySpan entities, ComponentIDSpan component_ids, ArchetypeID archetype_id)
+{
+	assert(cu::IsSorted<ComponentTypeID>(component_ids));
+	assert(!component_ids.empty());
+
+	if (m_component_lock)
+		throw std::runtime_error("Components memory is currently locked from modifications");
+
+	std::vector<std::pair<Archetype*, std::vector<EntityID>>> groups; // entities grouped by their current archetype
+
+	for (const EntityID entity_id : entities)
+	{
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr)
+			continue;
+
+		Archetype* old_archetype = record_ptr->archetype;
+
+		auto git = std::ranges::find(groups, old_archetype, &decltype(groups)::value_type::first);
+		if (git == groups.end())
+			git = groups.insert(groups.end(), { old_archetype, {} });
+
+		git->second.emplace_back(entity_id);
+	}
+
+	for (auto& [old_archetype, group] : groups) // the same entity may not be migrated twice
+	{
+		std::ranges::sort(group);
+		group.erase(std::ranges::unique(group).begin(), group.end());
+	}
+
+	for (auto& [old_archetype, group] : groups)
+	{
+		if (old_archetype == nullptr) // first components, construct them directly in the archetype
+		{
+			Archetype* new_archetype = GetArchetype(component_ids, archetype_id);
+
+			MakeRoom(new_archetype, group.size());
+
+			const auto first = new_archetype->entities.size();
+
+			for (std::size_t i = 0; i < component_ids.size(); ++i)
+			{
+				const auto component = m_component_map[component_ids[i]].get();
+
+				for (std::size_t j = 0; j < group.size(); ++j)
+					component->ConstructData(*this, group[j], new_archetype->GetData(i, first + j));
+			}
+
+			for (const EntityID entity_id : group)
+			{
+				Record& record = GetRecord(entity_id);
+
+				new_archetype->entities.emplace_back(entity_id);
+				record.index		= static_cast<IDType>(new_archetype->entities.size() - 1);
+				record.archetype	= new_archetype;
+
+				new_archetype->MarkEntityChanged(record.index, m_change_tick);
+			}
+		}
+		else if (Archetype* new_archetype = GetAddArchetype(old_archetype, component_ids, archetype_id); new_archetype != nullptr)
+		{
+			Migrate(old_archetype, new_archetype, group, true);
+		}
+	}
+}
+
+bool EntityAdmin::RemoveComponents(EntitySpan entities, ComponentIDSpan component_ids, ArchetypeID archetype_id)
+{
+	assert(cu::IsSorted<ComponentTypeID>(component_ids) && !component_ids.empty());
+
+	if (m_component_lock)
+		throw std::runtime_error("Components memory is currently locked from modifications");
+
+	std::vector<std::pair<Archetype*, std::vector<EntityID>>> groups; // entities grouped by their current archetype
+
+	for (const EntityID entity_id : entities)
+	{
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr || record_ptr->archetype == nullptr) // nothing to remove from
+			continue;
+
+		Archetype* old_archetype = record_ptr->archetype;
+
+		auto git = std::ranges::find(groups, old_archetype, &decltype(groups)::value_type::first);
+		if (git == groups.end())
+			git = groups.insert(groups.end(), { old_archetype, {} });
+
+		git->second.emplace_back(entity_id);
+	}
+
+	for (auto& [old_archetype, group] : groups) // the same entity may not be migrated twice
+	{
+		std::ranges::sort(group);
+		group.erase(std::ranges::unique(group).begin(), group.end());
+	}
+
+	bool removed = false;
+
+	for (auto& [old_archetype, group] : groups)
+	{
+		if (Archetype* new_archetype = GetRemoveArchetype(old_archetype, component_ids, archetype_id); new_archetype != nullptr)
+		{
+			Migrate(old_archetype, new_archetype, group, false);
+			removed = true;
+		}
+	}
+
+	return removed;
+}
+
 void EntityAdmin::DeregisterOnAddListener(ComponentTypeID component_id, evnt::IDType id)
 {
 	if (auto it = m_events_add.find(component_id); it != m_events_add.end())
@@ -488,6 +610,15 @@ void EntityAdmin::DeregisterOnRemoveListener(ComponentTypeID component_id, evnt:
 		it->second -= id;
 }
 
+const ThreadPool& EntityAdmin::GetThreadPool() const noexcept
+{
+	return m_thread_pool;
+}
+ThreadPool& EntityAdmin::GetThreadPool() noexcept
+{
+	return m_thread_pool;
+}
+
 bool EntityAdmin::HasShutdown() const
 {
 	return m_shutdown;
@@ -499,6 +630,99 @@ void EntityAdmin::Shutdown()
 	Destroy(); // invalidate the ecs and destroy all data
 }
 
+void EntityAdmin::RunArchetypes(const SystemBase* system, const std::vector<Archetype*>& archetypes) const
+{
+	if (system->IsRunningParallel())
+	{
+		struct Range
+		{
+			const Archetype*	archetype	{nullptr};
+			std::size_t			begin		{0};
+			std::size_t			end			{0};
+		};
+
+		const std::size_t batch_size = system->GetBatchSize();
+
+		std::vector<Range> ranges;
+		for (const Archetype* archetype : archetypes) // split the archetypes into ranges so that large ones are spread across all threads
+		{
+			const std::size_t count = archetype->entities.size(); // empty archetypes produce no ranges
+			const std::size_t step = (batch_size >= archetype->chunk_capacity) ? // prefer ranges that consist of whole chunks
+				batch_size / archetype->chunk_capacity * archetype->chunk_capacity : batch_size;
+
+			for (std::size_t begin = 0; begin < count; begin += step)
+				ranges.emplace_back(archetype, begin, std::min(begin + step, count));
+		}
+
+		m_thread_pool.ParallelFor(ranges.size(), 1,
+			[&system, &ranges](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					system->Run(ranges[i].archetype, ranges[i].begin, ranges[i].end);
+			});
+	}
+	else
+	{
+		for (const Archetype* archetype : archetypes)
+		{
+			if (!archetype->entities.empty())
+				system->Run(archetype, 0, archetype->entities.size());
+		}
+	}
+}
+
+void EntityAdmin::BuildSchedule(const std::vector<SystemBase*>& systems, LayerSchedule& schedule) const
+{
+	schedule.waves.clear();
+
+	// systems are placed in the first wave after all the preceding systems they conflict with, 
+	// this keeps the priority order between conflicting systems while letting the rest run alongside
+
+	std::vector<std::size_t> levels(systems.size(), 0);
+
+	for (std::size_t i = 0; i < systems.size(); ++i)
+	{
+		for (std::size_t j = 0; j < i; ++j)
+		{
+			if (levels[j] >= levels[i] && IsConflicting(*systems[j], *systems[i]))
+				levels[i] = levels[j] + 1;
+		}
+
+		if (levels[i] >= schedule.waves.size())
+			schedule.waves.resize(levels[i] + 1);
+
+		schedule.waves[levels[i]].emplace_back(systems[i]);
+	}
+
+	schedule.dirty = false;
+}
+
+void EntityAdmin::InvalidateSchedules() const
+{
+	for (auto& [layer, schedule] : m_schedules)
+		schedule.dirty = true;
+}
+
+bool EntityAdmin::IsConflicting(const SystemBase& lhs, const SystemBase& rhs) const
+{
+	const bool access = 
+		cu::HasIntersection<ComponentTypeID>(lhs.GetWriteKey(), rhs.GetWriteKey()) ||
+		cu::HasIntersection<ComponentTypeID>(lhs.GetWriteKey(), rhs.GetReadKey()) ||
+		cu::HasIntersection<ComponentTypeID>(lhs.GetReadKey(), rhs.GetWriteKey());
+
+	if (!access)
+		return false;
+
+	const auto& lhs_archetypes = GetQuery(lhs).archetypes;
+	const auto& rhs_archetypes = GetQuery(rhs).archetypes;
+
+	return std::ranges::any_of(lhs_archetypes, // only conflicts if they operate on the same data
+		[&rhs_archetypes](const Archetype* archetype)
+		{
+			return std::ranges::find(rhs_archetypes, archetype) != rhs_archetypes.end();
+		});
+}
+
 Archetype* EntityAdmin::GetArchetype(ComponentIDSpan component_ids, ArchetypeID archetype_id)
 {
 	assert(cu::IsSorted<ComponentTypeID>(component_ids));
@@ -510,21 +734,98 @@ Archetype* EntityAdmin::GetArchetype(ComponentIDSpan component_ids, ArchetypeID
 	return CreateArchetype(component_ids, archetype_id); // archetype does not exist, create new one
 }
 
-const std::vector<Archetype*>& EntityAdmin::GetArchetypes(ComponentIDSpan component_ids, ArchetypeID archetype_id) const
+const ArchetypeQuery& EntityAdmin::GetQuery(ComponentIDSpan include, ComponentIDSpan exclude) const
 {
-	const auto it = m_archetype_cache.find(archetype_id);
-	if (it != m_archetype_cache.end())
-		return it->second;
+	assert(cu::IsSorted<ComponentTypeID>(include) && cu::IsSorted<ComponentTypeID>(exclude));
+
+	ArchetypeID key = cu::ContainerHash<ComponentTypeID>()(include);
+	if (!exclude.empty())
+		cu::HashCombine(key, cu::ContainerHash<ComponentTypeID>()(exclude));
+
+	const auto it = m_queries.find(key);
+	if (it != m_queries.end())
+	{
+		assert(std::ranges::equal(it->second->include, include) && std::ranges::equal(it->second->exclude, exclude) && "Hash collision between queries");
+		return *it->second;
+	}
+
+	auto query = std::make_unique<ArchetypeQuery>();
+
+	query->include = { include.begin(), include.end() };
+	query->exclude = { exclude.begin(), exclude.end() };
+
+	for (const ArchetypePtr& archetype : m_archetypes) // only time a full match is performed
+	{
+		if (query->IsMatch(*archetype))
+			query->archetypes.emplace_back(archetype.get());
+	}
+
+	return *m_queries.emplace(key, std::move(query)).first->second;
+}
+
+const ArchetypeQuery& EntityAdmin::GetQuery(const SystemBase& system) const
+{
+	if (system.m_query == nullptr)
+		system.m_query = &GetQuery(system.GetArchKey(), system.GetExcludeKey());
+
+	return *system.m_query;
+}
+
+void EntityAdmin::MatchQueries(Archetype* archetype) const
+{
+	for (const auto& [key, query] : m_queries)
+	{
+		if (query->IsMatch(*archetype))
+			query->archetypes.emplace_back(archetype);
+	}
+}
 
-	std::vector<Archetype*> result;
+uint32 EntityAdmin::GetChangeTick() const noexcept
+{
+	return m_change_tick;
+}
+
+void EntityAdmin::BeginRun(const SystemBase* system) const
+{
+	system->m_last_run_tick	= system->m_run_tick;
+	system->m_run_tick		= m_change_tick++; // anything marked from now on is newer than the run
 
-	for (const ArchetypePtr& archetype : m_archetypes)
+	for (const ComponentTypeID component_id : system->GetChangedKey())
+		MarkReferencesChanged(component_id);
+}
+
+void EntityAdmin::MarkReferencesChanged(ComponentTypeID component_id) const
+{
+	const auto cit = m_component_ref_entities.find(component_id);
+	if (cit == m_component_ref_entities.end())
+		return;
+
+	for (const EntityID entity_id : cit->second) // only the entities that hold a reference to the component
 	{
-		if (std::ranges::includes(archetype->type, component_ids))
-			result.push_back(archetype.get());
+		const auto record_ptr = FindRecord(entity_id);
+		if (record_ptr == nullptr || record_ptr->archetype == nullptr)
+			continue;
+
+		const Archetype* archetype = record_ptr->archetype;
+
+		const auto column = archetype->FindColumn(component_id);
+		if (column != Archetype::NULL_COLUMN)
+			archetype->MarkChanged(record_ptr->index / archetype->chunk_capacity, column, m_change_tick);
 	}
+}
+
+void EntityAdmin::RebuildQueries() const
+{
+	for (const auto& [key, query] : m_queries)
+	{
+		query->archetypes.clear();
 
-	return m_archetype_cache.emplace(archetype_id, result).first->second;
+		for (const ArchetypePtr& archetype : m_archetypes)
+		{
+			if (query->IsMatch(*archetype))
+				query->archetypes.emplace_back(archetype.get());
+		}
+	}
 }
 
 Archetype* EntityAdmin::CreateArchetype(ComponentIDSpan component_ids, ArchetypeID archetype_id)
@@ -538,19 +839,47 @@ Archetype* EntityAdmin::CreateArchetype(ComponentIDSpan component_ids, Archetype
 
 	m_archetype_map[archetype_id] = new_archetype.get();
 
-	for (uint64 i = 0; i < new_archetype->type.size(); ++i) // add empty array for each component in type
+	std::size_t entity_size = 0; // combined size of all components for one entity
+	for (uint64 i = 0; i < new_archetype->type.size(); ++i)
 	{
-		constexpr uint64 DEFAULT_BYTE_SIZE = 128; // default size in bytes to reduce number of reallocations
+		const auto component_size = m_component_map.at(new_archetype->type[i])->GetSize();
 
-		new_archetype->component_data.emplace_back(std::make_unique_for_overwrite<ByteArray>(DEFAULT_BYTE_SIZE));
-		new_archetype->component_data_size.emplace_back(DEFAULT_BYTE_SIZE);
+		new_archetype->column_sizes.emplace_back(static_cast<uint32>(component_size));
+		entity_size += component_size;
 
 		m_component_archetypes_map[new_archetype->type[i]][archetype_id].column = static_cast<ColumnType>(i);
 	}
 
-	m_archetype_cache.clear(); // unfortunately for now, we'll have to clear the cache whenever an archetype has been added
+	const auto ComputeLayout = [&new_archetype](std::size_t capacity) -> std::size_t // returns size of chunk
+	{
+		constexpr std::size_t ALIGNMENT = alignof(std::max_align_t); // every array starts aligned for any component
+
+		new_archetype->column_offsets.clear();
+
+		std::size_t offset = 0;
+		for (const uint32 size : new_archetype->column_sizes)
+		{
+			offset = (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+			new_archetype->column_offsets.emplace_back(static_cast<uint32>(offset));
+			offset += size * capacity;
+		}
+
+		return offset;
+	};
+
+	std::size_t capacity = (entity_size != 0) ? std::max<std::size_t>(ARCHETYPE_CHUNK_SIZE / entity_size, 1) : ARCHETYPE_CHUNK_SIZE;
+	while (capacity > 1 && ComputeLayout(capacity) > ARCHETYPE_CHUNK_SIZE) // padding between arrays may push it over
+		--capacity;
+
+	new_archetype->chunk_capacity	= capacity;
+	new_archetype->chunk_size		= ComputeLayout(capacity); // entities larger than a chunk are given a chunk each
+
+	Archetype* archetype = m_archetypes.emplace_back(std::move(new_archetype)).get();
 
-	return m_archetypes.emplace_back(std::move(new_archetype)).get();
+	MatchQueries(archetype); // existing queries only have to consider the new archetype
+	InvalidateSchedules();
+
+	return archetype;
 }
 
 void EntityAdmin::CallOnAddEvent(ComponentTypeID component_id, EntityID eid, void* data) const
@@ -576,11 +905,11 @@ EntityID EntityAdmin::Duplicate(EntityID entity_id)
 	if (m_component_lock)
 		throw std::runtime_error("Components memory is currently locked from modifications");
 
-	const auto eit = m_entity_archetype_map.find(entity_id);
-	if (eit == m_entity_archetype_map.end())
+	const auto record_ptr = FindRecord(entity_id);
+	if (record_ptr == nullptr)
 		return NULL_ENTITY;
 
-	Record& record = eit->second;
+	Record& record = *record_ptr;
 	Archetype* archetype = record.archetype;
 
 	if (archetype == nullptr)
@@ -589,84 +918,136 @@ EntityID EntityAdmin::Duplicate(EntityID entity_id)
 	EntityID new_entity_id = GetNewEntityID();
 	Record& new_record = RegisterEntity(new_entity_id);
 
+	MakeRoom(archetype); // chunks are never relocated, so the source data remains valid
+
+	const auto new_index = archetype->entities.size();
+
 	for (std::size_t i = 0; i < archetype->type.size(); ++i)
 	{
 		const auto component_id		= archetype->type[i];
 		const auto component		= m_component_map[component_id].get();
-		const auto component_size	= component->GetSize();
-
-		const auto current_size = archetype->entities.size() * component_size;
-		const auto new_size		= current_size + component_size;
-
-		if (new_size > archetype->component_data_size[i])
-			MakeRoom(archetype, component, component_size, i); // make room to fit data
 
 		component->CopyData(*this, new_entity_id,
-			&archetype->component_data[i][record.index * component_size],
-			&archetype->component_data[i][current_size]);
+			archetype->GetData(i, record.index),
+			archetype->GetData(i, new_index));
 	}
 
 	archetype->entities.emplace_back(new_entity_id);
 	new_record.index		= static_cast<IDType>(archetype->entities.size() - 1);
 	new_record.archetype	= archetype;
 
+	archetype->MarkEntityChanged(new_record.index, m_change_tick);
+
 	return new_entity_id;
 }
 
-void EntityAdmin::Shrink(bool extensive)
+std::vector<EntityID> EntityAdmin::Duplicate(EntityID entity_id, std::size_t count)
 {
 	if (m_component_lock)
 		throw std::runtime_error("Components memory is currently locked from modifications");
 
-	ClearEmptyEntityArchetypes();
-	ClearEmptyTypeArchetypes();
+	std::vector<EntityID> new_entities;
 
-	m_archetype_cache.clear();
+	const auto record_ptr = FindRecord(entity_id);
+	if (record_ptr == nullptr)
+		return new_entities;
 
-	if (extensive) // shrink all archetypes data
+	Archetype* archetype = record_ptr->archetype;
+	const auto index = record_ptr->index;
+
+	if (archetype == nullptr)
+		return new_entities;
+
+	new_entities.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
 	{
-		for (std::size_t i = 0; i < m_archetypes.size(); ++i)
-		{
-			const ArchetypePtr& archetype = m_archetypes[i];
-			const ComponentIDs& archetype_id = archetype->type;
+		const EntityID new_entity_id = GetNewEntityID();
+		RegisterEntity(new_entity_id);
 
-			for (std::size_t j = 0; j < archetype_id.size(); ++j)
-			{
-				const auto component_id		= archetype->type[j];
-				const auto component		= m_component_map[component_id].get();
-				const auto component_size	= component->GetSize();
+		new_entities.emplace_back(new_entity_id);
+	}
 
-				const auto current_size		= archetype->entities.size() * component_size;
-				const auto current_capacity = archetype->component_data_size[j];
+	MakeRoom(archetype, count); // chunks are never relocated, so the source data remains valid
 
-				if (current_capacity > current_size)
-				{
-					archetype->component_data_size[j] = current_size;
+	const auto first = archetype->entities.size();
 
-					auto new_data = std::make_unique_for_overwrite<ByteArray>(archetype->component_data_size[j]);
+	for (std::size_t i = 0; i < archetype->type.size(); ++i) // copy column by column to keep the access linear
+	{
+		const auto component = m_component_map[archetype->type[i]].get();
+		const auto source = archetype->GetData(i, index);
 
-					for (std::size_t k = 0; k < archetype->entities.size(); ++k)
-					{
-						component->MoveDestroyData(*this, archetype->entities[k],
-							&archetype->component_data[j][k * component_size],
-							&new_data[k * component_size]);
-					}
+		for (std::size_t j = 0; j < count; ++j)
+			component->CopyData(*this, new_entities[j], source, archetype->GetData(i, first + j));
+	}
 
-					archetype->component_data[j] = std::move(new_data);
-				}
-			}
+	for (const EntityID new_entity_id : new_entities)
+	{
+		Record& new_record = GetRecord(new_entity_id);
+
+		archetype->entities.emplace_back(new_entity_id);
+		new_record.index		= static_cast<IDType>(archetype->entities.size() - 1);
+		new_record.archetype	= archetype;
+
+		archetype->MarkEntityChanged(new_record.index, m_change_tick);
+	}
+
+	return new_entities;
+}
+
+std::vector<EntityID> EntityAdmin::CreateEntities(ComponentIDSpan component_ids, ArchetypeID archetype_id, std::size_t count)
+{
+	assert(cu::IsSorted<ComponentTypeID>(component_ids));
+
+	if (m_component_lock)
+		throw std::runtime_error("Components memory is currently locked from modifications");
+
+	std::vector<EntityID> new_entities;
+	new_entities.reserve(count);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const EntityID new_entity_id = GetNewEntityID();
+		RegisterEntity(new_entity_id);
+
+		new_entities.emplace_back(new_entity_id);
+	}
+
+	if (!component_ids.empty())
+		AddComponents(new_entities, component_ids, archetype_id); // all entities are without archetype, so they are constructed in place
+
+	return new_entities;
+}
+
+void EntityAdmin::Shrink(bool extensive)
+{
+	if (m_component_lock)
+		throw std::runtime_error("Components memory is currently locked from modifications");
+
+	ClearEmptyEntityArchetypes();
+	ClearEmptyTypeArchetypes();
+
+	RebuildQueries();
+	InvalidateSchedules();
+
+	if (extensive) // shrink all archetypes data
+	{
+		for (const ArchetypePtr& archetype : m_archetypes)
+		{
+			archetype->chunks.resize(archetype->GetChunkCount()); // release the trailing chunks that hold no entities
+			archetype->versions.resize(archetype->chunks.size() * archetype->type.size());
+			archetype->chunks.shrink_to_fit();
 		}
 	}
 }
 
 void EntityAdmin::EraseComponentRef(EntityID entity_id, ComponentTypeID component_id) const
 {
-	const auto eit = m_entity_component_ref_map.find(entity_id);
-	if (eit == m_entity_component_ref_map.end())
+	ComponentRefs* refs = FindComponentRefs(entity_id);
+	if (refs == nullptr)
 		return;
 
-	const auto cit = eit->second.find(component_id);
-	if (cit == eit->second.end())
+	const auto cit = FindComponentRef(*refs, component_id);
+	if (cit == refs->end())
 		return;
 
 	DataRef& ref = cit->second;
@@ -676,7 +1057,8 @@ void EntityAdmin::EraseComponentRef(EntityID entity_id, ComponentTypeID componen
 	{
 		if (ref.component_ptr.expired())
 		{
-			eit->second.erase(component_id);
+			refs->erase(cit);
+			EraseRefEntity(component_id, entity_id);
 		}
 		else *ref.component_ptr.lock() = nullptr;
 	}
@@ -685,7 +1067,8 @@ void EntityAdmin::EraseComponentRef(EntityID entity_id, ComponentTypeID componen
 	{
 		if (ref.base_ptr.expired())
 		{
-			eit->second.erase(component_id);
+			refs->erase(cit);
+			EraseRefEntity(component_id, entity_id);
 		}
 		else *ref.base_ptr.lock() = nullptr;
 	}
@@ -694,7 +1077,8 @@ void EntityAdmin::EraseComponentRef(EntityID entity_id, ComponentTypeID componen
 	{
 		if (ref.component_ptr.expired() && ref.base_ptr.expired())
 		{
-			eit->second.erase(component_id);
+			refs->erase(cit);
+			EraseRefEntity(component_id, entity_id);
 		}
 		else
 		{
@@ -706,16 +1090,45 @@ void EntityAdmin::EraseComponentRef(EntityID entity_id, ComponentTypeID componen
 	}
 }
 
-void EntityAdmin::UpdateComponentRef(EntityID entity_id, ComponentTypeID component_id, void* new_component) const
+void EntityAdmin::EraseRefEntity(ComponentTypeID component_id, EntityID entity_id) const
 {
-	const auto eit = m_entity_component_ref_map.find(entity_id);
-	if (eit == m_entity_component_ref_map.end())
+	const auto it = m_component_ref_entities.find(component_id);
+	if (it == m_component_ref_entities.end())
 		return;
 
-	auto& component_map = eit->second;
+	cu::SwapPop(it->second, entity_id);
+}
+
+auto EntityAdmin::GetComponentRefs(EntityID entity_id) const -> ComponentRefs&
+{
+	assert(FindRecord(entity_id) != nullptr && "Entity is not registered");
+
+	const auto index = GetEntityIndex(entity_id);
 
-	const auto cit = component_map.find(component_id);
-	if (cit == component_map.end())
+	if (index >= m_entity_component_refs.size())
+		m_entity_component_refs.resize(index + 1);
+
+	return m_entity_component_refs[index];
+}
+
+auto EntityAdmin::FindComponentRefs(EntityID entity_id) const -> ComponentRefs*
+{
+	const auto index = GetEntityIndex(entity_id);
+
+	if (index >= m_entity_component_refs.size())
+		return nullptr;
+
+	return &m_entity_component_refs[index];
+}
+
+void EntityAdmin::UpdateComponentRef(EntityID entity_id, ComponentTypeID component_id, void* new_component) const
+{
+	ComponentRefs* refs = FindComponentRefs(entity_id);
+	if (refs == nullptr)
+		return;
+
+	const auto cit = FindComponentRef(*refs, component_id);
+	if (cit == refs->end())
 		return;
 
 	DataRef& ref = cit->second;
@@ -725,7 +1138,8 @@ void EntityAdmin::UpdateComponentRef(EntityID entity_id, ComponentTypeID compone
 	{
 		if (ref.component_ptr.expired())
 		{
-			component_map.erase(component_id);
+			refs->erase(cit);
+			EraseRefEntity(component_id, entity_id);
 		}
 		else *ref.component_ptr.lock() = new_component;
 	}
@@ -734,7 +1148,8 @@ void EntityAdmin::UpdateComponentRef(EntityID entity_id, ComponentTypeID compone
 	{
 		if (ref.base_ptr.expired())
 		{
-			component_map.erase(component_id);
+			refs->erase(cit);
+			EraseRefEntity(component_id, entity_id);
 		}
 		else
 		{
@@ -747,7 +1162,8 @@ void EntityAdmin::UpdateComponentRef(EntityID entity_id, ComponentTypeID compone
 	{
 		if (ref.component_ptr.expired() && ref.base_ptr.expired())
 		{
-			component_map.erase(component_id);
+			refs->erase(cit);
+			EraseRefEntity(component_id, entity_id);
 		}
 		else
 		{
@@ -809,10 +1225,7 @@ void EntityAdmin::ClearEmptyTypeArchetypes()
 				m_archetype_map.erase(archetype->id);
 
 				for (EntityID entity_id : archetype->entities)
-				{
-					m_entity_archetype_map.erase(entity_id);
-					m_reusable_entity_ids.emplace_back(entity_id);
-				}
+					ReleaseEntity(entity_id);
 
 				return true;
 			}
@@ -828,31 +1241,28 @@ void EntityAdmin::ConstructSwap(
 	EntityID entity_id, const Record& record,
 	EntityID last_entity_id, Record& last_record) const
 {
+	MakeRoom(new_archetype);
+
+	const auto new_index = new_archetype->entities.size();
+
 	for (std::size_t i = 0, j = 0; i < new_archetype->type.size(); ++i)
 	{
 		const auto component_id		= new_archetype->type[i];
 		const auto component		= m_component_map.at(component_id).get();
-		const auto component_size	= component->GetSize();
-
-		const auto current_size		= new_archetype->entities.size() * component_size;
-		const auto new_size			= current_size + component_size;
-
-		if (new_size > new_archetype->component_data_size[i])
-			MakeRoom(new_archetype, component, component_size, i);
 
 		if (j < old_archetype->type.size() && component_id != old_archetype->type[j])
 		{
-			component->ConstructData(*this, entity_id, &new_archetype->component_data[i][current_size]);
+			component->ConstructData(*this, entity_id, new_archetype->GetData(i, new_index));
 		}
 		else
 		{
-			component->MoveDestroyData(*this, entity_id,
-				&old_archetype->component_data[j][record.index * component_size],
-				&new_archetype->component_data[i][current_size]);
+			RelocateData(component_id, component, entity_id,
+				old_archetype->GetData(j, record.index),
+				new_archetype->GetData(i, new_index));
 
-			component->MoveDestroyData(*this, last_entity_id,
-				&old_archetype->component_data[j][last_record.index * component_size],
-				&old_archetype->component_data[j][record.index * component_size]); // move data from last to current
+			RelocateData(component_id, component, last_entity_id,
+				old_archetype->GetData(j, last_record.index),
+				old_archetype->GetData(j, record.index)); // move data from last to current
 
 			++j;
 		}
@@ -860,6 +1270,8 @@ void EntityAdmin::ConstructSwap(
 
 	old_archetype->entities[record.index] = last_entity_id;
 	last_record.index = record.index;
+
+	old_archetype->MarkEntityChanged(record.index, m_change_tick);
 }
 
 void EntityAdmin::Construct(
@@ -869,27 +1281,24 @@ void EntityAdmin::Construct(
 	const auto new_size = new_archetype->type.size();
 	const auto old_size = old_archetype->type.size();
 
+	MakeRoom(new_archetype);
+
+	const auto new_index = new_archetype->entities.size();
+
 	for (std::size_t i = 0, j = 0; i < new_size; ++i)
 	{
 		const auto component_id		= new_archetype->type[i];
 		const auto component		= m_component_map.at(component_id).get();
-		const auto component_size	= component->GetSize();
-
-		const auto current_size		= new_archetype->entities.size() * component_size;
-		const auto new_size			= current_size + component_size;
-
-		if (new_size > new_archetype->component_data_size[i])
-			MakeRoom(new_archetype, component, component_size, i);
 
 		if (j == old_size || component_id != old_archetype->type[j])
 		{
-			component->ConstructData(*this, entity_id, &new_archetype->component_data[i][current_size]);
+			component->ConstructData(*this, entity_id, new_archetype->GetData(i, new_index));
 		}
 		else
 		{
-			component->MoveDestroyData(*this, entity_id,
-				&old_archetype->component_data[j][record.index * component_size],
-				&new_archetype->component_data[i][current_size]);
+			RelocateData(component_id, component, entity_id,
+				old_archetype->GetData(j, record.index),
+				new_archetype->GetData(i, new_index));
 
 			++j;
 		}
@@ -904,38 +1313,37 @@ void EntityAdmin::DestructSwap(
 	const auto new_size = new_archetype->type.size();
 	const auto old_size = old_archetype->type.size();
 
+	MakeRoom(new_archetype); // make room to fit data
+
+	const auto new_index = new_archetype->entities.size();
+
 	for (std::size_t i = 0, j = 0; i < old_size; ++i) // we iterate over both archetypes
 	{
 		const auto component_id		= old_archetype->type[i];
 		const auto component		= m_component_map.at(component_id).get();
-		const auto component_size	= component->GetSize();
 
 		if (j == new_size || component_id != new_archetype->type[j])
 		{
-			component->DestroyData(*this, entity_id, &old_archetype->component_data[i][record.index * component_size]);
+			component->DestroyData(*this, entity_id, old_archetype->GetData(i, record.index));
 		}
 		else
 		{
-			const auto current_size = new_archetype->entities.size() * component_size;
-			const auto new_size = current_size + component_size;
-
-			if (new_size > new_archetype->component_data_size[j])
-				MakeRoom(new_archetype, component, component_size, j); // make room to fit data
-
-			component->MoveDestroyData(*this, entity_id,
-				&old_archetype->component_data[i][record.index * component_size],
-				&new_archetype->component_data[j][current_size]); // move all the valid data from old to new
+			RelocateData(component_id, component, entity_id,
+				old_archetype->GetData(i, record.index),
+				new_archetype->GetData(j, new_index)); // move all the valid data from old to new
 
 			++j;
 		}
 
-		component->MoveDestroyData(*this, last_entity_id,
-			&old_archetype->component_data[i][last_record.index * component_size],
-			&old_archetype->component_data[i][record.index * component_size]); // move data to last
+		RelocateData(component_id, component, last_entity_id,
+			old_archetype->GetData(i, last_record.index),
+			old_archetype->GetData(i, record.index)); // move data to last
 	}
 
 	old_archetype->entities[record.index] = last_entity_id; // now swap ids
 	last_record.index = record.index;
+
+	old_archetype->MarkEntityChanged(record.index, m_change_tick);
 }
 
 void EntityAdmin::Destruct(
@@ -945,47 +1353,266 @@ void EntityAdmin::Destruct(
 	const auto new_size = new_archetype->type.size();
 	const auto old_size = old_archetype->type.size();
 
+	MakeRoom(new_archetype); // make room to fit data
+
+	const auto new_index = new_archetype->entities.size();
+
 	for (std::size_t i = 0, j = 0; i < old_size; ++i) // we iterate over both archetypes
 	{
 		const auto component_id		= old_archetype->type[i];
 		const auto component		= m_component_map.at(component_id).get();
-		const auto component_size	= component->GetSize();
 
 		if (j == new_size || component_id != new_archetype->type[j]) // this is the component that should be destroyed
 		{
-			component->DestroyData(*this, entity_id, &old_archetype->component_data[i][record.index * component_size]);
+			component->DestroyData(*this, entity_id, old_archetype->GetData(i, record.index));
 		}
 		else
 		{
-			const auto current_size = new_archetype->entities.size() * component_size;
-			const auto new_size = current_size + component_size;
+			RelocateData(component_id, component, entity_id,
+				old_archetype->GetData(i, record.index),
+				new_archetype->GetData(j, new_index)); // move all the valid data from old to new
 
-			if (new_size > new_archetype->component_data_size[j])
-				MakeRoom(new_archetype, component, component_size, j); // make room to fit data
+			++j;
+		}
+	}
+}
 
-			component->MoveDestroyData(*this, entity_id,
-				&old_archetype->component_data[i][record.index * component_size],
-				&new_archetype->component_data[j][current_size]); // move all the valid data from old to new
+void EntityAdmin::MakeRoom(Archetype* archetype, std::size_t count) const
+{
+	while (archetype->entities.size() + count > archetype->GetCapacity()) // existing chunks stay in place
+		archetype->chunks.emplace_back(std::make_unique_for_overwrite<ByteArray>(archetype->chunk_size));
 
-			++j;
+	archetype->versions.resize(archetype->chunks.size() * archetype->type.size(), m_change_tick);
+}
+
+Archetype* EntityAdmin::GetAddArchetype(Archetype* old_archetype, ComponentIDSpan component_ids, ArchetypeID archetype_id)
+{
+	if (const auto ait = old_archetype->edges.find(archetype_id); ait != old_archetype->edges.end())
+		return ait->second.add;
+
+	ComponentIDs new_archetype_id = old_archetype->type; // create copy
+
+	bool found = false;
+	for (ComponentTypeID component_id : component_ids) // determine valid components
+	{
+		if (cu::InsertUniqueSorted<ComponentTypeID>(new_archetype_id, component_id)) // insert while keeping the vector sorted (this should ensure that the archetype is always sorted)
+			found = true;
+	}
+
+	if (!found) // unable to add any component
+		return nullptr;
+
+	Archetype* new_archetype = GetArchetype(new_archetype_id, cu::ContainerHash<ComponentTypeID>()(new_archetype_id));
+
+	old_archetype->edges[archetype_id].add = new_archetype;
+	new_archetype->edges[archetype_id].rmv = old_archetype;
+
+	assert(new_archetype_id != old_archetype->type);
+	assert(new_archetype_id == new_archetype->type);
+
+	return new_archetype;
+}
+
+Archetype* EntityAdmin::GetRemoveArchetype(Archetype* old_archetype, ComponentIDSpan component_ids, ArchetypeID archetype_id)
+{
+	if (const auto ait = old_archetype->edges.find(archetype_id); ait != old_archetype->edges.end())
+		return ait->second.rmv;
+
+	ComponentIDs new_archetype_id = old_archetype->type; // create copy
+
+	bool found = false;
+	for (ComponentTypeID component_id : component_ids) // erase while keeping the vector sorted
+	{
+		if (cu::EraseUniqueSorted<ComponentTypeID>(new_archetype_id, component_id))
+			found = true;
+	}
+
+	if (!found) // unable to remove any component
+		return nullptr;
+
+	Archetype* new_archetype = GetArchetype(new_archetype_id, cu::ContainerHash<ComponentTypeID>()(new_archetype_id));
+
+	new_archetype->edges[archetype_id].add = old_archetype;
+	old_archetype->edges[archetype_id].rmv = new_archetype;
+
+	return new_archetype;
+}
+
+void EntityAdmin::Migrate(Archetype* old_archetype, Archetype* new_archetype, EntitySpan entities, bool add)
+{
+	if (entities.size() == old_archetype->entities.size()) // entire archetype is moved, its columns can be moved in whole
+	{
+		MigrateAll(old_archetype, new_archetype);
+		return;
+	}
+
+	MakeRoom(new_archetype, entities.size()); // reserve once for all
+
+	for (const EntityID entity_id : entities)
+	{
+		Record& record = GetRecord(entity_id);
+		EntityID last_entity_id = old_archetype->entities.back();
+
+		if (last_entity_id != entity_id)
+		{
+			Record& last_record = GetRecord(last_entity_id);
+
+			if (add)
+				ConstructSwap(new_archetype, old_archetype, entity_id, record, last_entity_id, last_record);
+			else
+				DestructSwap(old_archetype, new_archetype, entity_id, record, last_entity_id, last_record);
+		}
+		else
+		{
+			if (add)
+				Construct(new_archetype, old_archetype, entity_id, record);
+			else
+				Destruct(old_archetype, new_archetype, entity_id, record);
 		}
+
+		old_archetype->entities.pop_back();
+		new_archetype->entities.emplace_back(entity_id);
+
+		record.index		= static_cast<IDType>(new_archetype->entities.size() - 1);
+		record.archetype	= new_archetype;
+
+		new_archetype->MarkEntityChanged(record.index, m_change_tick);
 	}
 }
 
-void EntityAdmin::MakeRoom(Archetype* archetype, const IComponentAlloc* component, std::size_t data_size, std::size_t i) const
+void EntityAdmin::MigrateAll(Archetype* old_archetype, Archetype* new_archetype)
 {
-	std::size_t new_size = 2 * archetype->component_data_size[i] + data_size;
-	auto new_data = std::make_unique_for_overwrite<ByteArray>(new_size);
+	const auto count = old_archetype->entities.size();
+	const auto first = new_archetype->entities.size();
+
+	MakeRoom(new_archetype, count);
 
-	for (std::size_t j = 0; j < archetype->entities.size(); ++j)
+	const EntitySpan entities = old_archetype->entities;
+
+	const auto MoveColumn = [&](std::size_t i, std::size_t j) // moves in runs that do not cross the chunks of either archetype
 	{
-		component->MoveDestroyData(*this, archetype->entities[j],
-			&archetype->component_data[i][j * data_size],
-			&new_data[j * data_size]);
+		const auto component_id = new_archetype->type[i];
+		const auto component	= m_component_map.at(component_id).get();
+
+		for (std::size_t k = 0; k < count;)
+		{
+			const auto old_slot = k % old_archetype->chunk_capacity;
+			const auto new_slot = (first + k) % new_archetype->chunk_capacity;
+
+			const auto run = std::min({ count - k, 
+				old_archetype->chunk_capacity - old_slot, 
+				new_archetype->chunk_capacity - new_slot });
+
+			RelocateData(component_id, component, entities.subspan(k, run),
+				old_archetype->GetData(j, k), new_archetype->GetData(i, first + k));
+
+			k += run;
+		}
+	};
+
+	const auto ConstructColumn = [&](std::size_t i)
+	{
+		const auto component = m_component_map.at(new_archetype->type[i]).get();
+
+		for (std::size_t k = 0; k < count; ++k)
+			component->ConstructData(*this, entities[k], new_archetype->GetData(i, first + k));
+	};
+
+	const auto DestroyColumn = [&](std::size_t j)
+	{
+		const auto component = m_component_map.at(old_archetype->type[j]).get();
+
+		for (std::size_t k = 0; k < count; ++k)
+			component->DestroyData(*this, entities[k], old_archetype->GetData(j, k));
+	};
+
+	std::size_t i = 0, j = 0;
+	for (; i < new_archetype->type.size(); ++i) // both types are sorted, walk through them together
+	{
+		for (; j < old_archetype->type.size() && old_archetype->type[j] < new_archetype->type[i]; ++j)
+			DestroyColumn(j);
+
+		if (j < old_archetype->type.size() && old_archetype->type[j] == new_archetype->type[i])
+			MoveColumn(i, j++);
+		else
+			ConstructColumn(i);
+	}
+
+	for (; j < old_archetype->type.size(); ++j)
+		DestroyColumn(j);
+
+	for (std::size_t k = 0; k < count; ++k)
+	{
+		Record& record = GetRecord(entities[k]);
+
+		record.index		= static_cast<IDType>(first + k);
+		record.archetype	= new_archetype;
+	}
+
+	new_archetype->entities.insert(new_archetype->entities.end(), 
+		old_archetype->entities.begin(), old_archetype->entities.end());
+	old_archetype->entities.clear();
+
+	for (std::size_t k = first / new_archetype->chunk_capacity; k < new_archetype->GetChunkCount(); ++k) // every chunk that received entities
+		new_archetype->MarkEntityChanged(k * new_archetype->chunk_capacity, m_change_tick);
+}
+
+bool EntityAdmin::IsRelocatable(ComponentTypeID component_id, const IComponentAlloc* component) const
+{
+	if (!component->IsTriviallyRelocatable())
+		return false;
+
+	if (const auto it = m_events_move.find(component_id); it != m_events_move.end() && !it->second.IsEmpty())
+		return false;
+
+	if (const auto it = m_component_ref_entities.find(component_id); it != m_component_ref_entities.end() && !it->second.empty())
+		return false;
+
+	return true;
+}
+
+void EntityAdmin::RelocateData(ComponentTypeID component_id, const IComponentAlloc* component, EntityID entity_id, DataPtr source, DataPtr destination) const
+{
+	if (IsRelocatable(component_id, component))
+	{
+		std::memcpy(destination, source, component->GetSize());
+	}
+	else component->MoveDestroyData(*this, entity_id, source, destination);
+}
+
+void EntityAdmin::RelocateData(ComponentTypeID component_id, const IComponentAlloc* component, EntitySpan entities, DataPtr source, DataPtr destination) const
+{
+	const auto component_size = component->GetSize();
+
+	if (IsRelocatable(component_id, component))
+	{
+		std::memcpy(destination, source, entities.size() * component_size);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < entities.size(); ++i)
+		{
+			component->MoveDestroyData(*this, entities[i], 
+				source + i * component_size, 
+				destination + i * component_size);
+		}
+	}
+}
+
+void EntityAdmin::ReleaseEntity(EntityID entity_id)
+{
+	Record& record = GetRecord(entity_id);
+	record = Record{};
+
+	if (ComponentRefs* refs = FindComponentRefs(entity_id); refs != nullptr) // the index is reused by the next entity
+	{
+		for (const auto& [component_id, ref] : *refs)
+			EraseRefEntity(component_id, entity_id);
+
+		refs->clear();
 	}
 
-	archetype->component_data[i] = std::move(new_data);
-	archetype->component_data_size[i] = new_size;
+	m_reusable_entity_ids.emplace_back(MakeEntityID(GetEntityIndex(entity_id), GetEntityVersion(entity_id) + 1));
 }
 
 void EntityAdmin::Destroy()
@@ -1000,23 +1627,23 @@ void EntityAdmin::Destroy()
 			{
 				const auto component_id = archetype->type[i];
 				const auto component = m_component_map[component_id].get();
-				const auto component_size = component->GetSize();
 
 				for (std::size_t j = 0; j < archetype->entities.size(); ++j)
-					component->Shutdown(*this, archetype->entities[j], &archetype->component_data[i][j * component_size]);
+					component->Shutdown(*this, archetype->entities[j], archetype->GetData(i, j));
 			}
 		}
 
 		if (m_shutdown) // additional cleanup if shutdown
 		{
-			m_entity_archetype_map.clear(); // deregister all entities
+			m_entity_records.clear(); // deregister all entities
 			m_archetypes.clear();
-			m_archetype_cache.clear();
+			RebuildQueries(); // queries are kept since systems may still point to them
 			m_systems.clear();
+			m_schedules.clear();
 
-			for (auto& [entity_id, component_map] : m_entity_component_ref_map) // clear all references
+			for (ComponentRefs& component_refs : m_entity_component_refs) // clear all references
 			{
-				for (auto& [component_id, ref] : component_map)
+				for (auto& [component_id, ref] : component_refs)
 				{
 					switch (ref.flag)
 					{
@@ -1045,7 +1672,8 @@ void EntityAdmin::Destroy()
 				}
 			}
 
-			m_entity_component_ref_map.clear();
+			m_entity_component_refs.clear();
+			m_component_ref_entities.clear();
 		}
 
 		m_destroyed = true;
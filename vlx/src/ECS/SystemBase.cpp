@@ -1,14 +1,67 @@
 #include <Velox/ECS/SystemBase.h>
 
+#include <typeinfo>
+#include <string>
+#include <memory>
+#include <cstdlib>
+
+#if defined(__GNUG__)
+#	include <cxxabi.h>
+#endif
+
+#include <Velox/System/Profiler.h>
+
 using namespace vlx;
 
+namespace
+{
+	std::string Demangle(const char* name)
+	{
+#if defined(__GNUG__)
+		int status = 0;
+		const std::unique_ptr<char, decltype(&std::free)> demangled(
+			abi::__cxa_demangle(name, nullptr, nullptr, &status), &std::free);
+
+		return (status == 0 && demangled != nullptr) ? std::string(demangled.get()) : std::string(name);
+#else
+		std::string_view result(name); // msvc already gives readable names, prefixed with the kind of type
+
+		for (const std::string_view prefix : { "class ", "struct " })
+		{
+			if (result.starts_with(prefix))
+				result.remove_prefix(prefix.size());
+		}
+
+		return std::string(result);
+#endif
+	}
+}
+
+const char* SystemBase::GetName() const
+{
+	if (m_name == nullptr)
+		m_name = Profiler::Intern(Demangle(typeid(*this).name()));
+
+	return m_name;
+}
+
 float SystemBase::GetPriority() const noexcept		{ return m_priority; }
 bool SystemBase::IsRunningParallel() const noexcept { return m_run_parallel; }
 bool SystemBase::IsEnabled() const noexcept			{ return m_enabled; }
+std::size_t SystemBase::GetBatchSize() const noexcept	{ return m_batch_size; }
+uint32 SystemBase::GetRunTick() const noexcept		{ return m_run_tick; }
+uint32 SystemBase::GetLastRunTick() const noexcept	{ return m_last_run_tick; }
 
+void SystemBase::SetName(std::string_view name)	{ m_name = Profiler::Intern(name); }
 void SystemBase::SetPriority(float val)		{ m_priority = val; }
 void SystemBase::SetRunParallel(bool flag)	{ m_run_parallel = flag; }
 void SystemBase::SetEnabled(bool flag)		{ m_enabled = flag; }
+void SystemBase::SetBatchSize(std::size_t size)	{ m_batch_size = std::max<std::size_t>(size, 1); }
+
+ComponentIDSpan SystemBase::GetExcludeKey() const	{ return {}; }
+ComponentIDSpan SystemBase::GetChangedKey() const	{ return {}; }
+ComponentIDSpan SystemBase::GetReadKey() const		{ return {}; }
+ComponentIDSpan SystemBase::GetWriteKey() const		{ return GetArchKey(); }
 
 void SystemBase::Start() const {}
 void SystemBase::End() const {}
\ No newline at end of file
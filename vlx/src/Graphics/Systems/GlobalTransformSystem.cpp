@@ -38,7 +38,7 @@ GlobalTransformSystem::GlobalTransformSystem(EntityAdmin& entity_admin, LayerTyp
 		});
 
 	m_update_pos.Each(
-		[](GlobalTransformDirty& gtd, GlobalTransformMatrix& gtm, GlobalTransformTranslation& gtt)
+		[](GlobalTransformDirty& gtd, const GlobalTransformMatrix& gtm, GlobalTransformTranslation& gtt)
 		{
 			if (gtd.m_update_position)
 			{
@@ -48,7 +48,7 @@ GlobalTransformSystem::GlobalTransformSystem(EntityAdmin& entity_admin, LayerTyp
 		});
 
 	m_update_rot.Each(
-		[](GlobalTransformDirty& gtd, GlobalTransformMatrix& gtm, GlobalTransformRotation& gtr)
+		[](GlobalTransformDirty& gtd, const GlobalTransformMatrix& gtm, GlobalTransformRotation& gtr)
 		{
 			if (gtd.m_update_rotation)
 			{
@@ -58,7 +58,7 @@ GlobalTransformSystem::GlobalTransformSystem(EntityAdmin& entity_admin, LayerTyp
 		});
 
 	m_update_scl.Each(
-		[](GlobalTransformDirty& gtd, GlobalTransformMatrix& gtm, GlobalTransformScale& gts)
+		[](GlobalTransformDirty& gtd, const GlobalTransformMatrix& gtm, GlobalTransformScale& gts)
 		{
 			if (gtd.m_update_scale)
 			{
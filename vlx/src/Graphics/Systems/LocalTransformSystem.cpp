@@ -8,8 +8,6 @@ LocalTransformSystem::LocalTransformSystem(EntityAdmin& entity_admin, LayerType
 	m_sync.Each(
 		[](Transform& t, TransformMatrix& tm)
 		{
-			// TODO: consider implementing TransformChanging component that tracks changes instead of doing it brute-force as it is now
-
 			if (t.m_update_rot)
 			{
 				tm.matrix.Rebuild(t.GetScale(), t.GetRotation());
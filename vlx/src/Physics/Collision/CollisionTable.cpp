@@ -340,9 +340,15 @@ LocalManifold CollisionTable::PolygonToPolygon(
 		lm.type = LocalManifold::Type::FaceB;
 	}
 
+	FaceIDs incident_ids;
 	Face incident_face = FindIncidentFace(
 		*inc_transform, inc_vertices, inc_normals,
-		*ref_transform, ref_normals[ref_idx]);
+		*ref_transform, ref_normals[ref_idx], incident_ids);
+
+	// identify the points by the reference face and which incident vertex or side plane they came from, 
+	// so that the solver can match them with the points from the previous step
+
+	const uint32 ref_id = (ref_idx << 8) | ((lm.type == LocalManifold::Type::FaceB) ? LocalManifold::ID_FLIP : 0);
 
 	Vector2f l1 = ref_vertices[ref_idx];
 	Vector2f v1 = ref_transform->Transform(l1);
@@ -357,10 +363,10 @@ LocalManifold CollisionTable::PolygonToPolygon(
 	float neg_side = -side_normal.Dot(v1) + radius;
 	float pos_side = side_normal.Dot(v2) + radius;
 
-	if (Clip(incident_face, -side_normal, neg_side) < 2)
+	if (Clip(incident_face, incident_ids, -side_normal, neg_side, LocalManifold::ID_CLIPPED | 0) < 2)
 		return lm;
 
-	if (Clip(incident_face, side_normal, pos_side) < 2)
+	if (Clip(incident_face, incident_ids, side_normal, pos_side, LocalManifold::ID_CLIPPED | 1) < 2)
 		return lm;
 
 	lm.normal	= Vector2f::Direction(l1, l2).Normalize().Orthogonal();
@@ -377,6 +383,7 @@ LocalManifold CollisionTable::PolygonToPolygon(
 		{
 			typename LocalManifold::Point& contact = lm.contacts[cp++];
 			contact.point = inc_transform->Inverse(incident_face[i]);
+			contact.id = ref_id | incident_ids[i];
 		}
 	}
 
@@ -435,7 +442,7 @@ std::tuple<float, uint32> CollisionTable::FindAxisLeastPenetration(
 
 auto CollisionTable::FindIncidentFace(
 	const SimpleTransform& t1, VectorSpan vs1, VectorSpan ns1,
-	const SimpleTransform& t2, const Vector2f& n2) -> Face
+	const SimpleTransform& t2, const Vector2f& n2, FaceIDs& ids) -> Face
 {
 	// calculate normal in the incident's space
 	Vector2f normal = t1.GetRotation().Inverse(t2.GetRotation().Transform(n2)); // world space -> incident model space
@@ -456,23 +463,26 @@ auto CollisionTable::FindIncidentFace(
 	Face face;
 
 	face[0] = t1.Transform(vs1[face_index]);
+	ids[0] = face_index;
 	face_index = (face_index + 1) == (uint32)ns1.size() ? 0 : face_index + 1;
 	face[1] = t1.Transform(vs1[face_index]);
+	ids[1] = face_index;
 
 	return face;
 }
 
-int CollisionTable::Clip(Face& face, const Vector2f& normal, float offset)
+int CollisionTable::Clip(Face& face, FaceIDs& ids, const Vector2f& normal, float offset, uint32 clip_id)
 {
-	Face out = face;
-	int  op  = 0; // num of out points
+	Face	out		= face;
+	FaceIDs	out_ids	= ids;
+	int		op		= 0; // num of out points
 
 	float d1 = normal.Dot(face[0]) - offset;
 	float d2 = normal.Dot(face[1]) - offset;
 
 	// if negative they are behind the plane
-	if (d1 <= 0.0f) out[op++] = face[0];
-	if (d2 <= 0.0f) out[op++] = face[1];
+	if (d1 <= 0.0f) { out_ids[op] = ids[0]; out[op++] = face[0]; }
+	if (d2 <= 0.0f) { out_ids[op] = ids[1]; out[op++] = face[1]; }
 
 	// if they are on different sides
 	if (d1 * d2 < 0.0f)
@@ -481,12 +491,16 @@ int CollisionTable::Clip(Face& face, const Vector2f& normal, float offset)
 
 		float alpha = d1 / (d1 - d2); // intersection point of edge and plane
 		out[op] = face[0] + alpha * (face[1] - face[0]); 
+		out_ids[op] = clip_id; // new point, identified by the plane that clipped it
 		++op;
 	}
 
 	face[0] = out[0];
 	face[1] = out[1];
 
+	ids[0] = out_ids[0];
+	ids[1] = out_ids[1];
+
 	return op;
 }
 
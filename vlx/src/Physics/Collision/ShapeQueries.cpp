@@ -0,0 +1,177 @@
+#include <Velox/Physics/Collision/ShapeQueries.h>
+
+#include <cmath>
+#include <cfloat>
+
+#include <Velox/Structures/SmallVector.hpp>
+#include <Velox/Utility/PolygonUtils.h>
+
+#include <Velox/Physics/Collision/CollisionTable.h>
+#include <Velox/Physics/Collision/WorldManifold.h>
+#include <Velox/Physics/Collision/TimeOfImpact.h>
+
+using namespace vlx;
+
+namespace
+{
+	std::optional<QueryHit> GetContact(
+		const Shape& s1, typename Shape::Type st1, const SimpleTransform& t1,
+		const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2)
+	{
+		const LocalManifold lm = CollisionTable::Collide(s1, t1, st1, s2, t2, st2);
+
+		if (lm.contacts_count == 0)
+			return std::nullopt;
+
+		WorldManifold manifold;
+		manifold.Initialize(lm, t1, s1.GetRadius(), t2, s2.GetRadius());
+
+		QueryHit hit;
+		hit.point	= manifold.contacts[0];
+		hit.normal	= -manifold.normal; // the manifold normal points from the first shape to the second
+
+		return hit;
+	}
+}
+
+std::optional<QueryHit> ShapeQueries::RayCast(const Ray& ray, 
+	const Shape& shape, typename Shape::Type type, const SimpleTransform& transform)
+{
+	switch (type)
+	{
+	case Shape::Circle:
+		{
+			const Vector2f f = Vector2f::Direction(transform.GetPosition(), ray.origin);
+
+			const float a = ray.direction.LengthSq();
+			const float b = f.Dot(ray.direction);
+			const float c = f.LengthSq() - shape.GetRadiusSqr();
+
+			if (c < 0.0f || a < FLT_EPSILON) // starts inside
+				return std::nullopt;
+
+			const float discriminant = b * b - a * c;
+			if (discriminant < 0.0f)
+				return std::nullopt;
+
+			const float t = (-b - std::sqrt(discriminant)) / a;
+			if (t < 0.0f || t > 1.0f)
+				return std::nullopt;
+
+			QueryHit hit;
+			hit.point		= ray.origin + ray.direction * t;
+			hit.normal		= Vector2f::Direction(transform.GetPosition(), hit.point).Normalize();
+			hit.fraction	= t;
+
+			return hit;
+		}
+	case Shape::Box:
+	case Shape::Convex:
+		{
+			// clipped against every face in the local space of the polygon, the small rounding radius is ignored
+
+			const TimeOfImpact::Proxy proxy = TimeOfImpact::GetProxy(shape, type);
+
+			const Vector2f origin		= transform.Inverse(ray.origin);
+			const Vector2f direction	= transform.GetRotation().Inverse(ray.direction);
+
+			float lower = 0.0f;
+			float upper = 1.0f;
+
+			int32 index = -1;
+
+			for (std::size_t i = 0; i < proxy.vertices.size(); ++i)
+			{
+				const float numerator	= proxy.normals[i].Dot(Vector2f::Direction(origin, proxy.vertices[i]));
+				const float denominator = proxy.normals[i].Dot(direction);
+
+				if (denominator == 0.0f)
+				{
+					if (numerator < 0.0f) // parallel and outside of the face
+						return std::nullopt;
+				}
+				else if (denominator < 0.0f && numerator < lower * denominator) // enters through the face
+				{
+					lower = numerator / denominator;
+					index = static_cast<int32>(i);
+				}
+				else if (denominator > 0.0f && numerator < upper * denominator) // leaves through the face
+				{
+					upper = numerator / denominator;
+				}
+
+				if (upper < lower)
+					return std::nullopt;
+			}
+
+			if (index == -1) // starts inside
+				return std::nullopt;
+
+			QueryHit hit;
+			hit.point		= ray.origin + ray.direction * lower;
+			hit.normal		= transform.GetRotation().Transform(proxy.normals[index]);
+			hit.fraction	= lower;
+
+			return hit;
+		}
+	case Shape::Point:
+		return std::nullopt;
+	default:
+		throw std::runtime_error("Invalid type");
+	}
+}
+
+std::optional<QueryHit> ShapeQueries::ShapeCast(
+	const Shape& s1, typename Shape::Type st1, const SimpleTransform& t1, const Vector2f& translation,
+	const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2)
+{
+	if (auto hit = GetContact(s1, st1, t1, s2, st2, t2); hit.has_value())
+	{
+		hit->fraction = 0.0f;
+		return hit;
+	}
+
+	Sweep sweep;
+	sweep.position_start	= t1.GetPosition();
+	sweep.position_end		= t1.GetPosition() + translation;
+	sweep.rotation_start	= sf::radians(t1.GetRotation().GetAngle());
+	sweep.rotation_end		= sweep.rotation_start;
+
+	const float toi = TimeOfImpact::Compute(s1, st1, sweep, s2, st2, t2);
+
+	if (toi >= 1.0f)
+		return std::nullopt;
+
+	// stopped slightly within the other shape, so there is a contact to take the point and normal from
+
+	const SimpleTransform t = sweep.GetTransform(toi);
+
+	QueryHit hit = GetContact(s1, st1, t, s2, st2, t2).value_or(QueryHit{ NULL_ENTITY, t.GetPosition(), -translation.Normalize() });
+	hit.fraction = toi;
+
+	return hit;
+}
+
+bool ShapeQueries::Overlaps(
+	const Shape& s1, typename Shape::Type st1, const SimpleTransform& t1,
+	const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2)
+{
+	return CollisionTable::Collide(s1, t1, st1, s2, t2, st2).contacts_count > 0;
+}
+
+RectFloat ShapeQueries::ComputeAABB(const Shape& shape, typename Shape::Type type, const SimpleTransform& transform)
+{
+	const TimeOfImpact::Proxy proxy = TimeOfImpact::GetProxy(shape, type);
+
+	SmallVector<Vector2f, 8> vertices;
+	for (const Vector2f& vertex : proxy.vertices)
+		vertices.push_back(transform.Transform(vertex));
+
+	const RectFloat aabb = py::ComputeAABB(std::span<const Vector2f>(vertices.data(), vertices.size()));
+
+	return RectFloat(
+		aabb.left	- proxy.radius, 
+		aabb.top	- proxy.radius, 
+		aabb.width	+ proxy.radius * 2.0f, 
+		aabb.height + proxy.radius * 2.0f);
+}
\ No newline at end of file
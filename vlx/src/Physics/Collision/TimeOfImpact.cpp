@@ -0,0 +1,183 @@
+#include <Velox/Physics/Collision/TimeOfImpact.h>
+
+#include <array>
+#include <cmath>
+#include <algorithm>
+#include <cfloat>
+
+#include <Velox/Structures/SmallVector.hpp>
+
+#include <Velox/Physics/Shapes/Box.h>
+#include <Velox/Physics/Shapes/Polygon.h>
+
+#include <Velox/Physics/PhysicsCommon.hpp>
+
+using namespace vlx;
+
+namespace
+{
+	const std::array<Vector2f, 1> ORIGIN {}; // core of circles and points
+
+	using WorldVertices = SmallVector<Vector2f, 8>;
+}
+
+SimpleTransform Sweep::GetTransform(float t) const
+{
+	SimpleTransform transform;
+
+	transform.SetPosition(position_start + (position_end - position_start) * t);
+	transform.SetRotation(rotation_start + (rotation_end - rotation_start) * t);
+
+	return transform;
+}
+
+float TimeOfImpact::Compute(
+	const Shape& s1, typename Shape::Type st1, const Sweep& sweep,
+	const Shape& s2, typename Shape::Type st2, const SimpleTransform& t2)
+{
+	const Proxy A = GetProxy(s1, st1);
+	const Proxy B = GetProxy(s2, st2);
+
+	// stop a bit within the radii, same as the allowed penetration, so that the contact exists on the next step
+
+	const float target		= std::max(P_SLOP - A.radius - B.radius, -3.0f * P_SLOP);
+	const float tolerance	= 0.25f * P_SLOP;
+
+	float extent = 0.0f; // furthest any point of the shape is from its origin, for how far rotation may move it
+	for (const Vector2f& vertex : A.vertices)
+		extent = std::max(extent, vertex.Length());
+
+	extent += A.radius;
+
+	// no point of the shape moves faster than this over the sweep, so it can always be advanced by the distance
+	// divided by this without passing through
+
+	const float bound = Vector2f::Direction(sweep.position_start, sweep.position_end).Length() +
+		std::abs((sweep.rotation_end - sweep.rotation_start).asRadians()) * extent;
+
+	float t = 0.0f;
+	for (int32 i = 0; i < MAX_ITERATIONS; ++i)
+	{
+		const float distance = Distance(A, sweep.GetTransform(t), B, t2);
+
+		if (distance <= target + tolerance)
+			return (i == 0) ? 1.0f : t; // touching from the start is left to the regular contact
+
+		if (bound <= FLT_EPSILON)
+			return 1.0f;
+
+		t += (distance - target) / bound;
+
+		if (t >= 1.0f)
+			return 1.0f;
+	}
+
+	return t; // close enough, has not passed through yet
+}
+
+float TimeOfImpact::Distance(
+	const Shape& s1, const SimpleTransform& t1, typename Shape::Type st1,
+	const Shape& s2, const SimpleTransform& t2, typename Shape::Type st2)
+{
+	return Distance(GetProxy(s1, st1), t1, GetProxy(s2, st2), t2);
+}
+
+auto TimeOfImpact::GetProxy(const Shape& shape, typename Shape::Type type) -> Proxy
+{
+	switch (type)
+	{
+	case Shape::Box:
+		{
+			const Box& box = reinterpret_cast<const Box&>(shape); // cast is assumed safe in this kind of context
+			return Proxy{ box.GetVertices(), Box::NORMALS, box.GetRadius() };
+		}
+	case Shape::Convex:
+		{
+			const Polygon& polygon = reinterpret_cast<const Polygon&>(shape);
+			return Proxy{ polygon.GetVertices(), polygon.GetNormals(), polygon.GetRadius() };
+		}
+	case Shape::Circle:
+	case Shape::Point:
+		return Proxy{ ORIGIN, {}, shape.GetRadius() };
+	default:
+		throw std::runtime_error("Invalid type");
+	}
+}
+
+float TimeOfImpact::Distance(const Proxy& A, const SimpleTransform& t1, const Proxy& B, const SimpleTransform& t2)
+{
+	WorldVertices va;
+	WorldVertices vb;
+
+	for (const Vector2f& vertex : A.vertices)
+		va.push_back(t1.Transform(vertex));
+
+	for (const Vector2f& vertex : B.vertices)
+		vb.push_back(t2.Transform(vertex));
+
+	const auto Contains = [](const WorldVertices& vertices, VectorSpan normals, const SimpleTransform& t, const Vector2f& point)
+	{
+		if (normals.empty()) // circles and points have no area in their core
+			return false;
+
+		for (std::size_t i = 0; i < vertices.size(); ++i)
+		{
+			if (Vector2f::Direction(vertices[i], point).Dot(t.GetRotation().Transform(normals[i])) > 0.0f)
+				return false;
+		}
+
+		return true;
+	};
+
+	// one core is inside the other, otherwise their edges would have to cross if they overlap
+
+	if (Contains(vb, B.normals, t2, va[0]) || Contains(va, A.normals, t1, vb[0]))
+		return -(A.radius + B.radius);
+
+	float distance = FLT_MAX;
+
+	for (std::size_t i = 0; i < va.size(); ++i)
+	{
+		const Vector2f& p1 = va[i];
+		const Vector2f& q1 = va[(i + 1) % va.size()];
+
+		for (std::size_t j = 0; j < vb.size(); ++j)
+		{
+			const Vector2f& p2 = vb[j];
+			const Vector2f& q2 = vb[(j + 1) % vb.size()];
+
+			distance = std::min(distance, SegmentDistance(p1, q1, p2, q2));
+		}
+	}
+
+	return distance - A.radius - B.radius;
+}
+
+float TimeOfImpact::SegmentDistance(const Vector2f& p1, const Vector2f& q1, const Vector2f& p2, const Vector2f& q2)
+{
+	const Vector2f d1 = Vector2f::Direction(p1, q1);
+	const Vector2f d2 = Vector2f::Direction(p2, q2);
+
+	const float o1 = d1.Cross(Vector2f::Direction(p1, p2)); // which side of the other segment the ends are on
+	const float o2 = d1.Cross(Vector2f::Direction(p1, q2));
+	const float o3 = d2.Cross(Vector2f::Direction(p2, p1));
+	const float o4 = d2.Cross(Vector2f::Direction(p2, q1));
+
+	if (o1 * o2 < 0.0f && o3 * o4 < 0.0f) // crossing
+		return 0.0f;
+
+	return std::min(
+		std::min(PointSegmentDistance(p1, p2, q2), PointSegmentDistance(q1, p2, q2)),
+		std::min(PointSegmentDistance(p2, p1, q1), PointSegmentDistance(q2, p1, q1)));
+}
+
+float TimeOfImpact::PointSegmentDistance(const Vector2f& p, const Vector2f& a, const Vector2f& b)
+{
+	const Vector2f ab = Vector2f::Direction(a, b);
+	const float length_sqr = ab.LengthSq();
+
+	const float t = (length_sqr > FLT_EPSILON) ?
+		std::clamp(Vector2f::Direction(a, p).Dot(ab) / length_sqr, 0.0f, 1.0f) : 0.0f;
+
+	return Vector2f::Direction(a + ab * t, p).Length();
+}
\ No newline at end of file
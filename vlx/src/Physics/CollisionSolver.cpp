@@ -1,5 +1,8 @@
 #include <Velox/Physics/CollisionSolver.h>
 
+#include <bit>
+#include <numbers>
+
 #include <Velox/System/SimpleTransform.h>
 
 #include <Velox/Physics/Shapes/Shape.h>
@@ -10,46 +13,134 @@
 
 #include <Velox/Physics/BodyTransform.h>
 #include <Velox/Physics/PhysicsBody.h>
+#include <Velox/Physics/PhysicsCommon.hpp>
 
 using namespace vlx;
 
-void CollisionSolver::CreateConstraints(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds)
+namespace
 {
-	m_velocity_constraints.clear();
-	m_velocity_constraints.resize(collisions.size());
+	using namespace vlx::simd;
 
-	for (int32 i = 0; i < collisions.size(); ++i)
+	FloatW Gather(const std::vector<float>& values, const std::array<uint32, WIDTH>& indices)
 	{
-		VelocityConstraint& vc = m_velocity_constraints[i];
-		vc.contacts_count = manifolds[i].contacts_count;
+		FloatL result;
+		for (uint32 lane = 0; lane < WIDTH; ++lane)
+			result.v[lane] = values[indices[lane]];
+
+		return result.Load();
+	}
+
+	void Scatter(std::vector<float>& values, const std::array<uint32, WIDTH>& indices, uint32 mask, FloatW value)
+	{
+		FloatL result;
+		result.Store(value);
+
+		for (uint32 lane = 0; lane < WIDTH; ++lane)
+		{
+			if (mask & (1u << lane))
+				values[indices[lane]] = result.v[lane];
+		}
 	}
 }
 
-void CollisionSolver::SetupConstraints(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds, const Time& time, const Vector2f& gravity)
+void CollisionSolver::CreateConstraints(BodiesSpan bodies, CollisionSpan collisions, BatchSpan batches)
 {
-	for (int32 i = 0; i < collisions.size(); ++i)
+	SolverBodies& sb = m_solver_bodies;
+
+	sb.velocity_x.assign(1, 0.0f); // placeholder for the static bodies
+	sb.velocity_y.assign(1, 0.0f);
+	sb.angular_velocity.assign(1, 0.0f);
+	sb.inv_mass.assign(1, 0.0f);
+	sb.inv_inertia.assign(1, 0.0f);
+	sb.position_x.assign(1, 0.0f);
+	sb.position_y.assign(1, 0.0f);
+	sb.rotation.assign(1, 0.0f);
+	sb.delta_x.assign(1, 0.0f);
+	sb.delta_y.assign(1, 0.0f);
+	sb.delta_rotation.assign(1, 0.0f);
+	sb.external_x.assign(1, 0.0f);
+	sb.external_y.assign(1, 0.0f);
+	sb.external_angular.assign(1, 0.0f);
+	sb.colors.assign(1, 0);
+	sb.indices.assign(1, 0);
+
+	m_body_slots.assign(bodies.size(), -1);
+	m_contact_slots.assign(collisions.size(), UINT32_MAX); // contacts in sleeping islands are not solved
+	m_contact_colors.resize(collisions.size());
+
+	m_batches.clear();
+
+	++m_step;
+
+	for (const Islands::Batch& batch : batches)
+	{
+		const auto bodies_begin = static_cast<uint32>(sb.indices.size());
+
+		for (uint32 i = batch.contacts_begin; i < batch.contacts_end; ++i)
+		{
+			AddSolverBody(bodies, collisions[i].first);
+			AddSolverBody(bodies, collisions[i].second);
+		}
+
+		ColorBatch(collisions, batch);
+
+		m_batches.back().bodies_begin	= bodies_begin;
+		m_batches.back().bodies_end		= static_cast<uint32>(sb.indices.size());
+	}
+
+	m_velocity_constraints.clear();
+	m_velocity_constraints.resize(m_batches.empty() ? 0 : m_batches.back().constraints_end);
+}
+
+void CollisionSolver::SetupConstraints(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds, 
+	const Time& time, const Vector2f& gravity, std::size_t batch)
+{
+	using namespace simd;
+
+	SolverBodies& sb = m_solver_bodies;
+	const SolverBatch& solver_batch = m_batches[batch];
+
+	for (uint32 i = solver_batch.contacts_begin; i < solver_batch.contacts_end; ++i)
 	{
 		const CollisionPair& pair = collisions[i];
-		VelocityConstraint& vc = m_velocity_constraints[i];
+		const LocalManifold& lm = manifolds[i];
+
+		VelocityConstraint& vc = m_velocity_constraints[m_contact_slots[i] / WIDTH];
+		const uint32 lane = m_contact_slots[i] % WIDTH;
 
 		const CollisionBody& A = bodies[pair.first];
 		const CollisionBody& B = bodies[pair.second];
 
-		PhysicsBody& AB = *A.body;
-		PhysicsBody& BB = *B.body;
+		const PhysicsBody& AB = *A.body;
+		const PhysicsBody& BB = *B.body;
 
 		const BodyTransform& AT = *A.transform;
 		const BodyTransform& BT = *B.transform;
 
-		vc.restitution	= std::min(AB.GetRestitution(), BB.GetRestitution());
-		vc.friction		= std::sqrt(AB.GetFriction() * BB.GetFriction());
+		const uint32 a = m_body_slots[pair.first];
+		const uint32 b = m_body_slots[pair.second];
 
-		// wake up both if either body is dynamic or kinematic
-		if (AB.GetType() != BodyType::Static && BB.GetType() != BodyType::Static)
-		{
-			AB.SetAwake(true);
-			BB.SetAwake(true);
-		}
+		const float am = sb.inv_mass[a];
+		const float bm = sb.inv_mass[b];
+
+		const float ai = sb.inv_inertia[a];
+		const float bi = sb.inv_inertia[b];
+
+		vc.body_a[lane] = a;
+		vc.body_b[lane] = b;
+
+		vc.moves_a |= (am > 0.0f || ai > 0.0f) ? (1u << lane) : 0u;
+		vc.moves_b |= (bm > 0.0f || bi > 0.0f) ? (1u << lane) : 0u;
+
+		vc.inv_mass_a.v[lane]		= am;
+		vc.inv_mass_b.v[lane]		= bm;
+		vc.inv_inertia_a.v[lane]	= ai;
+		vc.inv_inertia_b.v[lane]	= bi;
+
+		float restitution = std::min(AB.GetRestitution(), BB.GetRestitution());
+		vc.friction.v[lane] = std::sqrt(AB.GetFriction() * BB.GetFriction());
+
+		// bodies in contact have already been woken up together with the rest of their island
 
 		SimpleTransform AW;
 		SimpleTransform BW;
@@ -61,136 +152,333 @@ void CollisionSolver::SetupConstraints(BodiesSpan bodies, CollisionSpan collisio
 		BW.SetPosition(BT.GetPosition());
 
 		WorldManifold manifold;
-		manifold.Initialize(manifolds[i],
+		manifold.Initialize(lm,
 			AW, A.shape->GetRadius(), 
 			BW, B.shape->GetRadius());
 
-		vc.normal = manifold.normal;
+		const Vector2f normal	= manifold.normal;
+		const Vector2f tangent	= Vector2f::Cross(normal, 1.0f);
+
+		vc.normal_x.v[lane] = normal.x;
+		vc.normal_y.v[lane] = normal.y;
+
+		const Vector2f va(sb.velocity_x[a], sb.velocity_y[a]);
+		const Vector2f vb(sb.velocity_x[b], sb.velocity_y[b]);
 
-		for (int32 j = 0; j < vc.contacts_count; ++j)
+		const float wa = sb.angular_velocity[a];
+		const float wb = sb.angular_velocity[b];
+
+		const CachedContact* cached = nullptr;
+		if (m_warm_starting)
+		{
+			const auto it = m_contact_cache.find(GetPairKey(A, B));
+			if (it != m_contact_cache.end())
+				cached = &it->second;
+		}
+
+		for (int32 j = 0; j < lm.contacts_count; ++j)
 		{
 			typename VelocityConstraint::Contact& contact = vc.contacts[j];
 
-			contact.ra = manifold.contacts[j] - AT.GetPosition();
-			contact.rb = manifold.contacts[j] - BT.GetPosition();
+			const Vector2f ra = manifold.contacts[j] - AT.GetPosition();
+			const Vector2f rb = manifold.contacts[j] - BT.GetPosition();
+
+			contact.ra_x.v[lane] = ra.x;
+			contact.ra_y.v[lane] = ra.y;
+			contact.rb_x.v[lane] = rb.x;
+			contact.rb_y.v[lane] = rb.y;
+
+			contact.separation.v[lane] = -manifold.penetrations[j];
 
 			{
-				float rna = contact.ra.Cross(vc.normal);
-				float rnb = contact.rb.Cross(vc.normal);
+				float rna = ra.Cross(normal);
+				float rnb = rb.Cross(normal);
 
-				float k_normal = AB.GetInvMass() + BB.GetInvMass() +
-					AB.GetInvInertia() * au::Sqr(rna) + BB.GetInvInertia() * au::Sqr(rnb);
+				float k_normal = am + bm + ai * au::Sqr(rna) + bi * au::Sqr(rnb);
 
-				contact.mass_normal = (k_normal > 0.0f) ? (1.0f / k_normal) : 0.0f;
+				contact.mass_normal.v[lane] = (k_normal > 0.0f) ? (1.0f / k_normal) : 0.0f;
 			}
 
 			{
-				Vector2f tangent = Vector2f::Cross(vc.normal, 1.0f);
-
-				float rta = contact.ra.Cross(tangent);
-				float rtb = contact.rb.Cross(tangent);
+				float rta = ra.Cross(tangent);
+				float rtb = rb.Cross(tangent);
 
-				float k_tangent = AB.GetInvMass() + BB.GetInvMass() +
-					AB.GetInvInertia() * au::Sqr(rta) + BB.GetInvInertia() * au::Sqr(rtb);
+				float k_tangent = am + bm + ai * au::Sqr(rta) + bi * au::Sqr(rtb);
 
-				contact.mass_tangent = (k_tangent > 0.0f) ? (1.0f / k_tangent) : 0.0f;
+				contact.mass_tangent.v[lane] = (k_tangent > 0.0f) ? (1.0f / k_tangent) : 0.0f;
 			}
 
-			Vector2f rv = BB.GetVelocity() + Vector2f::Cross(BB.GetAngularVelocity(), contact.rb) -
-						  AB.GetVelocity() - Vector2f::Cross(AB.GetAngularVelocity(), contact.ra);
+			Vector2f rv = vb + Vector2f::Cross(wb, rb) - va - Vector2f::Cross(wa, ra);
 
 			if (rv.LengthSq() < (gravity * time.GetFixedDT()).LengthSq() + FLT_EPSILON)
-				vc.restitution = 0.0f;
+				restitution = 0.0f;
+
+			contact.velocity_bias.v[lane] = -restitution * std::min(rv.Dot(normal), 0.0f); // bounce off at the approaching velocity
+
+			if (cached == nullptr)
+				continue;
+
+			for (int32 k = 0; k < cached->points_count; ++k) // match the points by the features that produced them
+			{
+				if (cached->points[k].id == GetCachedID(A, B, lm.contacts[j].id))
+				{
+					contact.impulse_normal.v[lane]	= cached->points[k].impulse_normal;
+					contact.impulse_tangent.v[lane] = cached->points[k].impulse_tangent;
+					break;
+				}
+			}
 		}
 	}
 }
 
-void CollisionSolver::ResolveVelocity(BodiesSpan bodies, CollisionSpan collisions)
+void CollisionSolver::WarmStart(std::size_t batch)
 {
-	for (int32 i = 0; i < collisions.size(); ++i)
+	using namespace simd;
+
+	SolverBodies& sb = m_solver_bodies;
+	const SolverBatch& solver_batch = m_batches[batch];
+
+	for (uint32 i = solver_batch.constraints_begin; i < solver_batch.constraints_end; ++i)
 	{
-		const CollisionPair& pair = collisions[i];
-		VelocityConstraint& vc = m_velocity_constraints[i];
+		const VelocityConstraint& vc = m_velocity_constraints[i];
 
-		const CollisionBody& A = bodies[pair.first];
-		const CollisionBody& B = bodies[pair.second];
+		FloatW va_x = Gather(sb.velocity_x, vc.body_a);
+		FloatW va_y = Gather(sb.velocity_y, vc.body_a);
+		FloatW wa	= Gather(sb.angular_velocity, vc.body_a);
 
-		PhysicsBody& AB = *A.body;
-		PhysicsBody& BB = *B.body;
+		FloatW vb_x = Gather(sb.velocity_x, vc.body_b);
+		FloatW vb_y = Gather(sb.velocity_y, vc.body_b);
+		FloatW wb	= Gather(sb.angular_velocity, vc.body_b);
 
-		const float am = (AB.GetType() == BodyType::Dynamic) ? AB.GetInvMass() : 0.0f;
-		const float bm = (BB.GetType() == BodyType::Dynamic) ? BB.GetInvMass() : 0.0f;
+		const FloatW am = vc.inv_mass_a.Load();
+		const FloatW bm = vc.inv_mass_b.Load();
+		const FloatW ai = vc.inv_inertia_a.Load();
+		const FloatW bi = vc.inv_inertia_b.Load();
 
-		const float ai = (AB.GetType() == BodyType::Dynamic) ? AB.GetInvInertia() : 0.0f;
-		const float bi = (BB.GetType() == BodyType::Dynamic) ? BB.GetInvInertia() : 0.0f;
+		const FloatW normal_x	= vc.normal_x.Load();
+		const FloatW normal_y	= vc.normal_y.Load();
+		const FloatW tangent_x	= normal_y;
+		const FloatW tangent_y	= -normal_x;
 
-		Vector2f tangent = Vector2f::Cross(vc.normal, 1.0f);
-		
-		for (int32 j = 0; j < vc.contacts_count; ++j)
+		for (const typename VelocityConstraint::Contact& contact : vc.contacts) // contacts not in use have no impulse
 		{
-			typename VelocityConstraint::Contact& contact = vc.contacts[j];
+			const FloatW ra_x = contact.ra_x.Load();
+			const FloatW ra_y = contact.ra_y.Load();
+			const FloatW rb_x = contact.rb_x.Load();
+			const FloatW rb_y = contact.rb_y.Load();
 
-			Vector2f rv = BB.GetVelocity() + Vector2f::Cross(BB.GetAngularVelocity(), contact.rb) -
-						  AB.GetVelocity() - Vector2f::Cross(AB.GetAngularVelocity(), contact.ra);
+			const FloatW pn = contact.impulse_normal.Load();
+			const FloatW pt = contact.impulse_tangent.Load();
 
-			const float vel_along_normal = rv.Dot(vc.normal);
+			const FloatW px = normal_x * pn + tangent_x * pt;
+			const FloatW py = normal_y * pn + tangent_y * pt;
 
-			if (vel_along_normal >= 0.0f) // no need to resolve if they are separating
-				continue;
+			va_x = va_x - px * am;
+			va_y = va_y - py * am;
+			wa	 = wa - (ra_x * py - ra_y * px) * ai;
 
-			float dpn = -vel_along_normal * (1.0f + vc.restitution) * contact.mass_normal;
-			
-			float pn0 = contact.impulse_normal;
-			contact.impulse_normal = std::max(pn0 + dpn, 0.0f);
-			dpn = contact.impulse_normal - pn0;
+			vb_x = vb_x + px * bm;
+			vb_y = vb_y + py * bm;
+			wb	 = wb + (rb_x * py - rb_y * px) * bi;
+		}
 
-			const Vector2f pn = vc.normal * dpn;
+		// bodies that are not moved may be shared with other batches, and are never written
 
-			if (AB.IsAwake() && AB.IsEnabled())
-			{
-				AB.m_velocity			-= pn * am;
-				AB.m_angular_velocity	-= contact.ra.Cross(pn) * ai;
-			}
+		Scatter(sb.velocity_x, vc.body_a, vc.moves_a, va_x);
+		Scatter(sb.velocity_y, vc.body_a, vc.moves_a, va_y);
+		Scatter(sb.angular_velocity, vc.body_a, vc.moves_a, wa);
 
-			if (BB.IsAwake() && BB.IsEnabled())
-			{
-				BB.m_velocity			+= pn * bm;
-				BB.m_angular_velocity	+= contact.rb.Cross(pn) * bi;
-			}
+		Scatter(sb.velocity_x, vc.body_b, vc.moves_b, vb_x);
+		Scatter(sb.velocity_y, vc.body_b, vc.moves_b, vb_y);
+		Scatter(sb.angular_velocity, vc.body_b, vc.moves_b, wb);
+	}
+}
+
+void CollisionSolver::ResolveVelocity(std::size_t batch)
+{
+	using namespace simd;
 
-			rv = BB.GetVelocity() + Vector2f::Cross(BB.GetAngularVelocity(), contact.rb) -
-				 AB.GetVelocity() - Vector2f::Cross(AB.GetAngularVelocity(), contact.ra);
+	SolverBodies& sb = m_solver_bodies;
+	const SolverBatch& solver_batch = m_batches[batch];
+
+	const FloatW zero = Splat(0.0f);
+
+	for (uint32 i = solver_batch.constraints_begin; i < solver_batch.constraints_end; ++i)
+	{
+		VelocityConstraint& vc = m_velocity_constraints[i];
 
-			float dpt = -rv.Dot(tangent) * contact.mass_tangent;
+		FloatW va_x = Gather(sb.velocity_x, vc.body_a);
+		FloatW va_y = Gather(sb.velocity_y, vc.body_a);
+		FloatW wa	= Gather(sb.angular_velocity, vc.body_a);
 
-			const float max_pt = vc.friction * contact.impulse_normal;
+		FloatW vb_x = Gather(sb.velocity_x, vc.body_b);
+		FloatW vb_y = Gather(sb.velocity_y, vc.body_b);
+		FloatW wb	= Gather(sb.angular_velocity, vc.body_b);
 
-			const float pt0 = contact.impulse_tangent;
-			contact.impulse_tangent = std::clamp(pt0 + dpt, -max_pt, max_pt);
-			dpt = contact.impulse_tangent - pt0;
+		const FloatW am = vc.inv_mass_a.Load();
+		const FloatW bm = vc.inv_mass_b.Load();
+		const FloatW ai = vc.inv_inertia_a.Load();
+		const FloatW bi = vc.inv_inertia_b.Load();
 
-			const Vector2f pt = tangent * dpt;
+		const FloatW normal_x	= vc.normal_x.Load();
+		const FloatW normal_y	= vc.normal_y.Load();
+		const FloatW tangent_x	= normal_y;
+		const FloatW tangent_y	= -normal_x;
+
+		const FloatW friction = vc.friction.Load();
+
+		for (typename VelocityConstraint::Contact& contact : vc.contacts)
+		{
+			const FloatW ra_x = contact.ra_x.Load();
+			const FloatW ra_y = contact.ra_y.Load();
+			const FloatW rb_x = contact.rb_x.Load();
+			const FloatW rb_y = contact.rb_y.Load();
 
-			if (AB.IsAwake() && AB.IsEnabled())
 			{
-				AB.m_velocity			-= pt * am;
-				AB.m_angular_velocity	-= contact.ra.Cross(pt) * ai;
+				const FloatW rv_x = vb_x - wb * rb_y - va_x + wa * ra_y;
+				const FloatW rv_y = vb_y + wb * rb_x - va_y - wa * ra_x;
+
+				const FloatW vel_along_normal = rv_x * normal_x + rv_y * normal_y;
+
+				// also applied when separating, the accumulated impulse may then shrink if too much was applied before
+
+				const FloatW pn0 = contact.impulse_normal.Load();
+				const FloatW pn1 = Max(pn0 - (vel_along_normal - contact.velocity_bias.Load()) * contact.mass_normal.Load(), zero);
+
+				contact.impulse_normal.Store(pn1);
+
+				const FloatW dpn = pn1 - pn0;
+
+				const FloatW px = normal_x * dpn;
+				const FloatW py = normal_y * dpn;
+
+				va_x = va_x - px * am;
+				va_y = va_y - py * am;
+				wa	 = wa - (ra_x * py - ra_y * px) * ai;
+
+				vb_x = vb_x + px * bm;
+				vb_y = vb_y + py * bm;
+				wb	 = wb + (rb_x * py - rb_y * px) * bi;
 			}
 
-			if (BB.IsAwake() && BB.IsEnabled())
 			{
-				BB.m_velocity			+= pt * bm;
-				BB.m_angular_velocity	+= contact.rb.Cross(pt) * bi;
+				const FloatW rv_x = vb_x - wb * rb_y - va_x + wa * ra_y;
+				const FloatW rv_y = vb_y + wb * rb_x - va_y - wa * ra_x;
+
+				const FloatW vel_along_tangent = rv_x * tangent_x + rv_y * tangent_y;
+
+				const FloatW max_pt = friction * contact.impulse_normal.Load();
+
+				const FloatW pt0 = contact.impulse_tangent.Load();
+				const FloatW pt1 = Clamp(pt0 - vel_along_tangent * contact.mass_tangent.Load(), -max_pt, max_pt);
+
+				contact.impulse_tangent.Store(pt1);
+
+				const FloatW dpt = pt1 - pt0;
+
+				const FloatW px = tangent_x * dpt;
+				const FloatW py = tangent_y * dpt;
+
+				va_x = va_x - px * am;
+				va_y = va_y - py * am;
+				wa	 = wa - (ra_x * py - ra_y * px) * ai;
+
+				vb_x = vb_x + px * bm;
+				vb_y = vb_y + py * bm;
+				wb	 = wb + (rb_x * py - rb_y * px) * bi;
 			}
 		}
+
+		Scatter(sb.velocity_x, vc.body_a, vc.moves_a, va_x);
+		Scatter(sb.velocity_y, vc.body_a, vc.moves_a, va_y);
+		Scatter(sb.angular_velocity, vc.body_a, vc.moves_a, wa);
+
+		Scatter(sb.velocity_x, vc.body_b, vc.moves_b, vb_x);
+		Scatter(sb.velocity_y, vc.body_b, vc.moves_b, vb_y);
+		Scatter(sb.angular_velocity, vc.body_b, vc.moves_b, wb);
 	}
 }
 
-bool CollisionSolver::ResolvePosition(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds)
+void CollisionSolver::SolveSubSteps(BodiesSpan bodies, const Time& time, const Vector2f& gravity, int sub_steps, std::size_t batch)
+{
+	SolverBodies& sb = m_solver_bodies;
+	const SolverBatch& solver_batch = m_batches[batch];
+
+	const float dt	= time.GetFixedDT();
+	const float h	= dt / static_cast<float>(sub_steps);
+
+	const auto Moves = [&sb](uint32 slot)
+	{
+		return sb.inv_mass[slot] > 0.0f || sb.inv_inertia[slot] > 0.0f;
+	};
+
+	// the velocities already hold what gravity and forces add over the whole step, which is taken back out and 
+	// instead added a bit at every sub-step, the same as how the bodies are integrated with their damping
+
+	for (uint32 i = solver_batch.bodies_begin; i < solver_batch.bodies_end; ++i)
+	{
+		if (!Moves(i))
+			continue;
+
+		const PhysicsBody& body = *bodies[sb.indices[i]].body;
+
+		const float linear_damping	= 1.0f / (1.0f + dt * body.GetLinearDamping());
+		const float angular_damping = 1.0f / (1.0f + dt * body.GetAngularDamping());
+
+		const Vector2f external = dt * body.GetInvMass() * (gravity * body.GetGravityScale() * body.GetMass() + body.GetForce()) * linear_damping;
+
+		sb.external_x[i]		= external.x;
+		sb.external_y[i]		= external.y;
+		sb.external_angular[i]	= dt * body.GetInvInertia() * body.GetTorque() * angular_damping;
+
+		sb.velocity_x[i]		-= sb.external_x[i];
+		sb.velocity_y[i]		-= sb.external_y[i];
+		sb.angular_velocity[i]	-= sb.external_angular[i];
+	}
+
+	const float fraction = 1.0f / static_cast<float>(sub_steps);
+
+	// stiffer than the sub-steps can resolve makes the contacts ring, so the rate is kept well below it
+
+	const Softness softness = GetSoftness(std::min(P_CONTACT_HERTZ, 0.25f / h), P_CONTACT_DAMPING_RATIO, h);
+	const float inv_h = 1.0f / h;
+
+	for (int step = 0; step < sub_steps; ++step)
+	{
+		for (uint32 i = solver_batch.bodies_begin; i < solver_batch.bodies_end; ++i)
+		{
+			if (!Moves(i))
+				continue;
+
+			sb.velocity_x[i]		+= sb.external_x[i] * fraction;
+			sb.velocity_y[i]		+= sb.external_y[i] * fraction;
+			sb.angular_velocity[i]	+= sb.external_angular[i] * fraction;
+		}
+
+		WarmStart(batch);
+		SolveSoft(solver_batch, softness, inv_h, true);
+
+		for (uint32 i = solver_batch.bodies_begin; i < solver_batch.bodies_end; ++i)
+		{
+			if (!Moves(i)) // bodies that are not moved are treated as still during the step
+				continue;
+
+			sb.delta_x[i]			+= sb.velocity_x[i] * h;
+			sb.delta_y[i]			+= sb.velocity_y[i] * h;
+			sb.delta_rotation[i]	+= sb.angular_velocity[i] * h;
+		}
+
+		SolveSoft(solver_batch, softness, inv_h, false); // relax, removes the velocity added by pushing apart
+	}
+
+	ApplyRestitution(solver_batch);
+}
+
+bool CollisionSolver::ResolvePosition(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds, std::size_t begin, std::size_t end)
 {
 	float max_penetration = 0.0f;
 
-	for (int32 i = 0; i < collisions.size(); ++i)
+	for (std::size_t i = begin; i < end; ++i)
 	{
 		const CollisionPair& pair = collisions[i];
 		const LocalManifold& lm = manifolds[i];
@@ -210,6 +498,9 @@ bool CollisionSolver::ResolvePosition(BodiesSpan bodies, CollisionSpan collision
 		const float ai = (AB.GetType() == BodyType::Dynamic) ? AB.GetInvInertia() : 0.0f;
 		const float bi = (BB.GetType() == BodyType::Dynamic) ? BB.GetInvInertia() : 0.0f;
 
+		const bool a_moves = IsMovable(AB);
+		const bool b_moves = IsMovable(BB);
+
 		for (int32 j = 0; j < lm.contacts_count; ++j)
 		{
 			SimpleTransform AW;
@@ -245,13 +536,13 @@ bool CollisionSolver::ResolvePosition(BodiesSpan bodies, CollisionSpan collision
 
 			const Vector2f p = normal * impulse;
 
-			if (AB.IsAwake() && AB.IsEnabled())
+			if (a_moves)
 			{
 				AT.m_position -= p * am;
 				AT.m_rotation -= sf::radians(ai * ra.Cross(p));
 			}
 
-			if (BB.IsAwake() && BB.IsEnabled())
+			if (b_moves)
 			{
 				BT.m_position += p * bm;
 				BT.m_rotation += sf::radians(bi * rb.Cross(p));
@@ -262,6 +553,448 @@ bool CollisionSolver::ResolvePosition(BodiesSpan bodies, CollisionSpan collision
 	return max_penetration <= 3.0f * P_SLOP;
 }
 
+void CollisionSolver::StoreVelocities(BodiesSpan bodies)
+{
+	const SolverBodies& sb = m_solver_bodies;
+
+	for (std::size_t i = 1; i < sb.indices.size(); ++i)
+	{
+		if (sb.inv_mass[i] == 0.0f && sb.inv_inertia[i] == 0.0f) // was never moved
+			continue;
+
+		PhysicsBody& body = *bodies[sb.indices[i]].body;
+
+		body.m_velocity			= Vector2f(sb.velocity_x[i], sb.velocity_y[i]);
+		body.m_angular_velocity = sb.angular_velocity[i];
+	}
+}
+
+void CollisionSolver::StorePositions(BodiesSpan bodies)
+{
+	const SolverBodies& sb = m_solver_bodies;
+
+	for (std::size_t i = 1; i < sb.indices.size(); ++i)
+	{
+		if (sb.inv_mass[i] == 0.0f && sb.inv_inertia[i] == 0.0f)
+			continue;
+
+		BodyTransform& transform = *bodies[sb.indices[i]].transform;
+
+		transform.m_position = Vector2f(sb.position_x[i] + sb.delta_x[i], sb.position_y[i] + sb.delta_y[i]);
+		transform.m_rotation = sf::radians(sb.rotation[i] + sb.delta_rotation[i]);
+	}
+}
+
+void CollisionSolver::StoreImpulses(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds)
+{
+	using namespace simd;
+
+	if (!m_warm_starting)
+		return;
+
+	for (std::size_t i = 0; i < collisions.size(); ++i)
+	{
+		const CollisionPair& pair = collisions[i];
+		const LocalManifold& lm = manifolds[i];
+
+		const CollisionBody& A = bodies[pair.first];
+		const CollisionBody& B = bodies[pair.second];
+
+		const uint64 key = GetPairKey(A, B);
+
+		if (m_contact_slots[i] == UINT32_MAX) // not solved, keep what the pair had when it fell asleep
+		{
+			if (const auto it = m_contact_cache.find(key); it != m_contact_cache.end())
+				it->second.step = m_step;
+
+			continue;
+		}
+
+		const VelocityConstraint& vc = m_velocity_constraints[m_contact_slots[i] / WIDTH];
+		const uint32 lane = m_contact_slots[i] % WIDTH;
+
+		CachedContact& cached = m_contact_cache[key];
+
+		cached.points_count = lm.contacts_count;
+		cached.step			= m_step;
+
+		for (int32 j = 0; j < lm.contacts_count; ++j)
+		{
+			cached.points[j].id					= GetCachedID(A, B, lm.contacts[j].id);
+			cached.points[j].impulse_normal		= vc.contacts[j].impulse_normal.v[lane];
+			cached.points[j].impulse_tangent	= vc.contacts[j].impulse_tangent.v[lane];
+		}
+	}
+
+	std::erase_if(m_contact_cache, // pairs that were not in contact this step
+		[this](const auto& entry)
+		{
+			return entry.second.step != m_step;
+		});
+}
+
+void CollisionSolver::ClearImpulses()
+{
+	m_contact_cache.clear();
+}
+
+bool CollisionSolver::GetWarmStarting() const noexcept
+{
+	return m_warm_starting;
+}
+
+void CollisionSolver::SetWarmStarting(bool flag)
+{
+	m_warm_starting = flag;
+
+	if (!m_warm_starting)
+		m_contact_cache.clear();
+}
+
+uint32 CollisionSolver::AddSolverBody(BodiesSpan bodies, uint32 index)
+{
+	SolverBodies& sb = m_solver_bodies;
+
+	int32& slot = m_body_slots[index];
+	if (slot != -1)
+		return slot;
+
+	const PhysicsBody& body = *bodies[index].body;
+	const BodyTransform& transform = *bodies[index].transform;
+
+	if (body.GetType() == BodyType::Static)
+		return (slot = 0);
+
+	slot = static_cast<int32>(sb.indices.size());
+
+	const bool moves = IsMovable(body);
+
+	sb.velocity_x.emplace_back(body.GetVelocity().x);
+	sb.velocity_y.emplace_back(body.GetVelocity().y);
+	sb.angular_velocity.emplace_back(body.GetAngularVelocity());
+	sb.inv_mass.emplace_back(moves ? body.GetInvMass() : 0.0f);
+	sb.inv_inertia.emplace_back(moves ? body.GetInvInertia() : 0.0f);
+	sb.position_x.emplace_back(transform.GetPosition().x);
+	sb.position_y.emplace_back(transform.GetPosition().y);
+	sb.rotation.emplace_back(transform.GetRotation().asRadians());
+	sb.delta_x.emplace_back(0.0f);
+	sb.delta_y.emplace_back(0.0f);
+	sb.delta_rotation.emplace_back(0.0f);
+	sb.external_x.emplace_back(0.0f);
+	sb.external_y.emplace_back(0.0f);
+	sb.external_angular.emplace_back(0.0f);
+	sb.colors.emplace_back(0);
+	sb.indices.emplace_back(index);
+
+	return slot;
+}
+
+void CollisionSolver::ColorBatch(CollisionSpan collisions, const Islands::Batch& batch)
+{
+	using namespace simd;
+
+	SolverBodies& sb = m_solver_bodies;
+
+	const auto Moves = [&sb](uint32 slot)
+	{
+		return sb.inv_mass[slot] > 0.0f || sb.inv_inertia[slot] > 0.0f;
+	};
+
+	std::array<uint32, MAX_COLORS + 1> counts {}; // last one holds the contacts that could not be colored
+
+	for (uint32 i = batch.contacts_begin; i < batch.contacts_end; ++i) // greedy, first color free for both bodies
+	{
+		const uint32 a = m_body_slots[collisions[i].first];
+		const uint32 b = m_body_slots[collisions[i].second];
+
+		const uint64 used = (Moves(a) ? sb.colors[a] : 0) | (Moves(b) ? sb.colors[b] : 0);
+		const uint32 color = static_cast<uint32>(std::countr_one(used));
+
+		if (color < MAX_COLORS)
+		{
+			sb.colors[a] |= Moves(a) ? (1ull << color) : 0; // shared bodies that are never written do not constrain
+			sb.colors[b] |= Moves(b) ? (1ull << color) : 0;
+		}
+
+		m_contact_colors[i] = color;
+		++counts[color];
+	}
+
+	SolverBatch& solver_batch = m_batches.emplace_back();
+
+	solver_batch.contacts_begin		= batch.contacts_begin;
+	solver_batch.contacts_end		= batch.contacts_end;
+	solver_batch.constraints_begin	= (m_batches.size() > 1) ? m_batches[m_batches.size() - 2].constraints_end : 0;
+
+	std::array<uint32, MAX_COLORS + 1> offsets {};
+
+	uint32 constraints = solver_batch.constraints_begin;
+	for (uint32 color = 0; color < MAX_COLORS; ++color) // every color is packed into whole constraints
+	{
+		offsets[color] = constraints * WIDTH;
+		constraints += (counts[color] + WIDTH - 1) / WIDTH;
+	}
+
+	offsets[MAX_COLORS] = constraints * WIDTH;
+	constraints += counts[MAX_COLORS];
+
+	solver_batch.constraints_end = constraints;
+
+	for (uint32 i = batch.contacts_begin; i < batch.contacts_end; ++i)
+	{
+		const uint32 color = m_contact_colors[i];
+
+		m_contact_slots[i] = offsets[color];
+		offsets[color] += (color < MAX_COLORS) ? 1 : WIDTH; // uncolored contacts get a constraint each
+	}
+}
+
+void CollisionSolver::SolveSoft(const SolverBatch& batch, const Softness& softness, float inv_h, bool use_bias)
+{
+	using namespace simd;
+
+	SolverBodies& sb = m_solver_bodies;
+
+	const FloatW zero		= Splat(0.0f);
+	const FloatW one		= Splat(1.0f);
+	const FloatW step_rate	= Splat(inv_h);
+
+	const FloatW bias_rate		= Splat(use_bias ? softness.bias_rate : 0.0f);
+	const FloatW mass_scale		= Splat(use_bias ? softness.mass_scale : 1.0f);
+	const FloatW impulse_scale	= Splat(use_bias ? softness.impulse_scale : 0.0f);
+	const FloatW max_push		= Splat(-P_CONTACT_PUSH_VELOCITY);
+
+	for (uint32 i = batch.constraints_begin; i < batch.constraints_end; ++i)
+	{
+		VelocityConstraint& vc = m_velocity_constraints[i];
+
+		FloatW va_x = Gather(sb.velocity_x, vc.body_a);
+		FloatW va_y = Gather(sb.velocity_y, vc.body_a);
+		FloatW wa	= Gather(sb.angular_velocity, vc.body_a);
+
+		FloatW vb_x = Gather(sb.velocity_x, vc.body_b);
+		FloatW vb_y = Gather(sb.velocity_y, vc.body_b);
+		FloatW wb	= Gather(sb.angular_velocity, vc.body_b);
+
+		const FloatW da_x	= Gather(sb.delta_x, vc.body_a);
+		const FloatW da_y	= Gather(sb.delta_y, vc.body_a);
+		const FloatW dra	= Gather(sb.delta_rotation, vc.body_a);
+
+		const FloatW db_x	= Gather(sb.delta_x, vc.body_b);
+		const FloatW db_y	= Gather(sb.delta_y, vc.body_b);
+		const FloatW drb	= Gather(sb.delta_rotation, vc.body_b);
+
+		const FloatW am = vc.inv_mass_a.Load();
+		const FloatW bm = vc.inv_mass_b.Load();
+		const FloatW ai = vc.inv_inertia_a.Load();
+		const FloatW bi = vc.inv_inertia_b.Load();
+
+		const FloatW normal_x	= vc.normal_x.Load();
+		const FloatW normal_y	= vc.normal_y.Load();
+		const FloatW tangent_x	= normal_y;
+		const FloatW tangent_y	= -normal_x;
+
+		const FloatW friction = vc.friction.Load();
+
+		for (typename VelocityConstraint::Contact& contact : vc.contacts)
+		{
+			const FloatW ra_x = contact.ra_x.Load();
+			const FloatW ra_y = contact.ra_y.Load();
+			const FloatW rb_x = contact.rb_x.Load();
+			const FloatW rb_y = contact.rb_y.Load();
+
+			{
+				// current separation from how far the bodies have moved, the anchors are turned by the small 
+				// rotation since the start of the step
+
+				const FloatW d_x = db_x - da_x - drb * rb_y + dra * ra_y;
+				const FloatW d_y = db_y - da_y + drb * rb_x - dra * ra_x;
+
+				const FloatW separation = contact.separation.Load() + d_x * normal_x + d_y * normal_y;
+
+				// bodies not yet touching may close the gap within a sub-step, overlapping ones are pushed apart softly
+
+				const FloatW apart = Greater(separation, zero);
+
+				const FloatW bias	= Select(apart, separation * step_rate, Max(bias_rate * separation, max_push));
+				const FloatW ms		= Select(apart, one, mass_scale);
+				const FloatW is		= Select(apart, zero, impulse_scale);
+
+				const FloatW rv_x = vb_x - wb * rb_y - va_x + wa * ra_y;
+				const FloatW rv_y = vb_y + wb * rb_x - va_y - wa * ra_x;
+
+				const FloatW vel_along_normal = rv_x * normal_x + rv_y * normal_y;
+
+				const FloatW pn0 = contact.impulse_normal.Load();
+				const FloatW pn1 = Max(pn0 - contact.mass_normal.Load() * ms * (vel_along_normal + bias) - is * pn0, zero);
+
+				contact.impulse_normal.Store(pn1);
+
+				const FloatW dpn = pn1 - pn0;
+
+				const FloatW px = normal_x * dpn;
+				const FloatW py = normal_y * dpn;
+
+				va_x = va_x - px * am;
+				va_y = va_y - py * am;
+				wa	 = wa - (ra_x * py - ra_y * px) * ai;
+
+				vb_x = vb_x + px * bm;
+				vb_y = vb_y + py * bm;
+				wb	 = wb + (rb_x * py - rb_y * px) * bi;
+			}
+
+			{
+				const FloatW rv_x = vb_x - wb * rb_y - va_x + wa * ra_y;
+				const FloatW rv_y = vb_y + wb * rb_x - va_y - wa * ra_x;
+
+				const FloatW vel_along_tangent = rv_x * tangent_x + rv_y * tangent_y;
+
+				const FloatW max_pt = friction * contact.impulse_normal.Load();
+
+				const FloatW pt0 = contact.impulse_tangent.Load();
+				const FloatW pt1 = Clamp(pt0 - vel_along_tangent * contact.mass_tangent.Load(), -max_pt, max_pt);
+
+				contact.impulse_tangent.Store(pt1);
+
+				const FloatW dpt = pt1 - pt0;
+
+				const FloatW px = tangent_x * dpt;
+				const FloatW py = tangent_y * dpt;
+
+				va_x = va_x - px * am;
+				va_y = va_y - py * am;
+				wa	 = wa - (ra_x * py - ra_y * px) * ai;
+
+				vb_x = vb_x + px * bm;
+				vb_y = vb_y + py * bm;
+				wb	 = wb + (rb_x * py - rb_y * px) * bi;
+			}
+		}
+
+		Scatter(sb.velocity_x, vc.body_a, vc.moves_a, va_x);
+		Scatter(sb.velocity_y, vc.body_a, vc.moves_a, va_y);
+		Scatter(sb.angular_velocity, vc.body_a, vc.moves_a, wa);
+
+		Scatter(sb.velocity_x, vc.body_b, vc.moves_b, vb_x);
+		Scatter(sb.velocity_y, vc.body_b, vc.moves_b, vb_y);
+		Scatter(sb.angular_velocity, vc.body_b, vc.moves_b, wb);
+	}
+}
+
+void CollisionSolver::ApplyRestitution(const SolverBatch& batch)
+{
+	using namespace simd;
+
+	SolverBodies& sb = m_solver_bodies;
+
+	const FloatW zero = Splat(0.0f);
+
+	// one more pass along the normals towards the bounce velocity, contacts without restitution just stop approaching
+
+	for (uint32 i = batch.constraints_begin; i < batch.constraints_end; ++i)
+	{
+		VelocityConstraint& vc = m_velocity_constraints[i];
+
+		FloatW va_x = Gather(sb.velocity_x, vc.body_a);
+		FloatW va_y = Gather(sb.velocity_y, vc.body_a);
+		FloatW wa	= Gather(sb.angular_velocity, vc.body_a);
+
+		FloatW vb_x = Gather(sb.velocity_x, vc.body_b);
+		FloatW vb_y = Gather(sb.velocity_y, vc.body_b);
+		FloatW wb	= Gather(sb.angular_velocity, vc.body_b);
+
+		const FloatW am = vc.inv_mass_a.Load();
+		const FloatW bm = vc.inv_mass_b.Load();
+		const FloatW ai = vc.inv_inertia_a.Load();
+		const FloatW bi = vc.inv_inertia_b.Load();
+
+		const FloatW normal_x = vc.normal_x.Load();
+		const FloatW normal_y = vc.normal_y.Load();
+
+		for (typename VelocityConstraint::Contact& contact : vc.contacts)
+		{
+			const FloatW ra_x = contact.ra_x.Load();
+			const FloatW ra_y = contact.ra_y.Load();
+			const FloatW rb_x = contact.rb_x.Load();
+			const FloatW rb_y = contact.rb_y.Load();
+
+			const FloatW rv_x = vb_x - wb * rb_y - va_x + wa * ra_y;
+			const FloatW rv_y = vb_y + wb * rb_x - va_y - wa * ra_x;
+
+			const FloatW vel_along_normal = rv_x * normal_x + rv_y * normal_y;
+
+			const FloatW pn0 = contact.impulse_normal.Load();
+			const FloatW pn1 = Max(pn0 - (vel_along_normal - contact.velocity_bias.Load()) * contact.mass_normal.Load(), zero);
+
+			contact.impulse_normal.Store(pn1);
+
+			const FloatW dpn = pn1 - pn0;
+
+			const FloatW px = normal_x * dpn;
+			const FloatW py = normal_y * dpn;
+
+			va_x = va_x - px * am;
+			va_y = va_y - py * am;
+			wa	 = wa - (ra_x * py - ra_y * px) * ai;
+
+			vb_x = vb_x + px * bm;
+			vb_y = vb_y + py * bm;
+			wb	 = wb + (rb_x * py - rb_y * px) * bi;
+		}
+
+		Scatter(sb.velocity_x, vc.body_a, vc.moves_a, va_x);
+		Scatter(sb.velocity_y, vc.body_a, vc.moves_a, va_y);
+		Scatter(sb.angular_velocity, vc.body_a, vc.moves_a, wa);
+
+		Scatter(sb.velocity_x, vc.body_b, vc.moves_b, vb_x);
+		Scatter(sb.velocity_y, vc.body_b, vc.moves_b, vb_y);
+		Scatter(sb.angular_velocity, vc.body_b, vc.moves_b, wb);
+	}
+}
+
+auto CollisionSolver::GetSoftness(float hertz, float damping_ratio, float h) -> Softness
+{
+	if (hertz == 0.0f)
+		return Softness{};
+
+	const float omega = 2.0f * std::numbers::pi_v<float> * hertz;
+
+	const float a1 = 2.0f * damping_ratio + h * omega;
+	const float a2 = h * omega * a1;
+	const float a3 = 1.0f / (1.0f + a2);
+
+	return Softness{ omega / a1, a2 * a3, a3 };
+}
+
+bool CollisionSolver::IsMovable(const PhysicsBody& body)
+{
+	// other bodies are not affected by the impulses, and skipping them means that no shared 
+	// static or kinematic bodies are written to when separate islands are solved at once
+
+	return body.GetType() == BodyType::Dynamic && body.IsAwake() && body.IsEnabled();
+}
+
+uint64 CollisionSolver::GetPairKey(const CollisionBody& A, const CollisionBody& B)
+{
+	// ordered by entity since the order of the bodies changes when others are removed, the impulses carry over as 
+	// is when the order flips, since the normal and the tangent derived from it flip along with it
+
+	const auto [min, max] = std::minmax(A.entity_id, B.entity_id);
+	return (static_cast<uint64>(min) << 32) | static_cast<uint64>(max);
+}
+
+uint32 CollisionSolver::GetCachedID(const CollisionBody& A, const CollisionBody& B, uint32 id)
+{
+	// polygons mark which of the two shapes the reference face belongs to, store it relative to the entity order
+
+	const bool is_polygons = 
+		(A.type == Shape::Box || A.type == Shape::Convex) && 
+		(B.type == Shape::Box || B.type == Shape::Convex);
+
+	return (is_polygons && A.entity_id > B.entity_id) ? (id ^ LocalManifold::ID_FLIP) : id;
+}
+
 void PositionSolverManifold::Initialize(const LocalManifold& manifold, const SimpleTransform& AW, float AR, const SimpleTransform& BW, float BR, std::size_t index)
 {
 	assert(manifold.contacts_count > 0);
@@ -0,0 +1,212 @@
+#include <Velox/Physics/Islands.h>
+
+#include <numeric>
+#include <algorithm>
+#include <cfloat>
+
+#include <Velox/Physics/Collision/CollisionBody.h>
+
+#include <Velox/Physics/PhysicsBody.h>
+#include <Velox/Physics/PhysicsCommon.hpp>
+
+using namespace vlx;
+
+void Islands::Build(BodiesSpan bodies, CollisionSpan collisions, ManifoldSpan manifolds)
+{
+	const auto IsDynamic = [&bodies](uint32 i)
+	{
+		return bodies[i].body != nullptr && bodies[i].body->GetType() == BodyType::Dynamic;
+	};
+
+	m_parents.resize(bodies.size());
+	std::iota(m_parents.begin(), m_parents.end(), 0);
+
+	for (const CollisionBody& body : bodies)
+	{
+		if (body.body != nullptr)
+			body.body->m_island = -1;
+	}
+
+	for (const auto& [a, b] : collisions)
+	{
+		if (IsDynamic(a) && IsDynamic(b)) // islands do not propagate through static or kinematic bodies
+			Union(a, b);
+	}
+
+	// islands are numbered in the order they first appear in the contacts, keeping the result deterministic
+
+	m_island_ids.assign(bodies.size(), -1);
+	m_islands.clear();
+
+	for (const auto& [a, b] : collisions)
+	{
+		int32& id = m_island_ids[Find(IsDynamic(a) ? a : b)];
+
+		if (id == -1)
+		{
+			id = static_cast<int32>(m_islands.size());
+			m_islands.emplace_back();
+		}
+
+		++m_islands[id].contacts_end; // count for now
+	}
+
+	for (uint32 i = 0; i < bodies.size(); ++i)
+	{
+		if (!IsDynamic(i))
+			continue;
+
+		if (const int32 id = m_island_ids[Find(i)]; id != -1)
+			++m_islands[id].bodies_end;
+	}
+
+	uint32 contacts = 0, island_bodies = 0;
+	for (Island& island : m_islands) // turn the counts into ranges
+	{
+		island.contacts_begin	= contacts;
+		island.bodies_begin		= island_bodies;
+
+		contacts		+= island.contacts_end;
+		island_bodies	+= island.bodies_end;
+
+		island.contacts_end		= contacts;
+		island.bodies_end		= island_bodies;
+	}
+
+	m_collisions.resize(contacts);
+	m_manifolds.resize(contacts);
+	m_bodies.resize(island_bodies);
+
+	m_offsets.resize(m_islands.size());
+	for (std::size_t i = 0; i < m_islands.size(); ++i)
+		m_offsets[i] = m_islands[i].contacts_begin;
+
+	for (std::size_t i = 0; i < collisions.size(); ++i)
+	{
+		const auto& [a, b] = collisions[i];
+		const uint32 index = m_offsets[m_island_ids[Find(IsDynamic(a) ? a : b)]]++;
+
+		m_collisions[index] = collisions[i];
+		m_manifolds[index]	= manifolds[i];
+	}
+
+	for (std::size_t i = 0; i < m_islands.size(); ++i)
+		m_offsets[i] = m_islands[i].bodies_begin;
+
+	for (uint32 i = 0; i < bodies.size(); ++i)
+	{
+		if (!IsDynamic(i))
+			continue;
+
+		if (const int32 id = m_island_ids[Find(i)]; id != -1)
+		{
+			m_bodies[m_offsets[id]++] = i;
+			bodies[i].body->m_island = id;
+		}
+	}
+
+	// wake islands that are touched by anything awake, the ones left asleep are not solved
+
+	m_batches.clear();
+
+	Batch batch;
+	for (const Island& island : m_islands)
+	{
+		bool awake = false;
+
+		for (uint32 i = island.bodies_begin; i < island.bodies_end && !awake; ++i)
+			awake = bodies[m_bodies[i]].body->IsAwake();
+
+		for (uint32 i = island.contacts_begin; i < island.contacts_end && !awake; ++i) // kinematic bodies moving into the island
+		{
+			const auto& [a, b] = m_collisions[i];
+			awake = bodies[a].body->IsAwake() || bodies[b].body->IsAwake();
+		}
+
+		if (!awake)
+		{
+			if (batch.contacts_end != batch.contacts_begin) // batches have to be contiguous
+				m_batches.emplace_back(batch);
+
+			batch = Batch{ island.contacts_end, island.contacts_end };
+
+			continue;
+		}
+
+		for (uint32 i = island.bodies_begin; i < island.bodies_end; ++i)
+		{
+			PhysicsBody& body = *bodies[m_bodies[i]].body;
+			if (!body.IsAwake())
+				body.SetAwake(true);
+		}
+
+		batch.contacts_end = island.contacts_end;
+
+		if (batch.contacts_end - batch.contacts_begin >= BATCH_SIZE)
+		{
+			m_batches.emplace_back(batch);
+			batch = Batch{ island.contacts_end, island.contacts_end };
+		}
+	}
+
+	if (batch.contacts_end != batch.contacts_begin)
+		m_batches.emplace_back(batch);
+}
+
+void Islands::Sleep(BodiesSpan bodies)
+{
+	for (const Island& island : m_islands)
+	{
+		float min_sleep_time = FLT_MAX;
+
+		for (uint32 i = island.bodies_begin; i < island.bodies_end; ++i)
+		{
+			const PhysicsBody& body = *bodies[m_bodies[i]].body;
+			min_sleep_time = body.IsAwake() ? std::min(min_sleep_time, body.m_sleep_time) : min_sleep_time;
+		}
+
+		if (min_sleep_time < P_TIME_TO_SLEEP)
+			continue;
+
+		for (uint32 i = island.bodies_begin; i < island.bodies_end; ++i)
+			bodies[m_bodies[i]].body->SetAwake(false);
+	}
+}
+
+auto Islands::GetCollisions() const noexcept -> const CollisionList&
+{
+	return m_collisions;
+}
+auto Islands::GetManifolds() const noexcept -> const LocalManifolds&
+{
+	return m_manifolds;
+}
+
+auto Islands::GetIslands() const noexcept -> std::span<const Island>
+{
+	return m_islands;
+}
+auto Islands::GetBatches() const noexcept -> std::span<const Batch>
+{
+	return m_batches;
+}
+
+uint32 Islands::Find(uint32 i)
+{
+	while (m_parents[i] != i)
+	{
+		m_parents[i] = m_parents[m_parents[i]]; // path halving
+		i = m_parents[i];
+	}
+
+	return i;
+}
+
+void Islands::Union(uint32 i, uint32 j)
+{
+	i = Find(i);
+	j = Find(j);
+
+	if (i != j) // lower index as root keeps the forest the same regardless of pair order
+		m_parents[std::max(i, j)] = std::min(i, j);
+}
\ No newline at end of file
@@ -1,5 +1,9 @@
 #include <Velox/Physics/Systems/BroadSystem.h>
 
+#include <utility>
+#include <numeric>
+#include <algorithm>
+
 #include <Velox/ECS/EntityAdmin.h>
 
 #include <Velox/Physics/BodyTransform.h>
@@ -12,27 +16,107 @@
 
 using namespace vlx;
 
-BroadSystem::BroadSystem(EntityAdmin& entity_admin) :
+BroadSystem::BroadSystem(EntityAdmin& entity_admin, Backend backend) :
 	m_entity_admin(&entity_admin), m_insert(entity_admin),
 
-	m_quad_tree({ -4096, -4096, 4096 * 2, 4096 * 2 }) // hard set size for now
+	m_quad_tree({ -4096, -4096, 4096 * 2, 4096 * 2 }), // hard set size for now
+	m_grid(P_GRID_CELL_SIZE),
+	m_backend(backend)
 {
 	m_insert.Each(&BroadSystem::InsertAABB, this);
 
 	RegisterEvents();
 }
 
-void BroadSystem::Update()
+void BroadSystem::Update(float time_step)
 {
 	m_collisions.clear();
+	m_time_step = time_step;
+	m_reinsert_count = 0;
+
+	if (m_deterministic && m_order_dirty)
+		SortBodies();
 
-	m_insert.ForceRun(); // insert/erase AABBs in quadtree
+	switch (m_backend)
+	{
+	case Backend::QuadTree:
+		m_insert.ForceRun(); // insert/erase AABBs in quadtree
+		m_quad_tree.Cleanup(); // have to cleanup in case of erase
+
+		GatherCollisions(m_quad_tree);
+		break;
+	case Backend::AABBTree:
+		UpdateTree();
+
+		GatherCollisions(m_aabb_tree);
+		break;
+	case Backend::SweepAndPrune:
+		UpdateSAP();
+
+		GatherPairs();
+		break;
+	case Backend::Grid:
+		UpdateGrid();
+
+		GatherCollisions(m_grid);
+		break;
+	}
 
-	m_quad_tree.Cleanup(); // have to cleanup in case of erase
+	if (m_deterministic) // the pairs of a body are otherwise in the order the structure visits them in
+		std::ranges::sort(m_collisions);
+}
+
+void BroadSystem::SetBackend(Backend backend)
+{
+	if (m_backend == backend)
+		return;
 
-	GatherCollisions();
+	switch (m_backend) // empty the current structure, the other one is filled in on the next update
+	{
+	case Backend::QuadTree:
+		for (const CollisionBody& body : m_bodies)
+		{
+			if (QTBody* qtb = m_entity_admin->TryGetComponent<QTBody>(body.entity_id); qtb != nullptr)
+				qtb->Erase();
+		}
+		m_quad_tree.Cleanup();
+		break;
+	case Backend::AABBTree:
+		m_aabb_tree.Clear();
+		std::ranges::fill(m_proxies, NULL_BODY);
+		break;
+	case Backend::SweepAndPrune:
+		m_sap.Clear();
+		std::ranges::fill(m_proxies, NULL_BODY);
+		break;
+	case Backend::Grid:
+		m_grid.Clear();
+		std::ranges::fill(m_proxies, NULL_BODY);
+		break;
+	}
 
-	CullDuplicates();
+	m_backend = backend;
+}
+
+auto BroadSystem::GetBackend() const noexcept -> Backend
+{
+	return m_backend;
+}
+
+uint32 BroadSystem::GetReinsertCount() const noexcept
+{
+	return m_reinsert_count;
+}
+
+void BroadSystem::SetDeterministic(bool flag)
+{
+	m_deterministic = flag;
+	m_order_dirty	= true;
+}
+
+bool BroadSystem::GetDeterministic() const noexcept
+{
+	return m_deterministic;
 }
 
 auto BroadSystem::GetBodies() const noexcept -> const BodyList&
@@ -63,92 +147,414 @@ CollisionBody& BroadSystem::GetBody(uint32 i)
 	return m_bodies[i];
 }
 
+std::optional<QueryHit> BroadSystem::RayCast(const Ray& ray, CollisionLayer layer) const
+{
+	std::optional<QueryHit> result;
+
+	VisitBodies(ray,
+		[this, &ray, layer, &result](uint32 i)
+		{
+			const CollisionBody& body = m_bodies[i];
+
+			if (IsQueryable(body, layer))
+			{
+				auto hit = ShapeQueries::RayCast(ray, *body.shape, body.type, GetTransform(body));
+
+				if (hit.has_value() && (!result.has_value() || hit->fraction < result->fraction))
+				{
+					hit->entity = body.entity_id;
+					result = hit;
+				}
+			}
+
+			return result.has_value() ? result->fraction : 1.0f; // nothing further away can be closer
+		});
+
+	return result;
+}
+
+void BroadSystem::RayCast(std::span<const Ray> rays, std::span<std::optional<QueryHit>> hits, CollisionLayer layer) const
+{
+	assert(hits.size() >= rays.size());
+
+	// rays only read the structures and every job writes to its own range of hits
+
+	m_entity_admin->GetThreadPool().ParallelFor(rays.size(), RAY_BATCH_SIZE,
+		[this, &rays, &hits, layer](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+				hits[i] = RayCast(rays[i], layer);
+		});
+}
+
+std::optional<QueryHit> BroadSystem::ShapeCast(const Shape& shape, typename Shape::Type type, 
+	const SimpleTransform& transform, const Vector2f& translation, CollisionLayer layer) const
+{
+	const RectFloat aabb = ShapeQueries::ComputeAABB(shape, type, transform);
+
+	std::optional<QueryHit> result;
+
+	VisitBodies(aabb.Union(aabb + translation),
+		[this, &shape, type, &transform, &translation, layer, &result](uint32 i)
+		{
+			const CollisionBody& body = m_bodies[i];
+
+			if (!IsQueryable(body, layer))
+				return;
+
+			auto hit = ShapeQueries::ShapeCast(shape, type, transform, translation, *body.shape, body.type, GetTransform(body));
+
+			if (hit.has_value() && (!result.has_value() || hit->fraction < result->fraction))
+			{
+				hit->entity = body.entity_id;
+				result = hit;
+			}
+		});
+
+	return result;
+}
+
+std::vector<EntityID> BroadSystem::Overlap(const Shape& shape, typename Shape::Type type, 
+	const SimpleTransform& transform, CollisionLayer layer) const
+{
+	std::vector<EntityID> result;
+
+	VisitBodies(ShapeQueries::ComputeAABB(shape, type, transform),
+		[this, &shape, type, &transform, layer, &result](uint32 i)
+		{
+			const CollisionBody& body = m_bodies[i];
+
+			if (!IsQueryable(body, layer))
+				return;
+
+			if (ShapeQueries::Overlaps(shape, type, transform, *body.shape, body.type, GetTransform(body)))
+				result.emplace_back(body.entity_id);
+		});
+
+	return result;
+}
+
+std::vector<EntityID> BroadSystem::Overlap(const Vector2f& center, float radius, CollisionLayer layer) const
+{
+	SimpleTransform transform;
+	transform.SetPosition(center);
+
+	return Overlap(Circle(radius), Shape::Circle, transform, layer);
+}
+
 void BroadSystem::InsertAABB(EntityID entity_id, ColliderAABB& ab, QTBody& qtb)
 {
 	if (!qtb.GetEnabled())
 		return;
 
-	if (!qtb.Contains(ab.GetAABB()))
-	{
-		const auto it = m_entity_body_map.find(entity_id);
-		if (it == m_entity_body_map.end())
-			return;
+	const auto it = m_entity_body_map.find(entity_id);
+	if (it == m_entity_body_map.end())
+		return;
+
+	assert(it->second != BroadSystem::NULL_BODY);
 
-		assert(it->second != BroadSystem::NULL_BODY);
+	const PhysicsBody* body = m_bodies[it->second].body;
 
+	const RectFloat aabb	= GetSweptAABB(ab.GetAABB(), body);
+	const RectFloat fat		= GetFatAABB(aabb, body);
+
+	if (!qtb.IsInserted() || !qtb.GetRect().Contains(aabb) || IsOversized(qtb.GetRect(), fat))
+	{
 		qtb.Erase();
-		qtb.Insert(m_quad_tree, ab.GetAABB().Inflate(P_AABB_INFLATE), it->second); // TODO: inflate based on velocity
+		qtb.Insert(m_quad_tree, fat, it->second);
+
+		++m_reinsert_count;
 	}
 }
 
-void BroadSystem::GatherCollisions()
+void BroadSystem::UpdateTree()
 {
-	const auto QueryResult = [this](const CollisionBody& object)
+	for (std::size_t i = 0; i < m_bodies.size(); ++i)
 	{
-		switch (object.type)
+		const CollisionBody& body = m_bodies[i];
+		int& proxy = m_proxies[i];
+
+		if (body.aabb == nullptr) [[unlikely]]
 		{
-		case Shape::Point:
-			return m_quad_tree.Query(object.transform->GetPosition());
-		default:
-			return m_quad_tree.Query(object.aabb->GetAABB());
+			if (proxy != NULL_BODY)
+				m_aabb_tree.Erase(std::exchange(proxy, NULL_BODY));
+
+			continue;
 		}
-	};
 
+		const RectFloat aabb	= GetSweptAABB(body.aabb->GetAABB(), body.body);
+		const RectFloat fat		= GetFatAABB(aabb, body.body);
+
+		if (proxy == NULL_BODY)
+		{
+			proxy = m_aabb_tree.Insert(fat, static_cast<uint32>(i));
+			++m_reinsert_count;
+		}
+		else if (IsOversized(m_aabb_tree.GetRect(proxy), fat)) // moved fast before, but has slowed down since
+		{
+			m_aabb_tree.Erase(proxy);
+			proxy = m_aabb_tree.Insert(fat, static_cast<uint32>(i));
+			++m_reinsert_count;
+		}
+		else if (m_aabb_tree.Move(proxy, aabb, fat))
+		{
+			++m_reinsert_count;
+		}
+	}
+}
+
+void BroadSystem::UpdateSAP()
+{
 	for (std::size_t i = 0; i < m_bodies.size(); ++i)
 	{
-		const auto& lhs = m_bodies[i];
+		const CollisionBody& body = m_bodies[i];
+		int& proxy = m_proxies[i];
+
+		if (body.aabb == nullptr) [[unlikely]]
+		{
+			if (proxy != NULL_BODY)
+				m_sap.Erase(std::exchange(proxy, NULL_BODY));
 
-		if (!HasDataForCollision(lhs)) [[unlikely]] // unlikely since if you added a shape, you will likely have the other data as well
 			continue;
+		}
+
+		if (proxy == NULL_BODY)
+			proxy = m_sap.Insert(GetSweptAABB(body.aabb->GetAABB(), body.body), static_cast<uint32>(i));
+		else
+			m_sap.Move(proxy, GetSweptAABB(body.aabb->GetAABB(), body.body)); // exact bounds, sweeping is cheap when bodies move little
+	}
+
+	m_sap.Sweep();
+}
+
+void BroadSystem::UpdateGrid()
+{
+	for (std::size_t i = 0; i < m_bodies.size(); ++i)
+	{
+		const CollisionBody& body = m_bodies[i];
+		int& proxy = m_proxies[i];
+
+		if (body.aabb == nullptr) [[unlikely]]
+		{
+			if (proxy != NULL_BODY)
+				m_grid.Erase(std::exchange(proxy, NULL_BODY));
 
-		if (!lhs.collider->GetEnabled())
 			continue;
+		}
 
-		// if both have a physics body, do an early check to see if valid
-		const bool lhs_active = (lhs.body ? (lhs.body->IsAwake() && lhs.body->IsEnabled()) : 
-			(lhs.enter || lhs.overlap || lhs.exit));
+		if (proxy == NULL_BODY)
+			proxy = m_grid.Insert(GetSweptAABB(body.aabb->GetAABB(), body.body), static_cast<uint32>(i));
+		else
+			m_grid.Move(proxy, GetSweptAABB(body.aabb->GetAABB(), body.body)); // exact bounds, the grid is rebuilt anyway
+	}
 
-		for (const auto j : QueryResult(lhs))
+	m_grid.Rebuild();
+}
+
+template<class Tree>
+void BroadSystem::GatherCollisions(const Tree& tree)
+{
+	const std::size_t batch_count = (m_bodies.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+	if (m_batch_collisions.size() < batch_count)
+		m_batch_collisions.resize(batch_count);
+
+	// every batch of bodies is searched on its own thread and writes to its own list, jobs always start at a 
+	// multiple of the batch size so the list is given by where the job starts
+
+	m_entity_admin->GetThreadPool().ParallelFor(m_bodies.size(), BATCH_SIZE,
+		[this, &tree](std::size_t begin, std::size_t end)
 		{
-			const auto& rhs = m_bodies[m_quad_tree.Get(j)];
+			CollisionList& collisions = m_batch_collisions[begin / BATCH_SIZE];
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const auto& lhs = m_bodies[i];
+
+				if (!HasDataForCollision(lhs)) [[unlikely]] // unlikely since if you added a shape, you will likely have the other data as well
+					continue;
+
+				if (!lhs.collider->GetEnabled())
+					continue;
+
+				// if both have a physics body, do an early check to see if valid
+				const bool lhs_active = (lhs.body ? (lhs.body->IsAwake() && lhs.body->IsEnabled()) : 
+					(lhs.enter || lhs.overlap || lhs.exit));
+
+				const RectFloat lhs_aabb = GetSweptAABB(lhs.aabb->GetAABB(), lhs.body);
+
+				const auto AddCollision = [this, i, &lhs, &lhs_aabb, lhs_active, &collisions](auto, const uint32 k) // k is the index to the body
+				{
+					if (k <= i) // the pair is found from both bodies, only keep it from the one with the lower index
+						return;
+
+					const auto& rhs = m_bodies[k];
 
-			if (lhs.entity_id == rhs.entity_id) // skip same body
-				continue;
+					if (!HasDataForCollision(rhs)) [[unlikely]]
+						return;
 
-			if (!HasDataForCollision(rhs)) [[unlikely]]
-				continue;
+					if (!rhs.collider->GetEnabled() || !lhs.collider->layer.HasAny(rhs.collider->layer)) // enabled and matching layer
+						return;
 
-			if (!rhs.collider->GetEnabled() || !lhs.collider->layer.HasAny(rhs.collider->layer)) // enabled and matching layer
-				continue;
+					const bool rhs_active = (rhs.body ? (rhs.body->IsAwake() && rhs.body->IsEnabled()) : 
+						(rhs.enter || rhs.overlap || rhs.exit));
 
-			const bool rhs_active = (rhs.body ? (rhs.body->IsAwake() && rhs.body->IsEnabled()) : 
-				(rhs.enter || rhs.overlap || rhs.exit));
+					// skip attempting collision if both are either asleep or disabled
+					// in the case of no body, skip collision if both have no listeners
+					if (!lhs_active && !rhs_active) 
+						return;
 
-			// skip attempting collision if both are either asleep or disabled
-			// in the case of no body, skip collision if both have no listeners
-			if (!lhs_active && !rhs_active) 
-				continue;
+					// the trees store enlarged bounds, only keep pairs whose actual bounds overlap so that every backend finds the same pairs
+					if (!lhs_aabb.Overlaps(GetSweptAABB(rhs.aabb->GetAABB(), rhs.body)))
+						return;
 		
-			m_collisions.emplace_back(i, j);
-		}
+					collisions.emplace_back(static_cast<uint32>(i), k);
+				};
+
+				const bool is_bullet = (lhs.body != nullptr && lhs.body->IsBullet());
+
+				const auto Visit = [&tree, &AddCollision](const auto& area)
+				{
+					if constexpr (std::is_same_v<Tree, QuadTreeType>) // the tree is not modified while gathering, so skip the lock every search would take
+						tree.VisitUnlocked(area, AddCollision);
+					else
+						tree.Visit(area, AddCollision);
+				};
+
+				if (lhs.type == Shape::Point && !is_bullet) // visit instead of query to avoid allocating a list for every body
+					Visit(lhs.transform->GetPosition());
+				else
+					Visit(lhs_aabb);
+			}
+		});
+
+	for (std::size_t i = 0; i < batch_count; ++i) // merge in the order of the bodies, same result regardless of threads
+	{
+		CollisionList& collisions = m_batch_collisions[i];
+
+		m_collisions.insert(m_collisions.end(), collisions.begin(), collisions.end());
+		collisions.clear();
+	}
+}
+
+void BroadSystem::GatherPairs()
+{
+	const auto IsActive = [](const CollisionBody& object)
+	{
+		return object.body ? (object.body->IsAwake() && object.body->IsEnabled()) : 
+			(object.enter || object.overlap || object.exit);
+	};
+
+	for (const auto& [first, second] : m_sap.GetPairs())
+	{
+		const uint32 i = m_sap.Get(first);
+		const uint32 j = m_sap.Get(second);
+
+		const auto& lhs = m_bodies[i];
+		const auto& rhs = m_bodies[j];
+
+		if (!HasDataForCollision(lhs) || !HasDataForCollision(rhs)) [[unlikely]]
+			continue;
+
+		if (!lhs.collider->GetEnabled() || !rhs.collider->GetEnabled() || !lhs.collider->layer.HasAny(rhs.collider->layer))
+			continue;
+
+		if (!IsActive(lhs) && !IsActive(rhs))
+			continue;
+
+		m_collisions.emplace_back(std::min(i, j), std::max(i, j)); // lower body index first, same as when querying
 	}
 }
 
-void BroadSystem::CullDuplicates()
+void BroadSystem::SortBodies()
 {
-	std::ranges::sort(m_collisions.begin(), m_collisions.end(),
-		[](const CollisionPair& x, const CollisionPair& y)
+	std::vector<uint32> order(m_bodies.size());
+	std::iota(order.begin(), order.end(), 0);
+
+	std::ranges::sort(order, 
+		[this](uint32 lhs, uint32 rhs) { return m_bodies[lhs].entity_id < m_bodies[rhs].entity_id; });
+
+	BodyList bodies;
+	std::vector<int> proxies;
+
+	bodies.reserve(m_bodies.size());
+	proxies.reserve(m_proxies.size());
+
+	for (const uint32 j : order)
+	{
+		const uint32 i = static_cast<uint32>(bodies.size());
+
+		bodies.emplace_back(m_bodies[j]);
+		const int proxy = proxies.emplace_back(m_proxies[j]);
+
+		m_entity_body_map[bodies.back().entity_id] = i;
+
+		if (proxy != NULL_BODY) // the structures refer to the bodies by index
 		{
-			return (x.first < y.first) || (x.first == y.first && x.second < y.second);
-		});
+			switch (m_backend)
+			{
+			case Backend::AABBTree:			m_aabb_tree.Update(proxy, i); break;
+			case Backend::SweepAndPrune:	m_sap.Update(proxy, i); break;
+			case Backend::Grid:				m_grid.Update(proxy, i); break;
+			default: break;
+			}
+		}
 
-	const auto [first, last] = std::ranges::unique(m_collisions.begin(), m_collisions.end(),
-		[](const CollisionPair& x, const CollisionPair& y)
+		if (m_backend == Backend::QuadTree)
 		{
-			return x == y;
-		});
+			if (QTBody* qtb = m_entity_admin->TryGetComponent<QTBody>(bodies.back().entity_id); qtb != nullptr)
+				qtb->Update(i);
+		}
+	}
+
+	m_bodies	= std::move(bodies);
+	m_proxies	= std::move(proxies);
+
+	m_order_dirty = false;
+}
 
-	m_collisions.erase(first, last);
+template<typename Func>
+void BroadSystem::VisitBodies(const RectFloat& rect, Func&& func) const
+{
+	const auto Visit = [&func](auto, const uint32 k) { func(k); };
+
+	switch (m_backend)
+	{
+	case Backend::QuadTree:
+		m_quad_tree.Visit(rect, Visit);
+		break;
+	case Backend::AABBTree:
+		m_aabb_tree.Visit(rect, Visit);
+		break;
+	case Backend::SweepAndPrune:
+		m_sap.Visit(rect, Visit);
+		break;
+	case Backend::Grid:
+		m_grid.Visit(rect, Visit);
+		break;
+	}
+}
+
+template<typename Func>
+void BroadSystem::VisitBodies(const Ray& ray, Func&& func) const
+{
+	if (m_backend == Backend::AABBTree) // traversed along the ray, skipping everything behind the closest hit
+	{
+		m_aabb_tree.RayCast(ray.origin, ray.direction, 
+			[&func](auto, const uint32 k) { return func(k); });
+
+		return;
+	}
+
+	const Vector2f end = ray.origin + ray.direction;
+
+	const RectFloat bounds(
+		std::min(ray.origin.x, end.x), 
+		std::min(ray.origin.y, end.y), 
+		std::abs(ray.direction.x), 
+		std::abs(ray.direction.y));
+
+	VisitBodies(bounds, 
+		[&func](const uint32 k) { (void)func(k); });
 }
 
 int BroadSystem::CreateBody(EntityID eid, Shape* shape, typename Shape::Type type)
@@ -156,6 +562,7 @@ int BroadSystem::CreateBody(EntityID eid, Shape* shape, typename Shape::Type typ
 	assert(!m_entity_body_map.contains(eid));
 
 	CollisionBody& body = m_bodies.emplace_back(eid, type);
+	m_proxies.emplace_back(NULL_BODY);
 
 	auto components = m_entity_admin->TryGetComponents<
 		Collider, PhysicsBody, BodyTransform, ColliderAABB, 
@@ -171,6 +578,8 @@ int BroadSystem::CreateBody(EntityID eid, Shape* shape, typename Shape::Type typ
 	body.exit		= std::get<ColliderExit*>(components);
 	body.overlap	= std::get<ColliderOverlap*>(components);
 
+	m_order_dirty = true;
+
 	return m_entity_body_map.try_emplace(eid, m_bodies.size() - 1).first->second;
 }
 
@@ -190,13 +599,97 @@ void BroadSystem::RemoveBody(EntityID eid)
 	const auto it2 = m_entity_body_map.find(m_bodies.back().entity_id);
 	assert(it2 != m_entity_body_map.end() && "Entity should be in the map");
 
-	if (QTBody* qtb = m_entity_admin->TryGetComponent<QTBody>(it2->second); qtb != nullptr)
+	if (QTBody* qtb = m_entity_admin->TryGetComponent<QTBody>(m_bodies.back().entity_id); qtb != nullptr)
 		qtb->Update(it1->second); // update the index in the quad tree
 
+	if (const int proxy = m_proxies[it1->second]; proxy != NULL_BODY)
+	{
+		switch (m_backend)
+		{
+		case Backend::AABBTree:			m_aabb_tree.Erase(proxy); break;
+		case Backend::SweepAndPrune:	m_sap.Erase(proxy); break;
+		case Backend::Grid:				m_grid.Erase(proxy); break;
+		default: break;
+		}
+	}
+
+	if (const int proxy = m_proxies.back(); proxy != NULL_BODY) // last body takes the place of the removed one
+	{
+		switch (m_backend)
+		{
+		case Backend::AABBTree:			m_aabb_tree.Update(proxy, it1->second); break;
+		case Backend::SweepAndPrune:	m_sap.Update(proxy, it1->second); break;
+		case Backend::Grid:				m_grid.Update(proxy, it1->second); break;
+		default: break;
+		}
+	}
+
 	it2->second = it1->second;
 
 	cu::SwapPopAt(m_bodies, it1->second);
+	cu::SwapPopAt(m_proxies, it1->second);
 	m_entity_body_map.erase(it1);
+
+	m_order_dirty = true;
+}
+
+RectFloat BroadSystem::GetSweptAABB(const RectFloat& aabb, const PhysicsBody* body) const
+{
+	if (body == nullptr || !body->IsBullet() || !body->IsAwake())
+		return aabb;
+
+	// the velocity of the coming step is not known yet, the one from the last step is used to predict the motion
+
+	return aabb.Union(aabb + body->GetVelocity() * m_time_step);
+}
+
+RectFloat BroadSystem::GetFatAABB(const RectFloat& aabb, const PhysicsBody* body) const
+{
+	RectFloat fat(
+		aabb.left	- P_AABB_MARGIN, 
+		aabb.top	- P_AABB_MARGIN, 
+		aabb.width	+ P_AABB_MARGIN * 2.0f, 
+		aabb.height + P_AABB_MARGIN * 2.0f);
+
+	if (body == nullptr || body->GetType() == BodyType::Static || !body->IsAwake())
+		return fat;
+
+	// extended ahead in the direction of motion, so that moving bodies stay inside for a few steps
+
+	const Vector2f displacement = body->GetVelocity() * (m_time_step * P_AABB_DISPLACEMENT);
+
+	const float dx = std::clamp(displacement.x, -P_AABB_MAX_DISPLACEMENT, P_AABB_MAX_DISPLACEMENT);
+	const float dy = std::clamp(displacement.y, -P_AABB_MAX_DISPLACEMENT, P_AABB_MAX_DISPLACEMENT);
+
+	if (dx < 0.0f) 
+		fat.left += dx;
+
+	if (dy < 0.0f) 
+		fat.top += dy;
+
+	fat.width	+= std::abs(dx);
+	fat.height	+= std::abs(dy);
+
+	return fat;
+}
+
+bool BroadSystem::IsOversized(const RectFloat& stored, const RectFloat& fat)
+{
+	return stored.Area() > fat.Area() * P_AABB_SHRINK;
+}
+
+bool BroadSystem::IsQueryable(const CollisionBody& body, CollisionLayer layer)
+{
+	return HasDataForCollision(body) && body.collider->GetEnabled() && layer.HasAny(body.collider->layer);
+}
+
+SimpleTransform BroadSystem::GetTransform(const CollisionBody& body)
+{
+	SimpleTransform transform;
+	transform.SetPosition(body.transform->GetPosition());
+	transform.SetRotation(body.transform->GetRotation());
+
+	return transform;
 }
 
 bool BroadSystem::HasDataForCollision(const CollisionBody& object)
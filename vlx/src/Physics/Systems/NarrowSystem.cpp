@@ -22,8 +22,43 @@ void NarrowSystem::Update(BroadSystem& broad)
 	m_collisions.clear();
 	m_manifolds.clear();
 
-	for (const auto& pair : broad.GetCollisions())
-		CheckCollision(broad, pair.first, pair.second);
+	const auto& pairs = broad.GetCollisions();
+
+	const std::size_t batch_count = (pairs.size() + BATCH_SIZE - 1) / BATCH_SIZE;
+	if (m_batches.size() < batch_count)
+		m_batches.resize(batch_count);
+
+	// jobs always start at a multiple of the batch size, so the batch is given by where the job starts
+
+	m_entity_admin->GetThreadPool().ParallelFor(pairs.size(), BATCH_SIZE,
+		[this, &broad, &pairs](std::size_t begin, std::size_t end)
+		{
+			Batch& batch = m_batches[begin / BATCH_SIZE];
+
+			for (std::size_t i = begin; i < end; ++i)
+				CheckCollision(broad, pairs[i].first, pairs[i].second, batch);
+		});
+
+	for (std::size_t i = 0; i < batch_count; ++i)
+	{
+		Batch& batch = m_batches[i];
+
+		m_collisions.insert(m_collisions.end(), batch.collisions.begin(), batch.collisions.end());
+		m_manifolds.insert(m_manifolds.end(), batch.manifolds.begin(), batch.manifolds.end());
+
+		batch.collisions.clear();
+		batch.manifolds.clear();
+	}
+
+	for (std::size_t i = 0; i < batch_count; ++i) // callbacks may touch anything, so they are kept on this thread
+	{
+		Batch& batch = m_batches[i];
+
+		for (const CollisionEvent& event : batch.events)
+			DispatchEvent(broad, event);
+
+		batch.events.clear();
+	}
 
 	const auto cmp = [](const EntityPair& lhs, const EntityPair& rhs)
 	{
@@ -71,7 +106,7 @@ auto NarrowSystem::GetManifolds() noexcept -> LocalManifolds&
 	return m_manifolds;
 }
 
-void NarrowSystem::CheckCollision(BroadSystem& broad, uint32 l, uint32 r)
+void NarrowSystem::CheckCollision(const BroadSystem& broad, uint32 l, uint32 r, Batch& batch) const
 {
 	const CollisionBody& A = broad.GetBody(l);
 	const CollisionBody& B = broad.GetBody(r);
@@ -94,54 +129,78 @@ void NarrowSystem::CheckCollision(BroadSystem& broad, uint32 l, uint32 r)
 
 		if (AB && BB && (AB->GetType() == BodyType::Dynamic || BB->GetType() == BodyType::Dynamic)) // only resolve if both entities has a physics body and either one is dynamic
 		{
-			m_collisions.emplace_back(l, r);
-			m_manifolds.emplace_back(lm);
+			batch.collisions.emplace_back(l, r);
+			batch.manifolds.emplace_back(lm);
 		}
 
 		const bool has_enter	= (A.enter && A.enter->OnEnter) || (B.enter && B.enter->OnEnter);
 		const bool has_exit		= (A.exit && A.exit->OnExit) || (B.exit && B.exit->OnExit);
-		const bool has_overlap	= (A.overlap && A.overlap->OnOverlap);
+		const bool has_overlap	= (A.overlap && A.overlap->OnOverlap) || (B.overlap && B.overlap->OnOverlap);
 
 		if (has_enter || has_exit || has_overlap)
-		{
-			EntityPair pair = (A.entity_id < B.entity_id) ?
-				EntityPair{A.entity_id, B.entity_id} :
-				EntityPair{B.entity_id, A.entity_id};
+			batch.events.emplace_back(l, r, lm);
+	}
+}
 
-			CollisionResult a_result{B.entity_id}; // store other entity
-			CollisionResult b_result{A.entity_id};
+void NarrowSystem::DispatchEvent(const BroadSystem& broad, const CollisionEvent& event)
+{
+	const CollisionBody& A = broad.GetBody(event.l);
+	const CollisionBody& B = broad.GetBody(event.r);
 
-			WorldManifold world;
-			world.Initialize(lm, AW, A.shape->GetRadius(), BW, B.shape->GetRadius());
+	const LocalManifold& lm = event.manifold;
 
-			for (uint8 i = 0; i < lm.contacts_count; ++i)
-			{
-				a_result.contacts[i].hit			= world.contacts[i];
-				a_result.contacts[i].penetration	= world.penetrations[i];
-			}
+	SimpleTransform AW;
+	SimpleTransform BW;
+
+	AW.SetPosition(A.transform->GetPosition());
+	BW.SetPosition(B.transform->GetPosition());
+
+	AW.SetRotation(A.transform->GetRotation());
+	BW.SetRotation(B.transform->GetRotation());
+
+	const bool has_enter	= (A.enter && A.enter->OnEnter) || (B.enter && B.enter->OnEnter);
+	const bool has_exit		= (A.exit && A.exit->OnExit) || (B.exit && B.exit->OnExit);
+	const bool has_overlap	= (A.overlap && A.overlap->OnOverlap) || (B.overlap && B.overlap->OnOverlap);
 
-			b_result = a_result;
+	EntityPair pair = (A.entity_id < B.entity_id) ?
+		EntityPair{A.entity_id, B.entity_id} :
+		EntityPair{B.entity_id, A.entity_id};
 
-			a_result.normal =  world.normal;
-			b_result.normal = -world.normal; // flip normal for other
+	CollisionResult a_result{B.entity_id}; // store other entity
+	CollisionResult b_result{A.entity_id};
 
-			if (has_enter || has_exit)
-			{
-				if (auto ait = m_collision_map.find(pair); ait == m_collision_map.end()) // first time
-				{
- 					if (A.enter) A.enter->OnEnter(a_result);
-					if (B.enter) B.enter->OnEnter(b_result);
+	WorldManifold world;
+	world.Initialize(lm, AW, A.shape->GetRadius(), BW, B.shape->GetRadius());
 
-					m_collision_map.emplace(
-						m_entity_admin->GetComponentRef(A.entity_id, A.exit),
-						m_entity_admin->GetComponentRef(B.entity_id, B.exit), A.entity_id, B.entity_id);
-				}
+	for (uint8 i = 0; i < lm.contacts_count; ++i)
+	{
+		a_result.contacts[i].hit			= world.contacts[i];
+		a_result.contacts[i].penetration	= world.penetrations[i];
+	}
 
-				m_curr_collisions.emplace_back(pair);
-			}
+	b_result = a_result;
 
-			if (has_overlap)
-				A.overlap->OnOverlap(a_result); // only needs to be called for A since B overlap will be called later
+	a_result.normal =  world.normal;
+	b_result.normal = -world.normal; // flip normal for other
+
+	if (has_enter || has_exit)
+	{
+		if (auto ait = m_collision_map.find(pair); ait == m_collision_map.end()) // first time
+		{
+ 			if (A.enter) A.enter->OnEnter(a_result);
+			if (B.enter) B.enter->OnEnter(b_result);
+
+			m_collision_map.emplace(
+				m_entity_admin->GetComponentRef(A.entity_id, A.exit),
+				m_entity_admin->GetComponentRef(B.entity_id, B.exit), A.entity_id, B.entity_id);
 		}
+
+		m_curr_collisions.emplace_back(pair);
 	}
-}
+
+	if (has_overlap) // every pair is only checked once, so call for both
+	{
+		if (A.overlap && A.overlap->OnOverlap) A.overlap->OnOverlap(a_result);
+		if (B.overlap && B.overlap->OnOverlap) B.overlap->OnOverlap(b_result);
+	}
+}
\ No newline at end of file
@@ -13,19 +13,19 @@ PhysicsDirtySystem::PhysicsDirtySystem(EntityAdmin& entity_admin, LayerType id)
 	m_polygons(			entity_admin, id)
 
 {
-	m_dirty_transform.Each([](Collider& c, Transform& t)
+	m_dirty_transform.Each([](Collider& c, const Transform& t)
 		{
 			if (t.m_dirty)
 				c.dirty = true;
 		});
 
-	m_dirty_physics.Each([](Collider& c, Transform& t)
+	m_dirty_physics.Each([](Collider& c, const Transform& t)
 		{
 			if (t.m_dirty)
 				c.dirty = true;
 		});
 
-	m_circles.Each([](Circle& s, Collider& c, ColliderAABB& ab, Transform& t)
+	m_circles.Each([](const Circle& s, Collider& c, ColliderAABB& ab, const Transform& t)
 		{
 			if (c.dirty)
 			{
@@ -34,7 +34,7 @@ PhysicsDirtySystem::PhysicsDirtySystem(EntityAdmin& entity_admin, LayerType id)
 			}
 		});
 
-	m_boxes.Each([](Box& b, Collider& c, ColliderAABB& ab, TransformMatrix& tm)
+	m_boxes.Each([](const Box& b, Collider& c, ColliderAABB& ab, const TransformMatrix& tm)
 		{
 			if (c.dirty)
 			{
@@ -43,7 +43,7 @@ PhysicsDirtySystem::PhysicsDirtySystem(EntityAdmin& entity_admin, LayerType id)
 			}
 		});
 
-	m_polygons.Each([](Polygon& p, Collider& c, ColliderAABB& ab, TransformMatrix& tm)
+	m_polygons.Each([](const Polygon& p, Collider& c, ColliderAABB& ab, const TransformMatrix& tm)
 		{
 			if (c.dirty)
 			{
@@ -1,7 +1,39 @@
 #include <Velox/Physics/Systems/PhysicsSystem.h>
 
+#include <bit>
+#include <array>
+#include <type_traits>
+
+#if VELOX_DETERMINISTIC && defined(_MSC_VER) && defined(_M_X64)
+#	include <cmath>
+#endif
+
+#include <Velox/System/Profiler.h>
+
+#include <Velox/ECS/EntityAdmin.h>
+
 using namespace vlx;
 
+namespace
+{
+	constexpr uint64 FNV_OFFSET_BASIS	= 0xcbf29ce484222325;
+	constexpr uint64 FNV_PRIME			= 0x100000001b3;
+
+	/// FNV-1a over the bytes of the value, same on every platform unlike std::hash
+	/// 
+	template<typename T> requires std::is_trivially_copyable_v<T>
+	void HashCombine(uint64& hash, const T& value)
+	{
+		const auto bytes = std::bit_cast<std::array<uint8, sizeof(T)>>(value);
+
+		for (const uint8 byte : bytes)
+		{
+			hash ^= byte;
+			hash *= FNV_PRIME;
+		}
+	}
+}
+
 PhysicsSystem::PhysicsSystem(EntityAdmin& entity_admin, LayerType id, Time& time)
 	: SystemAction(entity_admin, id, true), 
 
@@ -23,6 +55,13 @@ PhysicsSystem::PhysicsSystem(EntityAdmin& entity_admin, LayerType id, Time& time
 	m_sleep_bodies.Each(&PhysicsSystem::SleepBodies, this);
 	m_pre_solve.Each(&PhysicsSystem::PreSolve, this);
 	m_post_solve.Each(&PhysicsSystem::PostSolve, this);
+
+#if VELOX_DETERMINISTIC
+#	if defined(_MSC_VER) && defined(_M_X64)
+	_set_FMA3_enable(0); // process wide, otherwise the runtime picks the math functions by what the processor supports
+#	endif
+	SetDeterministic(true);
+#endif
 }
 
 const Vector2f& PhysicsSystem::GetGravity() const
@@ -45,36 +84,189 @@ void PhysicsSystem::SetPositionIterations(int iterations)
 	m_position_iterations = iterations;
 }
 
+void PhysicsSystem::SetWarmStarting(bool flag)
+{
+	m_collision_solver.SetWarmStarting(flag);
+}
+
+void PhysicsSystem::SetSolverType(SolverType type)
+{
+	if (m_solver_type == type)
+		return;
+
+	m_solver_type = type;
+	m_collision_solver.ClearImpulses(); // impulses are cached per step by one solver and per sub-step by the other
+}
+
+auto PhysicsSystem::GetSolverType() const noexcept -> SolverType
+{
+	return m_solver_type;
+}
+
+void PhysicsSystem::SetSubSteps(int sub_steps)
+{
+	assert(sub_steps > 0);
+	m_sub_steps = sub_steps;
+}
+
+void PhysicsSystem::SetDeterministic(bool flag)
+{
+	m_deterministic = flag;
+	m_broad_system.SetDeterministic(flag);
+}
+
+bool PhysicsSystem::GetDeterministic() const noexcept
+{
+	return m_deterministic;
+}
+
+void PhysicsSystem::SetBroadPhase(BroadSystem::Backend backend)
+{
+	m_broad_system.SetBackend(backend);
+}
+
+auto PhysicsSystem::GetBroadPhase() const noexcept -> BroadSystem::Backend
+{
+	return m_broad_system.GetBackend();
+}
+
+const BroadSystem& PhysicsSystem::GetBroadSystem() const noexcept
+{
+	return m_broad_system;
+}
+
+uint64 PhysicsSystem::GetStateHash() const noexcept
+{
+	return m_state_hash;
+}
+
+std::optional<QueryHit> PhysicsSystem::RayCast(const Ray& ray, CollisionLayer layer) const
+{
+	return m_broad_system.RayCast(ray, layer);
+}
+
+void PhysicsSystem::RayCast(std::span<const Ray> rays, std::span<std::optional<QueryHit>> hits, CollisionLayer layer) const
+{
+	m_broad_system.RayCast(rays, hits, layer);
+}
+
+std::optional<QueryHit> PhysicsSystem::ShapeCast(const Shape& shape, typename Shape::Type type, 
+	const SimpleTransform& transform, const Vector2f& translation, CollisionLayer layer) const
+{
+	return m_broad_system.ShapeCast(shape, type, transform, translation, layer);
+}
+
+std::vector<EntityID> PhysicsSystem::Overlap(const Shape& shape, typename Shape::Type type, 
+	const SimpleTransform& transform, CollisionLayer layer) const
+{
+	return m_broad_system.Overlap(shape, type, transform, layer);
+}
+
+std::vector<EntityID> PhysicsSystem::Overlap(const Vector2f& center, float radius, CollisionLayer layer) const
+{
+	return m_broad_system.Overlap(center, radius, layer);
+}
+
 void PhysicsSystem::FixedUpdate()
 {
+	VELOX_PROFILE_SCOPE("PhysicsSystem::FixedUpdate");
+
 	Execute(m_pre_solve);
 
-	m_broad_system.Update();
-	m_narrow_system.Update(m_broad_system);
+	{
+		VELOX_PROFILE_SCOPE("PhysicsSystem::BroadPhase");
+		m_broad_system.Update(m_time->GetFixedDT());
+	}
+
+	{
+		VELOX_PROFILE_SCOPE("PhysicsSystem::NarrowPhase");
+		m_narrow_system.Update(m_broad_system);
+	}
+
+	const auto& bodies = m_broad_system.GetBodies();
+
+	{
+		VELOX_PROFILE_SCOPE("PhysicsSystem::BuildIslands");
+		m_islands.Build(bodies, m_narrow_system.GetCollisions(), m_narrow_system.GetManifolds());
+	}
+
+	const auto& collisions	= m_islands.GetCollisions(); // sorted by island
+	const auto& manifolds	= m_islands.GetManifolds();
+	const auto batches		= m_islands.GetBatches();
 
-	const auto& bodies		= m_broad_system.GetBodies();
-	const auto& collisions	= m_narrow_system.GetCollisions();
-	const auto& manifolds	= m_narrow_system.GetManifolds();
+	ThreadPool& thread_pool = m_entity_admin->GetThreadPool();
 
 	Execute(m_integrate_velocity);
 
-	m_collision_solver.CreateConstraints(bodies, collisions, manifolds);
-	m_collision_solver.SetupConstraints(bodies, collisions, manifolds, *m_time, m_gravity);
+	{
+		VELOX_PROFILE_SCOPE("PhysicsSystem::SolveVelocity");
+
+		m_collision_solver.CreateConstraints(bodies, collisions, batches);
 
-	for (int i = 0; i < m_velocity_iterations; ++i)
-		m_collision_solver.ResolveVelocity(bodies, collisions);
+		thread_pool.ParallelFor(batches.size(), 1, // islands share no moving bodies and are solved independently
+			[this, &bodies, &collisions, &manifolds](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					m_collision_solver.SetupConstraints(bodies, collisions, manifolds, *m_time, m_gravity, i);
+
+					if (m_solver_type == SolverType::SoftStep)
+					{
+						m_collision_solver.SolveSubSteps(bodies, *m_time, m_gravity, m_sub_steps, i);
+						continue;
+					}
+
+					m_collision_solver.WarmStart(i);
+
+					for (int j = 0; j < m_velocity_iterations; ++j)
+						m_collision_solver.ResolveVelocity(i);
+				}
+			});
+
+		m_collision_solver.StoreVelocities(bodies);
+		m_collision_solver.StoreImpulses(bodies, collisions, manifolds);
+	}
+
+	GatherBullets();
 
 	Execute(m_integrate_position);
 
-	for (int i = 0; i < m_position_iterations; ++i)
+	if (m_solver_type == SolverType::SoftStep) // bodies in contact were already moved by the sub-steps
+	{
+		m_collision_solver.StorePositions(bodies);
+	}
+	else
+	{
+		VELOX_PROFILE_SCOPE("PhysicsSystem::ResolvePosition");
+
+		thread_pool.ParallelFor(batches.size(), 1,
+			[this, &bodies, &collisions, &manifolds, &batches](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+				{
+					const auto& batch = batches[i];
+
+					for (int j = 0; j < m_position_iterations; ++j)
+					{
+						if (m_collision_solver.ResolvePosition(bodies, collisions, manifolds, batch.contacts_begin, batch.contacts_end))
+							break;
+					}
+				}
+			});
+	}
+
 	{
-		if (m_collision_solver.ResolvePosition(bodies, collisions, manifolds))
-			break;
+		VELOX_PROFILE_SCOPE("PhysicsSystem::SolveBullets");
+		SolveBullets();
 	}
 
 	Execute(m_sleep_bodies);
+	m_islands.Sleep(bodies);
 
 	Execute(m_post_solve);
+
+	if (m_deterministic)
+		m_state_hash = ComputeStateHash();
 }
 
 void PhysicsSystem::IntegrateVelocity(PhysicsBody& pb) const
@@ -125,13 +317,120 @@ void PhysicsSystem::SleepBodies(PhysicsBody& pb) const
 	}
 	else
 	{
-		pb.m_sleep_time += m_time->GetRealDT();
+		pb.m_sleep_time += m_time->GetFixedDT(); // runs once per fixed step, so frame rate does not decide when bodies sleep
 	}
 
-	if (pb.m_sleep_time >= 0.5f)
+	if (pb.m_sleep_time >= P_TIME_TO_SLEEP && pb.m_island == -1) // bodies in islands are put to sleep together
 		pb.SetAwake(false);
 }
 
+void PhysicsSystem::GatherBullets()
+{
+	m_bullets.clear();
+
+	const auto& bodies = m_broad_system.GetBodies();
+
+	for (uint32 i = 0; i < bodies.size(); ++i)
+	{
+		const CollisionBody& body = bodies[i];
+
+		if (body.body == nullptr || body.shape == nullptr || body.transform == nullptr || body.aabb == nullptr)
+			continue;
+
+		const PhysicsBody& pb = *body.body;
+
+		if (!pb.IsBullet() || pb.GetType() != BodyType::Dynamic || !pb.IsAwake() || !pb.IsEnabled())
+			continue;
+
+		Bullet& bullet = m_bullets.emplace_back(); // where the body starts the step, before it is moved
+
+		bullet.index				= i;
+		bullet.sweep.position_start = body.transform->GetPosition();
+		bullet.sweep.rotation_start = body.transform->GetRotation();
+	}
+}
+
+void PhysicsSystem::SolveBullets()
+{
+	if (m_bullets.empty())
+		return;
+
+	const auto& bodies = m_broad_system.GetBodies();
+
+	m_bullet_indices.assign(bodies.size(), -1);
+
+	for (std::size_t i = 0; i < m_bullets.size(); ++i)
+	{
+		Bullet& bullet = m_bullets[i];
+		const BodyTransform& bt = *bodies[bullet.index].transform;
+
+		bullet.sweep.position_end = bt.GetPosition();
+		bullet.sweep.rotation_end = bt.GetRotation();
+
+		m_bullet_indices[bullet.index] = static_cast<int32>(i);
+	}
+
+	m_bullet_candidates.clear();
+
+	for (const auto& [a, b] : m_broad_system.GetCollisions()) // bounds of bullets were swept, so this is everything they may hit
+	{
+		const int32 bullet_a = m_bullet_indices[a];
+		const int32 bullet_b = m_bullet_indices[b];
+
+		if ((bullet_a == -1) == (bullet_b == -1)) // two bullets are left to the regular contacts
+			continue;
+
+		const uint32 other = (bullet_a == -1) ? a : b;
+
+		if (bodies[other].body == nullptr) // only bodies block bullets, the rest just listen for events
+			continue;
+
+		m_bullet_candidates.emplace_back(static_cast<uint32>(std::max(bullet_a, bullet_b)), other);
+	}
+
+	std::ranges::sort(m_bullet_candidates);
+
+	// every bullet only moves itself, and is only swept against bodies that are not bullets
+
+	m_entity_admin->GetThreadPool().ParallelFor(m_bullets.size(), BULLET_BATCH_SIZE,
+		[this, &bodies](std::size_t begin, std::size_t end)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const Bullet& bullet = m_bullets[i];
+				const CollisionBody& A = bodies[bullet.index];
+
+				const Vector2f motion	= Vector2f::Direction(bullet.sweep.position_start, bullet.sweep.position_end);
+				const RectFloat& aabb	= A.aabb->GetAABB();
+
+				if (motion.LengthSq() < au::Sqr(0.5f * std::min(aabb.width, aabb.height))) // too short to pass through anything
+					continue;
+
+				float toi = 1.0f;
+
+				auto it = std::ranges::lower_bound(m_bullet_candidates, std::pair<uint32, uint32>(static_cast<uint32>(i), 0));
+				for (; it != m_bullet_candidates.end() && it->first == i; ++it)
+				{
+					const CollisionBody& B = bodies[it->second];
+
+					SimpleTransform BW;
+					BW.SetPosition(B.transform->GetPosition());
+					BW.SetRotation(B.transform->GetRotation());
+
+					toi = std::min(toi, TimeOfImpact::Compute(*A.shape, A.type, bullet.sweep, *B.shape, B.type, BW));
+				}
+
+				if (toi >= 1.0f)
+					continue;
+
+				// moved back to the impact and keeps its velocity, the contact is then resolved on the next step
+
+				A.transform->m_position = bullet.sweep.position_start + motion * toi;
+				A.transform->m_rotation = bullet.sweep.rotation_start + (bullet.sweep.rotation_end - bullet.sweep.rotation_start) * toi;
+			}
+		});
+}
+
 void PhysicsSystem::PreSolve(BodyTransform& bt, BodyLastTransform& blt, const Transform& t) const
 {
 	// possible because a physics body is not allowed to have a parent
@@ -144,3 +443,30 @@ void PhysicsSystem::PostSolve(const BodyTransform& bt, Transform& t) const
 	t.SetPosition(bt.m_position);
 	t.SetRotation(bt.m_rotation);
 }
+
+uint64 PhysicsSystem::ComputeStateHash() const
+{
+	uint64 hash = FNV_OFFSET_BASIS;
+
+	for (const CollisionBody& body : m_broad_system.GetBodies()) // sorted by entity when deterministic
+	{
+		HashCombine(hash, body.entity_id);
+
+		if (body.transform != nullptr)
+		{
+			HashCombine(hash, body.transform->GetPosition().x);
+			HashCombine(hash, body.transform->GetPosition().y);
+			HashCombine(hash, body.transform->GetRotation().asRadians());
+		}
+
+		if (body.body != nullptr)
+		{
+			HashCombine(hash, body.body->GetVelocity().x);
+			HashCombine(hash, body.body->GetVelocity().y);
+			HashCombine(hash, body.body->GetAngularVelocity());
+			HashCombine(hash, static_cast<uint8>(body.body->IsAwake()));
+		}
+	}
+
+	return hash;
+}
\ No newline at end of file
@@ -0,0 +1,213 @@
+#include <Velox/System/Profiler.h>
+
+#include <atomic>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <fstream>
+#include <cassert>
+#include <string>
+#include <unordered_set>
+
+#include <nlohmann/json.hpp>
+
+#include <Velox/System/ThreadPool.h>
+
+using namespace vlx;
+
+namespace
+{
+	struct OpenZone
+	{
+		const char*	name	{nullptr};
+		uint64		begin	{0};
+	};
+
+	struct ThreadLog
+	{
+		std::vector<Profiler::Zone>						zones = std::vector<Profiler::Zone>(Profiler::ZONE_CAPACITY); // ring buffer
+		std::array<OpenZone, Profiler::MAX_DEPTH>		open;
+
+		std::atomic<uint64>	count	{0};	// total number of zones recorded, only written to by the owning thread
+		std::atomic<uint64>	first	{0};	// zones before this have been cleared
+		uint32				depth	{0};
+
+		uint32		id			{0};	// order in which the threads started recording
+		std::size_t	pool_index	{0};	// index of the thread in its pool, zero if not a worker
+	};
+
+	struct ProfilerState
+	{
+		const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+		std::atomic_bool						enabled {false};
+		std::mutex								mutex;	// only guards the list of logs, never taken while recording
+		std::vector<std::unique_ptr<ThreadLog>>	logs;
+
+		std::mutex								names_mutex;
+		std::unordered_set<std::string>			names;	// interned names, nodes are never moved
+	};
+
+	ProfilerState& GetState()
+	{
+		static ProfilerState state;
+		return state;
+	}
+
+	thread_local ThreadLog* t_log = nullptr;
+
+	ThreadLog& GetLog()
+	{
+		if (t_log == nullptr) // first zone on this thread, register a new log
+		{
+			ProfilerState& state = GetState();
+
+			auto log = std::make_unique<ThreadLog>();
+			log->pool_index = ThreadPool::GetThreadIndex();
+
+			std::lock_guard lock(state.mutex);
+
+			log->id = static_cast<uint32>(state.logs.size());
+			t_log = state.logs.emplace_back(std::move(log)).get();
+		}
+
+		return *t_log;
+	}
+
+	template<class Func>
+	void ForEachZone(const ThreadLog& log, Func&& func)
+	{
+		const uint64 count = log.count.load(std::memory_order_acquire);
+		const uint64 first = std::max(log.first.load(std::memory_order_relaxed), 
+			count > Profiler::ZONE_CAPACITY ? count - Profiler::ZONE_CAPACITY : 0);
+
+		for (uint64 i = first; i < count; ++i)
+			func(log.zones[i & (Profiler::ZONE_CAPACITY - 1)]);
+	}
+}
+
+bool Profiler::IsEnabled() noexcept
+{
+	return GetState().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::SetEnabled(bool flag) noexcept
+{
+	GetState().enabled.store(flag, std::memory_order_relaxed);
+}
+
+uint64 Profiler::Now() noexcept
+{
+	return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - GetState().epoch).count());
+}
+
+const char* Profiler::Intern(std::string_view name)
+{
+	ProfilerState& state = GetState();
+
+	std::lock_guard lock(state.names_mutex);
+	return state.names.emplace(name).first->c_str();
+}
+
+void Profiler::BeginZone(const char* name)
+{
+	ThreadLog& log = GetLog();
+
+	if (log.depth < MAX_DEPTH) // deeper zones are only counted so that the end calls still match
+		log.open[log.depth] = OpenZone{ name, Now() };
+
+	++log.depth;
+}
+
+void Profiler::EndZone()
+{
+	ThreadLog& log = GetLog();
+
+	assert(log.depth > 0 && "No zone has been opened on this thread");
+	if (log.depth == 0)
+		return;
+
+	if (--log.depth >= MAX_DEPTH)
+		return;
+
+	const OpenZone& open = log.open[log.depth];
+	const uint64 count = log.count.load(std::memory_order_relaxed);
+
+	log.zones[count & (ZONE_CAPACITY - 1)] = Zone{ open.name, open.begin, Now(), log.depth };
+	log.count.store(count + 1, std::memory_order_release);
+}
+
+std::vector<std::vector<Profiler::Zone>> Profiler::GetZones()
+{
+	ProfilerState& state = GetState();
+	std::lock_guard lock(state.mutex);
+
+	std::vector<std::vector<Zone>> result;
+	result.reserve(state.logs.size());
+
+	for (const auto& log : state.logs)
+	{
+		auto& zones = result.emplace_back();
+		ForEachZone(*log, 
+			[&zones](const Zone& zone)
+			{
+				zones.emplace_back(zone);
+			});
+	}
+
+	return result;
+}
+
+void Profiler::Clear()
+{
+	ProfilerState& state = GetState();
+	std::lock_guard lock(state.mutex);
+
+	for (const auto& log : state.logs)
+		log->first.store(log->count.load(std::memory_order_acquire), std::memory_order_relaxed);
+}
+
+bool Profiler::WriteChromeTrace(std::string_view path)
+{
+	ProfilerState& state = GetState();
+
+	nlohmann::json events = nlohmann::json::array();
+
+	{
+		std::lock_guard lock(state.mutex);
+
+		for (const auto& log : state.logs)
+		{
+			const std::string thread_name = (log->pool_index == 0) ? 
+				"Thread " + std::to_string(log->id) : "Worker " + std::to_string(log->pool_index);
+
+			events.push_back(
+			{
+				{ "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", log->id },
+				{ "args", { { "name", thread_name } } }
+			});
+
+			ForEachZone(*log, 
+				[&events, &log](const Zone& zone)
+				{
+					events.push_back(
+					{
+						{ "name", zone.name }, { "cat", "velox" }, { "ph", "X" }, { "pid", 0 }, { "tid", log->id },
+						{ "ts",  zone.begin / 1000.0 },				// trace format expects microseconds
+						{ "dur", (zone.end - zone.begin) / 1000.0 },
+						{ "args", { { "depth", zone.depth } } }
+					});
+				});
+		}
+	}
+
+	std::ofstream file{std::string(path)};
+	if (!file.is_open())
+		return false;
+
+	file << nlohmann::json{ { "traceEvents", std::move(events) }, { "displayTimeUnit", "ns" } };
+
+	return file.good();
+}
\ No newline at end of file
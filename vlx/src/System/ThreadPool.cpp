@@ -0,0 +1,196 @@
+#include <Velox/System/ThreadPool.h>
+
+using namespace vlx;
+
+namespace
+{
+	thread_local std::size_t t_thread_index = 0;
+}
+
+ThreadPool::ThreadPool(std::size_t thread_count)
+{
+	m_queues.reserve(thread_count + 1);
+	for (std::size_t i = 0; i < thread_count + 1; ++i)
+		m_queues.emplace_back(std::make_unique<JobQueue>());
+
+	m_workers.reserve(thread_count);
+	for (std::size_t i = 0; i < thread_count; ++i)
+		m_workers.emplace_back(&ThreadPool::WorkerLoop, this, i + 1);
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_stop = true;
+	}
+
+	m_cv.notify_all();
+
+	for (std::thread& worker : m_workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+}
+
+std::size_t ThreadPool::GetThreadCount() const noexcept
+{
+	return m_workers.size() + 1;
+}
+
+std::size_t ThreadPool::GetThreadIndex() noexcept
+{
+	return t_thread_index;
+}
+
+std::size_t ThreadPool::GetDefaultThreadCount() noexcept
+{
+	return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+}
+
+void ThreadPool::Submit(RangeFunc func, void* data, std::size_t count, std::size_t grain_size, Batch& batch)
+{
+	const std::size_t job_count		= (count + grain_size - 1) / grain_size;
+	const std::size_t queue_count	= m_queues.size();
+
+	batch.pending.store(job_count, std::memory_order_relaxed);
+
+	// distribute contiguous blocks of jobs to every queue, start at the queue of the
+	// current thread so that it can work on its own block without having to steal
+
+	const std::size_t jobs_per_queue = (job_count + queue_count - 1) / queue_count;
+	const std::size_t first_queue = GetThreadIndex();
+
+	for (std::size_t q = 0, job = 0; q < queue_count && job < job_count; ++q)
+	{
+		JobQueue& queue = *m_queues[(first_queue + q) % queue_count];
+
+		std::lock_guard lock(queue.mutex);
+		for (std::size_t i = 0; i < jobs_per_queue && job < job_count; ++i, ++job)
+		{
+			const std::size_t begin = job * grain_size;
+			queue.jobs.emplace_back(func, data, begin, std::min(begin + grain_size, count), &batch);
+		}
+	}
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_queued.fetch_add(job_count, std::memory_order_release);
+	}
+
+	m_cv.notify_all();
+	m_done_cv.notify_all(); // waiting callers may help with the new jobs
+}
+
+void ThreadPool::Wait(const Batch& batch)
+{
+	const std::size_t index = GetThreadIndex();
+
+	while (batch.pending.load(std::memory_order_acquire) != 0)
+	{
+		Job job;
+		if (TryPop(index, job) || TrySteal(index, job) || TrySteal(index, job, true))
+		{
+			Execute(job);
+			continue;
+		}
+
+		// every remaining job is being processed by other threads, sleep until the last one finishes or until
+		// more jobs are submitted, such as from nested calls inside of the running jobs
+
+		std::unique_lock lock(m_mutex);
+		m_done_cv.wait(lock, [this, &batch]()
+			{
+				return batch.pending.load(std::memory_order_acquire) == 0 || m_queued.load(std::memory_order_acquire) != 0;
+			});
+	}
+}
+
+bool ThreadPool::TryPop(std::size_t index, Job& job)
+{
+	JobQueue& queue = *m_queues[index];
+
+	std::lock_guard lock(queue.mutex);
+	if (queue.jobs.empty())
+		return false;
+
+	job = queue.jobs.front(); // front to keep the memory access of the block in order
+	queue.jobs.pop_front();
+
+	m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool ThreadPool::TrySteal(std::size_t index, Job& job, bool block)
+{
+	const std::size_t queue_count = m_queues.size();
+
+	for (std::size_t i = 1; i < queue_count; ++i)
+	{
+		JobQueue& queue = *m_queues[(index + i) % queue_count];
+
+		std::unique_lock lock(queue.mutex, std::defer_lock);
+		if (block) // last pass before sleeping, a busy queue may still hold jobs
+			lock.lock();
+		else if (!lock.try_lock())
+			continue;
+
+		if (queue.jobs.empty())
+			continue;
+
+		job = queue.jobs.back(); // steal from the opposite end of the owner
+		queue.jobs.pop_back();
+
+		m_queued.fetch_sub(1, std::memory_order_relaxed);
+
+		return true;
+	}
+
+	return false;
+}
+
+void ThreadPool::Execute(const Job& job)
+{
+	Batch& batch = *job.batch;
+
+	try
+	{
+		job.func(job.data, job.begin, job.end);
+	}
+	catch (...)
+	{
+		if (!batch.failed.exchange(true, std::memory_order_relaxed)) // only the first is kept
+			batch.exception = std::current_exception();
+	}
+
+	// the caller may destroy the batch as soon as the count reaches zero, so it is not touched after
+
+	if (batch.pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		std::lock_guard lock(m_mutex);
+		m_done_cv.notify_all();
+	}
+}
+
+void ThreadPool::WorkerLoop(std::size_t index)
+{
+	t_thread_index = index;
+
+	while (true)
+	{
+		Job job;
+		if (TryPop(index, job) || TrySteal(index, job))
+		{
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock lock(m_mutex);
+		m_cv.wait(lock, [this]() { return m_stop || m_queued.load(std::memory_order_acquire) != 0; });
+
+		if (m_stop)
+			break;
+	}
+}
\ No newline at end of file
@@ -5,7 +5,9 @@ using namespace vlx;
 ObjectSystem::ObjectSystem(EntityAdmin& entity_admin, LayerType id)
 	: SystemAction(entity_admin, id, true)
 {
-
+	m_command_buffers.reserve(S_Count);
+	for (int i = 0; i < S_Count; ++i)
+		m_command_buffers.emplace_back(entity_admin.GetThreadPool().GetThreadCount());
 }
 
 Entity ObjectSystem::CreateEntity() const
@@ -21,7 +23,7 @@ void ObjectSystem::RemoveEntity(EntityID entity_id, ExecutionStage stage)
 		return;
 	}
 
-	m_command_table[stage].emplace(std::in_place_index<4>, entity_id);
+	m_command_buffers[stage].RemoveEntity(entity_id);
 }
 
 void ObjectSystem::ExecuteManually()
@@ -60,37 +62,5 @@ void ObjectSystem::PostUpdate()
 
 void ObjectSystem::ExecuteCommands(ExecutionStage stage)
 {
-	auto& commands = m_command_table[stage];
-	while (!commands.empty())
-	{
-		VisitCommand(commands.front());
-		commands.pop();
-	}
-}
-
-void ObjectSystem::VisitCommand(const Command& command)
-{
-	std::visit(traits::Overload
-		{
-			[this](const AddCompData& data)
-			{
-				m_entity_admin->AddComponent(data.entity_id, data.component_id);
-			},
-			[this](const AddCompsData& data)
-			{
-				m_entity_admin->AddComponents(data.entity_id, data.component_ids, data.archetype_id);
-			},
-			[this](const RmvCompData& data)
-			{
-				m_entity_admin->RemoveComponent(data.entity_id, data.component_id);
-			},
-			[this](const RmvCompsData& data)
-			{
-				m_entity_admin->RemoveComponents(data.entity_id, data.component_ids, data.archetype_id);
-			},
-			[this](const RmvEntityData& data)
-			{
-				m_entity_admin->RemoveEntity(data.entity_id);
-			}
-		}, command);
-}
+	m_command_buffers[stage].Execute(*m_entity_admin);
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <Velox/World/World.h>
 
+#include <Velox/System/Profiler.h>
+
 using namespace vlx;
 
 World::World(std::string name) : 
@@ -78,33 +80,52 @@ void World::Run()
 
 	while (m_window.isOpen())
 	{
+		VELOX_PROFILE_SCOPE("World::Frame");
+
 		m_time.Update();
 
 		m_inputs.Update(m_time, m_window.hasFocus());
 
-		ProcessEvents();
+		{
+			VELOX_PROFILE_SCOPE("World::ProcessEvents");
+			ProcessEvents();
+		}
 
 		if (m_shutdown)
 			break;
 
-		PreUpdate();
+		{
+			VELOX_PROFILE_SCOPE("World::PreUpdate");
+			PreUpdate();
+		}
 
-		Update();
+		{
+			VELOX_PROFILE_SCOPE("World::Update");
+			Update();
+		}
 
 		accumulator += m_time.GetRealDT();
 		accumulator = std::min(accumulator, 0.2f); // clamp accumulator to prevent over-shooting
 
 		while (accumulator >= m_time.GetFixedDT())
 		{
+			VELOX_PROFILE_SCOPE("World::FixedUpdate");
+
 			accumulator -= m_time.GetFixedDT();
 			FixedUpdate();
 		}
 
 		m_time.SetAlpha(accumulator / m_time.GetFixedDT());
 
-		PostUpdate();
+		{
+			VELOX_PROFILE_SCOPE("World::PostUpdate");
+			PostUpdate();
+		}
 
-		Draw();
+		{
+			VELOX_PROFILE_SCOPE("World::Draw");
+			Draw();
+		}
 	}
 }
 